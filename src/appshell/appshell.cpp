@@ -283,14 +283,25 @@ int AppShell::processConverter(const CommandLineController::ConverterTask& task)
 
     switch (task.type) {
     case CommandLineController::ConvertType::Batch:
-        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode);
-        break;
+    {
+        QVariant workersCount = task.params[CommandLineController::ParamKey::BatchWorkersCount];
+        io::path_t reportPath = task.params[CommandLineController::ParamKey::BatchReportPath].toString();
+        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode,
+                                        workersCount.isValid() ? static_cast<size_t>(std::max(workersCount.toInt(), 0)) : 1,
+                                        reportPath);
+    } break;
     case CommandLineController::ConvertType::ConvertScoreParts:
         ret = converter()->convertScoreParts(task.inputFile, task.outputFile, stylePath);
         break;
-    case CommandLineController::ConvertType::File:
-        ret = converter()->fileConvert(task.inputFile, task.outputFile, stylePath, forceMode);
-        break;
+    case CommandLineController::ConvertType::File: {
+        QStringList outputFiles = task.params[CommandLineController::ParamKey::OutputFiles].toStringList();
+        if (outputFiles.size() > 1) {
+            io::paths_t outs(outputFiles.cbegin(), outputFiles.cend());
+            ret = converter()->fileConvert(task.inputFile, outs, stylePath, forceMode);
+        } else {
+            ret = converter()->fileConvert(task.inputFile, task.outputFile, stylePath, forceMode);
+        }
+    } break;
     case CommandLineController::ConvertType::ExportScoreMedia: {
         io::path_t highlightConfigPath = task.params[CommandLineController::ParamKey::HighlightConfigPath].toString();
         ret = converter()->exportScoreMedia(task.inputFile, task.outputFile, highlightConfigPath, stylePath, forceMode);
@@ -315,6 +326,9 @@ int AppShell::processConverter(const CommandLineController::ConverterTask& task)
         std::string scoreSource = task.params[CommandLineController::ParamKey::ScoreSource].toString().toStdString();
         ret = converter()->updateSource(task.inputFile, scoreSource, forceMode);
     } break;
+    case CommandLineController::ConvertType::ConverterDaemon:
+        ret = converter()->runDaemon(task.inputFile.toStdString(), stylePath, forceMode);
+        break;
     }
 
     if (!ret) {
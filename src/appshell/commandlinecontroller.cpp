@@ -23,6 +23,7 @@
 
 #include "log.h"
 #include "global/version.h"
+#include "global/tracer.h"
 #include "config.h"
 
 using namespace mu::appshell;
@@ -38,6 +39,8 @@ void CommandLineController::parse(const QStringList& args)
 
     m_parser.addOption(QCommandLineOption("long-version", "Print detailed version information"));
     m_parser.addOption(QCommandLineOption({ "d", "debug" }, "Debug mode"));
+    m_parser.addOption(QCommandLineOption("trace", "Record the timeline of the hot paths (layout, playback, audio, file I/O) "
+                                                   "and save it on exit to a Chrome trace JSON file", "file"));
 
     m_parser.addOption(QCommandLineOption({ "D", "monitor-resolution" }, "Specify monitor resolution", "DPI"));
     m_parser.addOption(QCommandLineOption({ "T", "trim-image" },
@@ -54,7 +57,14 @@ void CommandLineController::parse(const QStringList& args)
     // Converter mode
     m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
     m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
-    m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
+    m_parser.addOption(QCommandLineOption("batch-workers",
+                                          "Use with '-j <file>', convert the jobs in 'count' concurrent processes (0 means one per CPU core)",
+                                          "count"));
+    m_parser.addOption(QCommandLineOption("batch-report", "Use with '-j <file>', write the result and time of every job to a JSON file",
+                                          "file"));
+    m_parser.addOption(QCommandLineOption({ "o", "export-to" },
+                                          "Export to 'file'. Format depends on file's extension. "
+                                          "Can be given several times, the score is then loaded once for all the files", "file"));
     m_parser.addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
     m_parser.addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
     m_parser.addOption(QCommandLineOption({ "M", "midi-operations" }, "Specify MIDI import operations file", "file"));
@@ -76,6 +86,10 @@ void CommandLineController::parse(const QStringList& args)
 
     m_parser.addOption(QCommandLineOption({ "S", "style" }, "Load style file", "style"));
 
+    m_parser.addOption(QCommandLineOption("converter-daemon",
+                                          "Stay running and process conversion jobs given as JSON lines on the local socket 'name' ('-' for stdin/stdout)",
+                                          "name"));
+
     // Video export
     m_parser.addOption(QCommandLineOption("score-video", "Generate video for the given score and export it to file"));
 // not implemented
@@ -134,6 +148,10 @@ void CommandLineController::apply()
         haw::logger::Logger::instance()->setLevel(haw::logger::Debug);
     }
 
+    if (m_parser.isSet("trace")) {
+        Tracer::instance()->start(m_parser.value("trace"));
+    }
+
     if (m_parser.isSet("D")) {
         std::optional<double> val = doubleValue("D");
         if (val) {
@@ -194,6 +212,11 @@ void CommandLineController::apply()
             }
             m_converterTask.inputFile = scorefiles[0];
             m_converterTask.outputFile = m_parser.value("o");
+
+            QStringList outputFiles = m_parser.values("o");
+            if (outputFiles.size() > 1) {
+                m_converterTask.params[CommandLineController::ParamKey::OutputFiles] = outputFiles;
+            }
         }
     }
 
@@ -209,6 +232,14 @@ void CommandLineController::apply()
         application()->setRunMode(IApplication::RunMode::Converter);
         m_converterTask.type = ConvertType::Batch;
         m_converterTask.inputFile = m_parser.value("j");
+
+        if (m_parser.isSet("batch-workers")) {
+            m_converterTask.params[CommandLineController::ParamKey::BatchWorkersCount] = m_parser.value("batch-workers").toInt();
+        }
+
+        if (m_parser.isSet("batch-report")) {
+            m_converterTask.params[CommandLineController::ParamKey::BatchReportPath] = m_parser.value("batch-report");
+        }
     }
 
     if (m_parser.isSet("score-media")) {
@@ -220,6 +251,12 @@ void CommandLineController::apply()
         }
     }
 
+    if (m_parser.isSet("converter-daemon")) {
+        application()->setRunMode(IApplication::RunMode::Converter);
+        m_converterTask.type = ConvertType::ConverterDaemon;
+        m_converterTask.inputFile = m_parser.value("converter-daemon");
+    }
+
     if (m_parser.isSet("score-meta")) {
         application()->setRunMode(IApplication::RunMode::Converter);
         m_converterTask.type = ConvertType::ExportScoreMeta;
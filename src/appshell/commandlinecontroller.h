@@ -64,7 +64,8 @@ public:
         ExportScorePartsPdf,
         ExportScoreTranspose,
         SourceUpdate,
-        ExportScoreVideo
+        ExportScoreVideo,
+        ConverterDaemon
     };
 
     enum class ParamKey {
@@ -73,6 +74,11 @@ public:
         ScoreSource,
         ScoreTransposeOptions,
         ForceMode,
+        OutputFiles,
+
+        // Batch
+        BatchWorkersCount,
+        BatchReportPath,
 
         // Video
     };
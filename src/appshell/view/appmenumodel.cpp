@@ -346,6 +346,7 @@ MenuItem* AppMenuModel::makeDiagnosticMenu()
     MenuItemList systemItems {
         makeMenuItem("diagnostic-show-paths"),
         makeMenuItem("diagnostic-show-profiler"),
+        makeMenuItem("diagnostic-toggle-tracing"),
     };
 
     MenuItemList accessibilityItems {
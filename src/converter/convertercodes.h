@@ -32,6 +32,8 @@ enum class Err {
 
     BatchJobFileFailedOpen = 1301,
     BatchJobFileFailedParse = 1302,
+    BatchJobFailed = 1303,
+    BatchReportFailedWrite = 1304,
 
     ConvertTypeUnknown = 1310,
 
@@ -39,6 +41,9 @@ enum class Err {
 
     OutFileFailedOpen = 1330,
     OutFileFailedWrite = 1331,
+
+    DaemonFailedListen = 1340,
+    DaemonBadRequest = 1341,
 };
 
 inline Ret make_ret(Err e)
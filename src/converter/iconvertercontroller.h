@@ -22,6 +22,8 @@
 #ifndef MU_CONVERTER_ICONVERTERCONTROLLER_H
 #define MU_CONVERTER_ICONVERTERCONTROLLER_H
 
+#include <vector>
+
 #include "modularity/imoduleexport.h"
 #include "ret.h"
 #include "io/path.h"
@@ -33,9 +35,25 @@ class IConverterController : MODULE_EXPORT_INTERFACE
 public:
     virtual ~IConverterController() = default;
 
+    struct OutputResult {
+        io::path_t out;
+        Ret ret;
+        double durationMs = 0.0;
+    };
+
+    using OutputResults = std::vector<OutputResult>;
+
     virtual Ret fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                             bool forceMode = false) = 0;
-    virtual Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false) = 0;
+    //! NOTE Loads and lays out the score once for all the outputs
+    virtual Ret fileConvert(const io::path_t& in, const io::paths_t& outs, const io::path_t& stylePath = io::path_t(),
+                            bool forceMode = false) = 0;
+    //! NOTE Also reports the result and the time of every output
+    virtual Ret fileConvert(const io::path_t& in, const io::paths_t& outs, OutputResults& results,
+                            const io::path_t& stylePath = io::path_t(), bool forceMode = false) = 0;
+    //! NOTE workersCount is the number of processes converting the jobs concurrently, 0 means the number of CPU cores
+    virtual Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false,
+                             size_t workersCount = 1, const io::path_t& reportPath = io::path_t()) = 0;
     virtual Ret convertScoreParts(const io::path_t& in, const io::path_t& out,
                                   const io::path_t& stylePath = io::path_t(), bool forceMode = false) = 0;
 
@@ -54,6 +72,9 @@ public:
     virtual Ret exportScoreVideo(const io::path_t& in, const io::path_t& out) = 0;
 
     virtual Ret updateSource(const io::path_t& in, const std::string& newSource, bool forceMode = false) = 0;
+
+    //! NOTE Processes conversion jobs received on the local socket serverName ("-" for stdin/stdout) until asked to quit
+    virtual Ret runDaemon(const std::string& serverName, const io::path_t& stylePath = io::path_t(), bool forceMode = false) = 0;
 };
 }
 
@@ -35,6 +35,7 @@
 #include "engraving/compat/scoreaccess.h"
 #include "engraving/infrastructure/io/mscwriter.h"
 #include "engraving/libmscore/excerpt.h"
+#include "engraving/libmscore/masterscore.h"
 
 #include "backendjsonwriter.h"
 #include "notationmeta.h"
@@ -502,6 +503,9 @@ Ret BackendApi::doExportScoreParts(const notation::INotationPtr notation, QIODev
 {
     mu::engraving::MasterScore* score = notation->elements()->msScore()->masterScore();
 
+    //! NOTE The layout of the parts may have been deferred
+    score->doPendingLayouts();
+
     QJsonArray partsObjList;
     QJsonArray partsMetaList;
     QJsonArray partsTitles;
@@ -540,6 +544,8 @@ Ret BackendApi::doExportScoreParts(const notation::INotationPtr notation, QIODev
 Ret BackendApi::doExportScorePartsPdfs(const IMasterNotationPtr masterNotation, QIODevice& destinationDevice,
                                        const std::string& scoreFileName)
 {
+    masterNotation->notation()->elements()->msScore()->masterScore()->doPendingLayouts();
+
     QJsonObject jsonForPdfs;
     jsonForPdfs["score"] = QString::fromStdString(scoreFileName);
     QByteArray scoreBin = processWriter(PDF_WRITER_NAME, masterNotation->notation()).val;
@@ -711,6 +717,9 @@ Ret BackendApi::applyTranspose(const INotationPtr notation, const std::string& o
         LOGW() << "Error transpose";
     }
 
+    //! NOTE The transposition defers the layout of the parts, which are exported next
+    notation->elements()->msScore()->masterScore()->doPendingLayouts();
+
     return ok ? make_ret(Ret::Code::Ok) : make_ret(Ret::Code::InternalError);
 }
 
@@ -21,13 +21,25 @@
  */
 #include "convertercontroller.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <QBuffer>
+#include <QCoreApplication>
 #include <QFile>
+#include <QProcess>
+#include <QSaveFile>
+#include <QTemporaryDir>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonParseError>
 
 #include "convertercodes.h"
+#include "converterdaemon.h"
 #include "stringutils.h"
 #include "compat/backendapi.h"
 
@@ -40,7 +52,40 @@ using namespace mu::notation;
 static const std::string PDF_SUFFIX = "pdf";
 static const std::string PNG_SUFFIX = "png";
 
-mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath, bool forceMode)
+//! NOTE The "out" of a job is either one path or an array of paths
+static mu::io::paths_t outPaths(const QJsonValue& value)
+{
+    mu::io::paths_t paths;
+    if (value.isArray()) {
+        const QJsonArray arr = value.toArray();
+        for (const QJsonValue v : arr) {
+            if (!v.toString().isEmpty()) {
+                paths.push_back(v.toString());
+            }
+        }
+    } else if (!value.toString().isEmpty()) {
+        paths.push_back(value.toString());
+    }
+
+    return paths;
+}
+
+static QJsonValue outPathsToJson(const mu::io::paths_t& paths)
+{
+    if (paths.size() == 1) {
+        return paths.front().toQString();
+    }
+
+    QJsonArray arr;
+    for (const mu::io::path_t& path : paths) {
+        arr.append(path.toQString());
+    }
+
+    return arr;
+}
+
+mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath, bool forceMode,
+                                          size_t workersCount, const io::path_t& reportPath)
 {
     TRACEFUNC;
 
@@ -50,32 +95,269 @@ mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const
         return batchJob.ret;
     }
 
-    Ret ret = make_ret(Ret::Code::Ok);
-    for (const Job& job : batchJob.val) {
-        ret = fileConvert(job.in, job.out, stylePath, forceMode);
+    if (workersCount == 0) {
+        workersCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    workersCount = std::min(workersCount, batchJob.val.size());
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    BatchJobResults results;
+    if (workersCount > 1) {
+        results = runBatchJobInWorkers(batchJob.val, workersCount, stylePath, forceMode);
+    } else {
+        results = runBatchJob(batchJob.val, stylePath, forceMode, reportPath);
+    }
+
+    double durationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    size_t failedCount = 0;
+    for (const JobResult& result : results) {
+        if (!result.ret) {
+            ++failedCount;
+        }
+    }
+
+    LOGI() << "batch finished, jobs: " << results.size() << ", failed: " << failedCount << ", time: " << durationMs << " ms";
+
+    if (!reportPath.empty()) {
+        Ret ret = writeBatchReport(results, std::max(workersCount, size_t(1)), durationMs, reportPath);
         if (!ret) {
-            LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << job.out;
-            break;
+            LOGE() << "failed write batch report, err: " << ret.toString() << ", path: " << reportPath;
+            return ret;
         }
     }
 
-    return ret;
+    if (failedCount > 0) {
+        return make_ret(Err::BatchJobFailed);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+ConverterController::BatchJobResults ConverterController::runBatchJob(const BatchJob& batchJob, const io::path_t& stylePath,
+                                                                      bool forceMode, const io::path_t& reportPath)
+{
+    TRACEFUNC;
+
+    BatchJobResults results;
+    results.reserve(batchJob.size());
+
+    //! NOTE A failed job doesn't abort the batch, the remaining jobs are still converted
+    for (const Job& job : batchJob) {
+        auto startTime = std::chrono::steady_clock::now();
+
+        JobResult result;
+        result.job = job;
+        result.ret = fileConvert(job.in, job.outs, result.outputs, stylePath, forceMode);
+        result.durationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+        if (!result.ret) {
+            LOGE() << "failed convert, err: " << result.ret.toString() << ", in: " << job.in << ", out: " << io::pathsToString(job.outs);
+        }
+
+        results.push_back(std::move(result));
+
+        //! NOTE Keep the report up to date, so that the finished jobs are known even if the next one crashes
+        if (!reportPath.empty()) {
+            writeBatchReport(results, 1, 0.0, reportPath);
+        }
+    }
+
+    return results;
+}
+
+//! NOTE The engraving module keeps global state (undo stack, score list, font caches, ...),
+//! so two projects can't be loaded or laid out on different threads of one process.
+//! Every worker is therefore a separate process, that converts its share of the jobs one by one
+//! and so loads the fonts, instrument templates and styles once for all of them.
+ConverterController::BatchJobResults ConverterController::runBatchJobInWorkers(const BatchJob& batchJob, size_t workersCount,
+                                                                               const io::path_t& stylePath, bool forceMode)
+{
+    TRACEFUNC;
+
+    struct Chunk {
+        std::vector<size_t> jobIndexes;
+    };
+
+    struct Worker {
+        Chunk chunk;
+        io::path_t reportPath;
+        std::unique_ptr<QProcess> process;
+    };
+
+    std::vector<Job> jobs(batchJob.begin(), batchJob.end());
+
+    BatchJobResults results(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        results[i].job = jobs[i];
+        results[i].ret = make_ret(Err::BatchJobFailed, "job has not been run");
+    }
+
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        LOGE() << "failed create temporary dir, the jobs will be converted in this process";
+        return runBatchJob(batchJob, stylePath, forceMode);
+    }
+
+    std::list<Chunk> queue;
+    for (size_t w = 0; w < workersCount; ++w) {
+        Chunk chunk;
+        for (size_t i = w; i < jobs.size(); i += workersCount) {
+            chunk.jobIndexes.push_back(i);
+        }
+
+        queue.push_back(std::move(chunk));
+    }
+
+    size_t workerNum = 0;
+
+    auto startWorker = [&](Chunk chunk) -> std::unique_ptr<Worker> {
+        QString jobPath = tempDir.filePath(QString("job_%1.json").arg(workerNum));
+        QString reportPath = tempDir.filePath(QString("report_%1.json").arg(workerNum));
+        ++workerNum;
+
+        BatchJob workerJob;
+        for (size_t index : chunk.jobIndexes) {
+            workerJob.push_back(jobs[index]);
+        }
+
+        Ret ret = writeBatchJob(workerJob, jobPath);
+        if (!ret) {
+            LOGE() << "failed write worker batch job, err: " << ret.toString();
+            return nullptr;
+        }
+
+        //! NOTE The worker gets the same options as this process (style, force mode, resolution, ...),
+        //! except the batch ones
+        static const QStringList BATCH_OPTIONS = { "-j", "--job", "--batch-workers", "--batch-report" };
+
+        QStringList arguments;
+        QStringList ownArguments = QCoreApplication::arguments().mid(1);
+        for (int i = 0; i < ownArguments.size(); ++i) {
+            const QString& arg = ownArguments.at(i);
+            if (BATCH_OPTIONS.contains(arg.section('=', 0, 0))) {
+                if (!arg.contains('=')) {
+                    ++i;
+                }
+
+                continue;
+            }
+
+            //! NOTE The short form may have its value attached, i.e. -jfile
+            if (arg.startsWith("-j") && !arg.startsWith("--")) {
+                continue;
+            }
+
+            arguments << arg;
+        }
+
+        arguments << "--job" << jobPath << "--batch-report" << reportPath;
+
+        auto worker = std::make_unique<Worker>();
+        worker->chunk = std::move(chunk);
+        worker->reportPath = reportPath;
+        worker->process = std::make_unique<QProcess>();
+        worker->process->setProcessChannelMode(QProcess::ForwardedChannels);
+        worker->process->start(QCoreApplication::applicationFilePath(), arguments);
+
+        if (!worker->process->waitForStarted()) {
+            LOGE() << "failed start worker: " << worker->process->errorString();
+            return nullptr;
+        }
+
+        return worker;
+    };
+
+    std::list<std::unique_ptr<Worker> > running;
+
+    auto fillWorkers = [&]() {
+        while (!queue.empty() && running.size() < workersCount) {
+            std::unique_ptr<Worker> worker = startWorker(std::move(queue.front()));
+            queue.pop_front();
+
+            if (worker) {
+                running.push_back(std::move(worker));
+            }
+        }
+    };
+
+    fillWorkers();
+
+    while (!running.empty()) {
+        for (auto it = running.begin(); it != running.end();) {
+            Worker* worker = it->get();
+            if (worker->process->state() != QProcess::NotRunning && !worker->process->waitForFinished(50)) {
+                ++it;
+                continue;
+            }
+
+            RetVal<BatchJobResults> report = readBatchReport(worker->reportPath);
+            const std::vector<size_t>& indexes = worker->chunk.jobIndexes;
+            size_t doneCount = report.ret ? std::min(report.val.size(), indexes.size()) : 0;
+
+            for (size_t i = 0; i < doneCount; ++i) {
+                results[indexes[i]].ret = report.val[i].ret;
+                results[indexes[i]].durationMs = report.val[i].durationMs;
+            }
+
+            //! NOTE The worker has crashed on the first job without a result,
+            //! the jobs after it get a new worker
+            if (doneCount < indexes.size()) {
+                size_t crashedIndex = indexes[doneCount];
+                LOGE() << "worker exited unexpectedly, exit code: " << worker->process->exitCode()
+                       << ", in: " << jobs[crashedIndex].in;
+
+                results[crashedIndex].ret = make_ret(Err::BatchJobFailed, "worker exited unexpectedly");
+
+                Chunk rest;
+                rest.jobIndexes.assign(indexes.begin() + doneCount + 1, indexes.end());
+                if (!rest.jobIndexes.empty()) {
+                    queue.push_back(std::move(rest));
+                }
+            }
+
+            it = running.erase(it);
+        }
+
+        fillWorkers();
+    }
+
+    return results;
 }
 
 mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath, bool forceMode)
+{
+    return fileConvert(in, io::paths_t { out }, stylePath, forceMode);
+}
+
+mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::paths_t& outs, const io::path_t& stylePath, bool forceMode)
+{
+    OutputResults results;
+    return fileConvert(in, outs, results, stylePath, forceMode);
+}
+
+mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::paths_t& outs, OutputResults& results,
+                                         const io::path_t& stylePath, bool forceMode)
 {
     TRACEFUNC;
 
-    LOGI() << "in: " << in << ", out: " << out;
+    LOGI() << "in: " << in << ", out: " << io::pathsToString(outs);
     auto notationProject = notationCreator()->newProject();
     IF_ASSERT_FAILED(notationProject) {
         return make_ret(Err::UnknownError);
     }
 
-    std::string suffix = io::suffix(out);
-    auto writer = writers()->writer(suffix);
-    if (!writer) {
-        return make_ret(Err::ConvertTypeUnknown);
+    std::vector<INotationWriterPtr> outWriters;
+    for (const io::path_t& out : outs) {
+        auto writer = writers()->writer(io::suffix(out));
+        if (!writer) {
+            LOGE() << "unknown convert type, out: " << out;
+            return make_ret(Err::ConvertTypeUnknown);
+        }
+
+        outWriters.push_back(writer);
     }
 
     Ret ret = notationProject->load(in, stylePath, forceMode);
@@ -86,13 +368,36 @@ mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::path_t&
 
     globalContext()->setCurrentProject(notationProject);
 
-    if (isConvertPageByPage(suffix)) {
-        ret = convertPageByPage(writer, notationProject->masterNotation()->notation(), out);
-    } else {
-        ret = convertFullNotation(writer, notationProject->masterNotation()->notation(), out);
+    INotationPtr notation = notationProject->masterNotation()->notation();
+
+    //! NOTE The score is loaded and laid out once for all the outputs, but the writers run one after another:
+    //! the painting ones switch global engraving state (MScore::pdfPrinting, MScore::pixelRatio)
+    //! and the audio one drives the playback engine
+    for (size_t i = 0; i < outs.size(); ++i) {
+        const io::path_t& out = outs[i];
+        auto startTime = std::chrono::steady_clock::now();
+
+        OutputResult result;
+        result.out = out;
+
+        if (isConvertPageByPage(io::suffix(out))) {
+            result.ret = convertPageByPage(outWriters[i], notation, out);
+        } else {
+            result.ret = convertFullNotation(outWriters[i], notation, out);
+        }
+
+        result.durationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+        LOGI() << "out: " << out << ", time: " << result.durationMs << " ms";
+
+        //! NOTE A failed output doesn't prevent writing the others, the first error is returned
+        if (!result.ret && ret) {
+            ret = result.ret;
+        }
+
+        results.push_back(std::move(result));
     }
 
-    return make_ret(Ret::Code::Ok);
+    return ret;
 }
 
 mu::Ret ConverterController::convertScoreParts(const mu::io::path_t& in, const mu::io::path_t& out, const mu::io::path_t& stylePath,
@@ -154,9 +459,9 @@ mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(con
 
         Job job;
         job.in = obj["in"].toString();
-        job.out = obj["out"].toString();
+        job.outs = outPaths(obj["out"]);
 
-        if (!job.in.empty() && !job.out.empty()) {
+        if (!job.in.empty() && !job.outs.empty()) {
             rv.val.push_back(std::move(job));
         }
     }
@@ -165,6 +470,125 @@ mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(con
     return rv;
 }
 
+mu::Ret ConverterController::writeBatchJob(const BatchJob& batchJob, const io::path_t& batchJobFile) const
+{
+    QJsonArray arr;
+    for (const Job& job : batchJob) {
+        QJsonObject obj;
+        obj["in"] = job.in.toQString();
+        obj["out"] = outPathsToJson(job.outs);
+        arr.append(obj);
+    }
+
+    QFile file(batchJobFile.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::BatchJobFileFailedOpen);
+    }
+
+    file.write(QJsonDocument(arr).toJson());
+
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::RetVal<ConverterController::BatchJobResults> ConverterController::readBatchReport(const io::path_t& reportPath) const
+{
+    RetVal<BatchJobResults> rv;
+    QFile file(reportPath.toQString());
+    if (!file.open(QIODevice::ReadOnly)) {
+        rv.ret = make_ret(Err::BatchJobFileFailedOpen);
+        return rv;
+    }
+
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+        rv.ret = make_ret(Err::BatchJobFileFailedParse, err.errorString().toStdString());
+        return rv;
+    }
+
+    const QJsonArray jobs = doc.object().value("jobs").toArray();
+    for (const QJsonValue v : jobs) {
+        QJsonObject obj = v.toObject();
+
+        JobResult result;
+        result.job.in = obj["in"].toString();
+        result.job.outs = outPaths(obj["out"]);
+        result.ret = Ret(obj["errorCode"].toInt(), obj["error"].toString().toStdString());
+        result.durationMs = obj["timeMs"].toDouble();
+
+        const QJsonArray outputs = obj["outputs"].toArray();
+        for (const QJsonValue o : outputs) {
+            QJsonObject outputObj = o.toObject();
+
+            OutputResult output;
+            output.out = outputObj["out"].toString();
+            output.ret = Ret(outputObj["errorCode"].toInt(), outputObj["error"].toString().toStdString());
+            output.durationMs = outputObj["timeMs"].toDouble();
+            result.outputs.push_back(std::move(output));
+        }
+
+        rv.val.push_back(std::move(result));
+    }
+
+    rv.ret = make_ret(Ret::Code::Ok);
+    return rv;
+}
+
+mu::Ret ConverterController::writeBatchReport(const BatchJobResults& results, size_t workersCount, double durationMs,
+                                              const io::path_t& reportPath) const
+{
+    QJsonArray jobs;
+    int failedCount = 0;
+
+    for (const JobResult& result : results) {
+        QJsonObject obj;
+        obj["in"] = result.job.in.toQString();
+        obj["out"] = outPathsToJson(result.job.outs);
+        obj["success"] = result.ret.success();
+        obj["errorCode"] = result.ret.code();
+        obj["error"] = QString::fromStdString(result.ret.success() ? std::string() : result.ret.toString());
+        obj["timeMs"] = result.durationMs;
+
+        QJsonArray outputs;
+        for (const OutputResult& output : result.outputs) {
+            QJsonObject outputObj;
+            outputObj["out"] = output.out.toQString();
+            outputObj["success"] = output.ret.success();
+            outputObj["errorCode"] = output.ret.code();
+            outputObj["error"] = QString::fromStdString(output.ret.success() ? std::string() : output.ret.toString());
+            outputObj["timeMs"] = output.durationMs;
+            outputs.append(outputObj);
+        }
+
+        obj["outputs"] = outputs;
+        jobs.append(obj);
+
+        if (!result.ret) {
+            ++failedCount;
+        }
+    }
+
+    QJsonObject report;
+    report["workers"] = static_cast<int>(workersCount);
+    report["totalTimeMs"] = durationMs;
+    report["succeeded"] = static_cast<int>(results.size()) - failedCount;
+    report["failed"] = failedCount;
+    report["jobs"] = jobs;
+
+    //! NOTE A worker rewrites its report after every job, the file is replaced at once,
+    //! so a worker crashing while writing it leaves the previous report, not a truncated one
+    QSaveFile file(reportPath.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::BatchReportFailedWrite);
+    }
+
+    if (file.write(QJsonDocument(report).toJson()) < 0 || !file.commit()) {
+        return make_ret(Err::BatchReportFailedWrite);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
 bool ConverterController::isConvertPageByPage(const std::string& suffix) const
 {
     QList<std::string> types {
@@ -178,27 +602,99 @@ mu::Ret ConverterController::convertPageByPage(INotationWriterPtr writer, INotat
 {
     TRACEFUNC;
 
-    for (size_t i = 0; i < notation->elements()->pages().size(); i++) {
-        const QString filePath = io::path_t(io::dirpath(out) + "/" + io::basename(out) + "-%1." + io::suffix(out)).toQString().arg(i + 1);
+    const size_t pagesCount = notation->elements()->pages().size();
+
+    auto writePage = [writer, notation, &out](size_t pageIndex, QIODevice& device) {
+        INotationWriter::Options options {
+            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(pageIndex)) },
+        };
+
+        device.setProperty("path", out.toQString());
+
+        return writer->write(notation, device, options);
+    };
+
+    //! NOTE Writes the page painted into memory, if any, otherwise paints it right into the file
+    auto writePageFile = [&out, &writePage](size_t pageIndex, const QByteArray* pageData) {
+        const QString filePathPattern = io::path_t(io::dirpath(out) + "/" + io::basename(out) + "-%1." + io::suffix(out)).toQString();
+        const QString filePath = filePathPattern.arg(pageIndex + 1);
 
         QFile file(filePath);
         if (!file.open(QFile::WriteOnly)) {
             return make_ret(Err::OutFileFailedOpen);
         }
 
-        INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-        };
+        if (pageData) {
+            if (file.write(*pageData) != pageData->size()) {
+                LOGE() << "failed write, path: " << filePath;
+                return make_ret(Err::OutFileFailedWrite);
+            }
+        } else {
+            Ret ret = writePage(pageIndex, file);
+            if (!ret) {
+                LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
+                return make_ret(Err::OutFileFailedWrite);
+            }
+        }
 
-        file.setProperty("path", out.toQString());
+        file.close();
 
-        Ret ret = writer->write(notation, file, options);
-        if (!ret) {
-            LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
+        return make_ret(Ret::Code::Ok);
+    };
+
+    //! NOTE Painting a PNG page only reads the score, once the first page has done the pending layout
+    //! and set the paint state (see NotationPainting::doPaint). So the other pages are painted into memory concurrently
+    //! and then written in page order. The SVG writer changes the score, so its pages are painted one by one
+    size_t threadsCount = 1;
+    if (io::suffix(out) == PNG_SUFFIX && pagesCount > 2) {
+        threadsCount = std::min(pagesCount - 1, static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())));
+    }
+
+    if (threadsCount == 1) {
+        for (size_t i = 0; i < pagesCount; i++) {
+            Ret ret = writePageFile(i, nullptr);
+            if (!ret) {
+                return ret;
+            }
+        }
+
+        return make_ret(Ret::Code::Ok);
+    }
+
+    Ret ret = writePageFile(0, nullptr);
+    if (!ret) {
+        return ret;
+    }
+
+    std::vector<QByteArray> pagesData(pagesCount);
+    std::vector<Ret> pagesRets(pagesCount);
+    std::atomic<size_t> nextPageIndex { 1 };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadsCount; ++i) {
+        threads.emplace_back([&]() {
+            for (size_t pageIndex = nextPageIndex++; pageIndex < pagesCount; pageIndex = nextPageIndex++) {
+                QBuffer buffer(&pagesData[pageIndex]);
+                buffer.open(QIODevice::WriteOnly);
+                pagesRets[pageIndex] = writePage(pageIndex, buffer);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 1; i < pagesCount; i++) {
+        if (!pagesRets[i]) {
+            LOGE() << "failed write, err: " << pagesRets[i].toString() << ", path: " << out;
             return make_ret(Err::OutFileFailedWrite);
         }
 
-        file.close();
+        ret = writePageFile(i, &pagesData[i]);
+        if (!ret) {
+            return ret;
+        }
     }
 
     return make_ret(Ret::Code::Ok);
@@ -228,6 +724,9 @@ mu::Ret ConverterController::convertScorePartsToPdf(INotationWriterPtr writer, I
 {
     TRACEFUNC;
 
+    //! NOTE The layout of the parts may have been deferred
+    masterNotation->notation()->elements()->msScore()->masterScore()->doPendingLayouts();
+
     INotationPtrList notations;
     notations.push_back(masterNotation->notation());
 
@@ -260,6 +759,8 @@ mu::Ret ConverterController::convertScorePartsToPngs(INotationWriterPtr writer,
 {
     TRACEFUNC;
 
+    masterNotation->notation()->elements()->msScore()->masterScore()->doPendingLayouts();
+
     Ret ret = convertPageByPage(writer, masterNotation->notation(), out);
     if (!ret) {
         return ret;
@@ -359,3 +860,11 @@ mu::Ret ConverterController::updateSource(const io::path_t& in, const std::strin
 
     return BackendApi::updateSource(in, newSource, forceMode);
 }
+
+mu::Ret ConverterController::runDaemon(const std::string& serverName, const io::path_t& stylePath, bool forceMode)
+{
+    TRACEFUNC;
+
+    ConverterDaemon daemon(this, stylePath, forceMode);
+    return daemon.run(serverName);
+}
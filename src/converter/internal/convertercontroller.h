@@ -23,6 +23,7 @@
 #define MU_CONVERTER_CONVERTERCONTROLLER_H
 
 #include <list>
+#include <vector>
 
 #include "../iconvertercontroller.h"
 
@@ -47,7 +48,12 @@ public:
 
     Ret fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                     bool forceMode = false) override;
-    Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false) override;
+    Ret fileConvert(const io::path_t& in, const io::paths_t& outs, const io::path_t& stylePath = io::path_t(),
+                    bool forceMode = false) override;
+    Ret fileConvert(const io::path_t& in, const io::paths_t& outs, OutputResults& results,
+                    const io::path_t& stylePath = io::path_t(), bool forceMode = false) override;
+    Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false,
+                     size_t workersCount = 1, const io::path_t& reportPath = io::path_t()) override;
     Ret convertScoreParts(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                           bool forceMode = false) override;
 
@@ -67,16 +73,35 @@ public:
 
     Ret updateSource(const io::path_t& in, const std::string& newSource, bool forceMode = false) override;
 
+    Ret runDaemon(const std::string& serverName, const io::path_t& stylePath = io::path_t(), bool forceMode = false) override;
+
 private:
 
     struct Job {
         io::path_t in;
-        io::path_t out;
+        io::paths_t outs;
     };
 
     using BatchJob = std::list<Job>;
 
+    struct JobResult {
+        Job job;
+        Ret ret;
+        double durationMs = 0.0;
+        OutputResults outputs;
+    };
+
+    using BatchJobResults = std::vector<JobResult>;
+
     RetVal<BatchJob> parseBatchJob(const io::path_t& batchJobFile) const;
+    Ret writeBatchJob(const BatchJob& batchJob, const io::path_t& batchJobFile) const;
+
+    BatchJobResults runBatchJob(const BatchJob& batchJob, const io::path_t& stylePath, bool forceMode,
+                                const io::path_t& reportPath = io::path_t());
+    BatchJobResults runBatchJobInWorkers(const BatchJob& batchJob, size_t workersCount, const io::path_t& stylePath, bool forceMode);
+
+    RetVal<BatchJobResults> readBatchReport(const io::path_t& reportPath) const;
+    Ret writeBatchReport(const BatchJobResults& results, size_t workersCount, double durationMs, const io::path_t& reportPath) const;
 
     bool isConvertPageByPage(const std::string& suffix) const;
     Ret convertPageByPage(project::INotationWriterPtr writer, notation::INotationPtr notation, const io::path_t& out) const;
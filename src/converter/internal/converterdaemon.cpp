@@ -0,0 +1,258 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "converterdaemon.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QLocalServer>
+#include <QLocalSocket>
+
+#include "convertercodes.h"
+
+#include "log.h"
+
+using namespace mu::converter;
+
+static const QString STDIO_SERVER_NAME("-");
+
+static const QString CONVERT_JOB_TYPE("convert");
+static const QString SCORE_MEDIA_JOB_TYPE("score-media");
+static const QString QUIT_JOB_TYPE("quit");
+
+static constexpr int SERVER_PROBE_TIMEOUT_MS = 1000;
+
+ConverterDaemon::ConverterDaemon(IConverterController* converter, const io::path_t& stylePath, bool forceMode)
+    : m_converter(converter), m_stylePath(stylePath), m_forceMode(forceMode)
+{
+}
+
+mu::Ret ConverterDaemon::run(const std::string& serverName)
+{
+    IF_ASSERT_FAILED(m_converter) {
+        return make_ret(Err::UnknownError);
+    }
+
+    QString name = QString::fromStdString(serverName);
+    if (name.isEmpty() || name == STDIO_SERVER_NAME) {
+        return runOnStdio();
+    }
+
+    return runOnLocalSocket(name);
+}
+
+mu::Ret ConverterDaemon::runOnStdio()
+{
+    LOGI() << "waiting for jobs on stdin";
+
+    //! NOTE The log goes to stderr, so stdout only contains the responses
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        QByteArray request = QByteArray::fromStdString(line).trimmed();
+        if (request.isEmpty()) {
+            continue;
+        }
+
+        QByteArray response;
+        bool running = processRequest(request, response);
+
+        std::cout << response.toStdString() << std::endl;
+
+        if (!running) {
+            break;
+        }
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::Ret ConverterDaemon::runOnLocalSocket(const QString& serverName)
+{
+    //! NOTE Another daemon may already be listening on this name, its socket must not be taken over
+    QLocalSocket probe;
+    probe.connectToServer(serverName);
+    if (probe.waitForConnected(SERVER_PROBE_TIMEOUT_MS)) {
+        probe.disconnectFromServer();
+        LOGE() << "another daemon is already listening on: " << serverName;
+        return make_ret(Err::DaemonFailedListen, "another daemon is already listening on: " + serverName.toStdString());
+    }
+
+    //! NOTE Nobody answers, so the socket file is left by a daemon that hasn't been shut down properly
+    QLocalServer::removeServer(serverName);
+
+    QLocalServer server;
+    if (!server.listen(serverName)) {
+        LOGE() << "failed listen: " << server.errorString() << ", name: " << serverName;
+        return make_ret(Err::DaemonFailedListen, server.errorString().toStdString());
+    }
+
+    LOGI() << "waiting for jobs on: " << server.fullServerName();
+
+    //! NOTE There is no event loop in the converter mode, so the clients are served one by one with blocking calls
+    bool running = true;
+    while (running) {
+        if (!server.waitForNewConnection(-1)) {
+            LOGE() << "failed wait for connection: " << server.errorString();
+            return make_ret(Err::DaemonFailedListen, server.errorString().toStdString());
+        }
+
+        std::unique_ptr<QLocalSocket> socket(server.nextPendingConnection());
+        if (!socket) {
+            continue;
+        }
+
+        while (running) {
+            if (!socket->canReadLine() && !socket->waitForReadyRead(-1)) {
+                break;
+            }
+
+            while (running && socket->canReadLine()) {
+                QByteArray request = socket->readLine().trimmed();
+                if (request.isEmpty()) {
+                    continue;
+                }
+
+                QByteArray response;
+                running = processRequest(request, response);
+
+                socket->write(response + '\n');
+                socket->waitForBytesWritten(-1);
+            }
+        }
+
+        socket->disconnectFromServer();
+    }
+
+    server.close();
+
+    return make_ret(Ret::Code::Ok);
+}
+
+bool ConverterDaemon::processRequest(const QByteArray& request, QByteArray& response)
+{
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(request, &err);
+
+    QJsonObject job = doc.object();
+    bool running = job.value("type").toString() != QUIT_JOB_TYPE;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    Ret ret;
+    IConverterController::OutputResults outputs;
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+        ret = make_ret(Err::DaemonBadRequest, err.errorString().toStdString());
+    } else if (running) {
+        ret = processJob(job, outputs);
+    } else {
+        ret = make_ret(Ret::Code::Ok);
+    }
+
+    double durationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    if (!ret) {
+        LOGE() << "failed job, err: " << ret.toString() << ", request: " << request.toStdString();
+    }
+
+    QJsonObject result;
+    if (job.contains("id")) {
+        result["id"] = job.value("id");
+    }
+
+    result["success"] = ret.success();
+    result["errorCode"] = ret.code();
+    result["error"] = QString::fromStdString(ret.success() ? std::string() : ret.toString());
+    result["timeMs"] = durationMs;
+
+    QJsonArray outputsArray;
+    for (const IConverterController::OutputResult& output : outputs) {
+        QJsonObject outputObj;
+        outputObj["out"] = output.out.toQString();
+        outputObj["success"] = output.ret.success();
+        outputObj["errorCode"] = output.ret.code();
+        outputObj["error"] = QString::fromStdString(output.ret.success() ? std::string() : output.ret.toString());
+        outputObj["timeMs"] = output.durationMs;
+        outputsArray.append(outputObj);
+    }
+
+    result["outputs"] = outputsArray;
+
+    response = QJsonDocument(result).toJson(QJsonDocument::Compact);
+
+    return running;
+}
+
+mu::Ret ConverterDaemon::processJob(const QJsonObject& job, IConverterController::OutputResults& outputs)
+{
+    QString type = job.value("type").toString(CONVERT_JOB_TYPE);
+    io::path_t in = job.value("in").toString();
+    io::path_t stylePath = job.contains("style") ? io::path_t(job.value("style").toString()) : m_stylePath;
+    bool forceMode = job.value("force").toBool(m_forceMode);
+
+    io::paths_t outs;
+    QJsonValue outValue = job.value("out");
+    if (outValue.isArray()) {
+        const QJsonArray arr = outValue.toArray();
+        for (const QJsonValue v : arr) {
+            outs.push_back(v.toString());
+        }
+    } else {
+        outs.push_back(outValue.toString());
+    }
+
+    //! NOTE Without an output file the result would be written to stdout, that is the response channel
+    bool hasEmptyOut = std::any_of(outs.cbegin(), outs.cend(), [](const io::path_t& out) { return out.empty(); });
+    if (in.empty() || outs.empty() || hasEmptyOut) {
+        return make_ret(Err::DaemonBadRequest, "'in' and 'out' are required");
+    }
+
+    if (type == CONVERT_JOB_TYPE) {
+        return m_converter->fileConvert(in, outs, outputs, stylePath, forceMode);
+    }
+
+    if (type == SCORE_MEDIA_JOB_TYPE) {
+        //! NOTE All the media of the score go to one JSON file
+        if (outs.size() > 1) {
+            return make_ret(Err::DaemonBadRequest, "'score-media' takes a single 'out'");
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        IConverterController::OutputResult output;
+        output.out = outs.front();
+
+        io::path_t highlightConfigPath = job.value("highlightConfig").toString();
+        output.ret = m_converter->exportScoreMedia(in, output.out, highlightConfigPath, stylePath, forceMode);
+        output.durationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+        outputs.push_back(output);
+        return output.ret;
+    }
+
+    return make_ret(Err::DaemonBadRequest, "unknown job type: " + type.toStdString());
+}
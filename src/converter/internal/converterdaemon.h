@@ -0,0 +1,60 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_CONVERTER_CONVERTERDAEMON_H
+#define MU_CONVERTER_CONVERTERDAEMON_H
+
+#include <QByteArray>
+#include <QJsonObject>
+
+#include "../iconvertercontroller.h"
+
+namespace mu::converter {
+//! NOTE Keeps the application (fonts, instrument templates, soundfonts, ...) loaded between conversions
+//! and processes the jobs it receives as JSON lines, one response line per job:
+//! request:  {"id": 1, "type": "convert", "in": "a.mscz", "out": ["a.pdf", "a.mid"], "style": "s.mss", "force": false}
+//!           {"id": 2, "type": "score-media", "in": "a.mscz", "out": "a.json", "highlightConfig": "h.json"}
+//!           {"type": "quit"}
+//! response: {"id": 1, "success": true, "errorCode": 0, "error": "", "timeMs": 120.5,
+//!            "outputs": [{"out": "a.pdf", "success": true, "errorCode": 0, "error": "", "timeMs": 80.2}, ...]}
+class ConverterDaemon
+{
+public:
+    ConverterDaemon(IConverterController* converter, const io::path_t& stylePath, bool forceMode);
+
+    //! NOTE serverName is the name of the local socket to listen on, "-" means stdin/stdout
+    Ret run(const std::string& serverName);
+
+private:
+    Ret runOnStdio();
+    Ret runOnLocalSocket(const QString& serverName);
+
+    //! NOTE Returns false when the client asks the daemon to quit
+    bool processRequest(const QByteArray& request, QByteArray& response);
+    Ret processJob(const QJsonObject& job, IConverterController::OutputResults& outputs);
+
+    IConverterController* m_converter = nullptr;
+    io::path_t m_stylePath;
+    bool m_forceMode = false;
+};
+}
+
+#endif // MU_CONVERTER_CONVERTERDAEMON_H
@@ -36,6 +36,10 @@ const UiActionList DiagnosticsActions::m_actions = {
              mu::context::UiCtxAny,
              QT_TRANSLATE_NOOP("action", "Show profiler…")
              ),
+    UiAction("diagnostic-toggle-tracing",
+             mu::context::UiCtxAny,
+             QT_TRANSLATE_NOOP("action", "Start/stop tracing")
+             ),
     UiAction("diagnostic-show-navigation-tree",
              mu::context::UiCtxAny,
              QT_TRANSLATE_NOOP("action", "Show navigation tree…")
@@ -21,7 +21,10 @@
  */
 #include "diagnosticsactionscontroller.h"
 
+#include <QDateTime>
+
 #include "uri.h"
+#include "tracer.h"
 
 #include "view/diagnosticaccessiblemodel.h"
 
@@ -38,6 +41,7 @@ void DiagnosticsActionsController::init()
 {
     dispatcher()->reg(this, "diagnostic-show-paths", [this]() { openUri(SYSTEM_PATHS_URI); });
     dispatcher()->reg(this, "diagnostic-show-profiler", [this]() { openUri(PROFILER_URI); });
+    dispatcher()->reg(this, "diagnostic-toggle-tracing", this, &DiagnosticsActionsController::toggleTracing);
     dispatcher()->reg(this, "diagnostic-show-navigation-tree", [this]() { openUri(NAVIGATION_TREE_URI); });
     dispatcher()->reg(this, "diagnostic-show-accessible-tree", [this]() { openUri(ACCESSIBLE_TREE_URI); });
     dispatcher()->reg(this, "diagnostic-accessible-tree-dump", []() { DiagnosticAccessibleModel::dumpTree(); });
@@ -52,3 +56,19 @@ void DiagnosticsActionsController::openUri(const mu::UriQuery& uri, bool isSingl
 
     interactive()->open(uri);
 }
+
+void DiagnosticsActionsController::toggleTracing()
+{
+    Tracer* tracer = Tracer::instance();
+    if (tracer->isStarted()) {
+        tracer->stop();
+        return;
+    }
+
+    //! NOTE The trace is saved next to the logs, when the tracing is stopped
+    io::path_t tracePath = globalConfiguration()->userAppDataPath() + "/logs/MuseScore_trace_"
+                           + QDateTime::currentDateTime().toString("yyMMdd_HHmmss")
+                           + ".json";
+
+    tracer->start(tracePath);
+}
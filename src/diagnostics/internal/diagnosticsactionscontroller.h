@@ -26,6 +26,7 @@
 #include "actions/iactionsdispatcher.h"
 #include "actions/actionable.h"
 #include "iinteractive.h"
+#include "iglobalconfiguration.h"
 #include "accessibility/iaccessibilitycontroller.h"
 
 namespace mu::diagnostics {
@@ -33,6 +34,7 @@ class DiagnosticsActionsController : public actions::Actionable
 {
     INJECT(diagnostics, actions::IActionsDispatcher, dispatcher)
     INJECT(diagnostics, framework::IInteractive, interactive)
+    INJECT(diagnostics, framework::IGlobalConfiguration, globalConfiguration)
 
 public:
     DiagnosticsActionsController() = default;
@@ -41,6 +43,7 @@ public:
 
 private:
     void openUri(const mu::UriQuery& uri, bool isSingle = true);
+    void toggleTracing();
 };
 }
 
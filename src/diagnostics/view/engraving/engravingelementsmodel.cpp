@@ -26,6 +26,7 @@
 #include "engraving/libmscore/engravingobject.h"
 #include "engraving/libmscore/score.h"
 #include "engraving/libmscore/masterscore.h"
+#include "engraving/libmscore/undo.h"
 #include "dataformatter.h"
 
 #include "log.h"
@@ -348,6 +349,12 @@ void EngravingElementsModel::updateInfo()
         for (auto it = els.constBegin(); it != els.constEnd(); ++it) {
             stream << it.key() << ": " << it.value() << "\n";
         }
+
+        for (const mu::engraving::EngravingObject* el : elements) {
+            if (el->isScore() && mu::engraving::toScore(el)->isMaster()) {
+                writeUndoHistoryInfo(stream, mu::engraving::toScore(el)->undoStack());
+            }
+        }
     }
 
     {
@@ -360,6 +367,24 @@ void EngravingElementsModel::updateInfo()
     emit summaryChanged();
 }
 
+void EngravingElementsModel::writeUndoHistoryInfo(QTextStream& stream, const mu::engraving::UndoStack* undoStack) const
+{
+    if (!undoStack) {
+        return;
+    }
+
+    const size_t KB = 1024;
+
+    std::vector<size_t> macrosMemoryUsage = undoStack->macrosMemoryUsage();
+    stream << "\nUndo history: " << macrosMemoryUsage.size() << " macros, "
+           << undoStack->memoryUsage() / KB << " KB, budget: " << undoStack->memoryBudget() / KB << " KB"
+           << ", dropped: " << undoStack->droppedCount() << "\n";
+
+    for (size_t i = 0; i < macrosMemoryUsage.size(); ++i) {
+        stream << "  macro " << i << ": " << macrosMemoryUsage[i] / KB << " KB\n";
+    }
+}
+
 QString EngravingElementsModel::info() const
 {
     return m_info;
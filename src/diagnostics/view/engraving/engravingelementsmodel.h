@@ -24,11 +24,16 @@
 
 #include <QAbstractItemModel>
 #include <QHash>
+#include <QTextStream>
 
 #include "modularity/ioc.h"
 #include "iengravingelementsprovider.h"
 #include "actions/iactionsdispatcher.h"
 
+namespace mu::engraving {
+class UndoStack;
+}
+
 namespace mu::diagnostics {
 class EngravingElementsModel : public QAbstractItemModel
 {
@@ -103,6 +108,7 @@ private:
     const Item* findItem(const mu::engraving::EngravingObject* el, const Item* root) const;
 
     void updateInfo();
+    void writeUndoHistoryInfo(QTextStream& stream, const mu::engraving::UndoStack* undoStack) const;
 
     Item* m_rootItem = nullptr;
     QHash<quintptr, Item*> m_allItems;
@@ -41,6 +41,7 @@ public:
     virtual ~IEngravingConfiguration() = default;
 
     virtual io::path_t appDataPath() const = 0;
+    virtual io::path_t scoreFontsMetricsCachePath() const = 0;
 
     virtual io::path_t defaultStyleFilePath() const = 0;
     virtual void setDefaultStyleFilePath(const io::path_t& path) = 0;
@@ -85,6 +86,10 @@ public:
     virtual async::Notification debuggingOptionsChanged() const = 0;
 
     virtual bool isAccessibleEnabled() const = 0;
+
+    //! NOTE In bytes, 0 means unlimited
+    virtual size_t undoHistoryMemoryBudget() const = 0;
+    virtual void setUndoHistoryMemoryBudget(size_t bytes) = 0;
 };
 }
 
@@ -36,6 +36,8 @@ static const Settings::Key PART_STYLE_FILE_PATH("engraving", "engraving/style/pa
 
 static const Settings::Key INVERT_SCORE_COLOR("engraving", "engraving/scoreColorInversion");
 
+static const Settings::Key UNDO_HISTORY_MEMORY_BUDGET_MB("engraving", "engraving/undoHistoryMemoryBudgetMB");
+
 struct VoiceColorKey {
     Settings::Key key;
     Color color;
@@ -53,6 +55,8 @@ void EngravingConfiguration::init()
     };
 
     settings()->setDefaultValue(INVERT_SCORE_COLOR, Val(false));
+    //! NOTE The dropped macros can't be undone anymore, so the budget is opt-in (0 - unlimited)
+    settings()->setDefaultValue(UNDO_HISTORY_MEMORY_BUDGET_MB, Val(0));
     settings()->valueChanged(INVERT_SCORE_COLOR).onReceive(nullptr, [this](const Val&) {
         m_scoreInversionChanged.notify();
     });
@@ -78,6 +82,11 @@ mu::io::path_t EngravingConfiguration::appDataPath() const
     return globalConfiguration()->appDataPath();
 }
 
+mu::io::path_t EngravingConfiguration::scoreFontsMetricsCachePath() const
+{
+    return globalConfiguration()->userAppDataPath() + "/scorefonts";
+}
+
 mu::io::path_t EngravingConfiguration::defaultStyleFilePath() const
 {
     return settings()->value(DEFAULT_STYLE_FILE_PATH).toPath();
@@ -208,3 +217,14 @@ bool EngravingConfiguration::isAccessibleEnabled() const
 {
     return accessibilityConfiguration() ? accessibilityConfiguration()->enabled() : false;
 }
+
+size_t EngravingConfiguration::undoHistoryMemoryBudget() const
+{
+    int megabytes = settings()->value(UNDO_HISTORY_MEMORY_BUDGET_MB).toInt();
+    return megabytes > 0 ? static_cast<size_t>(megabytes) * 1024 * 1024 : 0;
+}
+
+void EngravingConfiguration::setUndoHistoryMemoryBudget(size_t bytes)
+{
+    settings()->setSharedValue(UNDO_HISTORY_MEMORY_BUDGET_MB, Val(static_cast<int>(bytes / (1024 * 1024))));
+}
@@ -44,6 +44,7 @@ public:
     void init();
 
     io::path_t appDataPath() const override;
+    io::path_t scoreFontsMetricsCachePath() const override;
 
     io::path_t defaultStyleFilePath() const override;
     void setDefaultStyleFilePath(const io::path_t& path) override;
@@ -82,6 +83,9 @@ public:
 
     bool isAccessibleEnabled() const override;
 
+    size_t undoHistoryMemoryBudget() const override;
+    void setUndoHistoryMemoryBudget(size_t bytes) override;
+
 private:
     async::Channel<voice_idx_t, draw::Color> m_voiceColorChanged;
     async::Notification m_scoreInversionChanged;
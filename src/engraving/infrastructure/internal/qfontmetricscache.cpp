@@ -0,0 +1,181 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "qfontmetricscache.h"
+
+#include "libmscore/mscore.h"
+
+using namespace mu;
+using namespace mu::draw;
+
+class FontPaintDevice : public QPaintDevice
+{
+public:
+    QPaintEngine* paintEngine() const override
+    {
+        return nullptr;
+    }
+
+protected:
+    int metric(PaintDeviceMetric m) const override
+    {
+        switch (m) {
+        case QPaintDevice::PdmDpiY:
+            return static_cast<int>(mu::engraving::DPI);
+        default:
+            return 1;
+        }
+    }
+};
+
+static FontPaintDevice device;
+
+// FontData
+
+QFontMetricsCache::FontData::FontData(const QFont& font, size_t maxStrings)
+    : m_qtMetrics(font, &device),
+    m_stringAdvances(maxStrings),
+    m_stringBBoxes(maxStrings),
+    m_stringTightBBoxes(maxStrings)
+{
+    m_lineSpacing = m_qtMetrics.lineSpacing();
+    m_xHeight = m_qtMetrics.xHeight();
+    m_height = m_qtMetrics.height();
+    m_ascent = m_qtMetrics.ascent();
+    m_descent = m_qtMetrics.descent();
+}
+
+double QFontMetricsCache::FontData::horizontalAdvance(const Char& ch)
+{
+    auto it = m_glyphAdvances.find(ch.unicode());
+    if (it != m_glyphAdvances.end()) {
+        return it->second;
+    }
+
+    double advance = m_qtMetrics.horizontalAdvance(QChar(ch.unicode()));
+    m_glyphAdvances.emplace(ch.unicode(), advance);
+    return advance;
+}
+
+RectF QFontMetricsCache::FontData::boundingRect(const Char& ch)
+{
+    auto it = m_glyphBBoxes.find(ch.unicode());
+    if (it != m_glyphBBoxes.end()) {
+        return it->second;
+    }
+
+    RectF rect = RectF::fromQRectF(m_qtMetrics.boundingRect(QChar(ch.unicode())));
+    m_glyphBBoxes.emplace(ch.unicode(), rect);
+    return rect;
+}
+
+double QFontMetricsCache::FontData::horizontalAdvance(const String& string)
+{
+    if (const double* advance = m_stringAdvances.find(string)) {
+        return *advance;
+    }
+
+    return m_stringAdvances.emplace(string, m_qtMetrics.horizontalAdvance(string.toQString()));
+}
+
+RectF QFontMetricsCache::FontData::boundingRect(const String& string)
+{
+    if (const RectF* rect = m_stringBBoxes.find(string)) {
+        return *rect;
+    }
+
+    return m_stringBBoxes.emplace(string, RectF::fromQRectF(m_qtMetrics.boundingRect(string.toQString())));
+}
+
+RectF QFontMetricsCache::FontData::tightBoundingRect(const String& string)
+{
+    if (const RectF* rect = m_stringTightBBoxes.find(string)) {
+        return *rect;
+    }
+
+    return m_stringTightBBoxes.emplace(string, RectF::fromQRectF(m_qtMetrics.tightBoundingRect(string.toQString())));
+}
+
+// QFontMetricsCache
+
+QFontMetricsCache::QFontMetricsCache(size_t maxFonts, size_t maxStringsPerFont)
+    : m_maxStringsPerFont(maxStringsPerFont), m_fonts(maxFonts)
+{
+}
+
+QFontMetricsCache::FontData& QFontMetricsCache::fontData(const Font& font)
+{
+    FontKey key = fontKey(font);
+    if (FontData* data = m_fonts.find(key)) {
+        return *data;
+    }
+
+    return m_fonts.emplace(key, font.toQFont(), m_maxStringsPerFont);
+}
+
+void QFontMetricsCache::clear()
+{
+    m_fonts.clear();
+}
+
+QFontMetricsCache::FontKey QFontMetricsCache::fontKey(const Font& font)
+{
+    FontKey key;
+    key.family = font.family();
+    key.pointSizeF = font.pointSizeF();
+    key.weight = static_cast<int>(font.weight());
+    key.bold = font.bold();
+    key.italic = font.italic();
+    key.underline = font.underline();
+    key.strike = font.strike();
+    key.noFontMerging = font.noFontMerging();
+    key.hinting = static_cast<int>(font.hinting());
+    return key;
+}
+
+bool QFontMetricsCache::FontKey::operator ==(const FontKey& other) const
+{
+    return family == other.family
+           && pointSizeF == other.pointSizeF
+           && weight == other.weight
+           && bold == other.bold
+           && italic == other.italic
+           && underline == other.underline
+           && strike == other.strike
+           && noFontMerging == other.noFontMerging
+           && hinting == other.hinting;
+}
+
+size_t QFontMetricsCache::FontKeyHash::operator()(const FontKey& key) const
+{
+    size_t styleBits = static_cast<size_t>(key.weight)
+                       | (static_cast<size_t>(key.hinting) << 8)
+                       | (static_cast<size_t>(key.bold) << 12)
+                       | (static_cast<size_t>(key.italic) << 13)
+                       | (static_cast<size_t>(key.underline) << 14)
+                       | (static_cast<size_t>(key.strike) << 15)
+                       | (static_cast<size_t>(key.noFontMerging) << 16);
+
+    size_t hash = key.family.hash();
+    hash ^= std::hash<double> {}(key.pointSizeF) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= styleBits + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
@@ -0,0 +1,170 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_DRAW_QFONTMETRICSCACHE_H
+#define MU_DRAW_QFONTMETRICSCACHE_H
+
+#include <list>
+#include <tuple>
+#include <unordered_map>
+
+#include <QFontMetricsF>
+
+#include "types/string.h"
+#include "infrastructure/draw/font.h"
+#include "infrastructure/draw/geometry.h"
+
+namespace mu::draw {
+/**
+ * @brief The QFontMetricsCache class keeps the font metrics which layout asks for over and over
+ *
+ * @details For every font (family, size and style) the cache holds the Qt font metrics object,
+ * the font-wide values, the per-glyph advance and bounding rect tables, and the LRU lists
+ * of the widths and bounding rects of the latest measured strings.
+ * The strings are measured as a whole by Qt, because kerning and shaping make a string
+ * width differ from the sum of its glyph advances.
+ * The class is not thread safe, the owner is responsible for locking.
+ */
+class QFontMetricsCache
+{
+public:
+    template<typename Key, typename Value, typename Hash = std::hash<Key> >
+    class LruCache
+    {
+    public:
+        explicit LruCache(size_t capacity)
+            : m_capacity(capacity) {}
+
+        Value* find(const Key& key)
+        {
+            auto it = m_index.find(key);
+            if (it == m_index.end()) {
+                return nullptr;
+            }
+
+            m_items.splice(m_items.begin(), m_items, it->second);
+            return &it->second->second;
+        }
+
+        template<typename ... Args>
+        Value& emplace(const Key& key, Args&& ... args)
+        {
+            m_items.emplace_front(std::piecewise_construct, std::forward_as_tuple(key),
+                                  std::forward_as_tuple(std::forward<Args>(args)...));
+            m_index[key] = m_items.begin();
+
+            if (m_items.size() > m_capacity) {
+                m_index.erase(m_items.back().first);
+                m_items.pop_back();
+            }
+
+            return m_items.front().second;
+        }
+
+        size_t size() const { return m_items.size(); }
+
+        void clear()
+        {
+            m_index.clear();
+            m_items.clear();
+        }
+
+    private:
+        using Items = std::list<std::pair<Key, Value> >;
+
+        size_t m_capacity = 0;
+        Items m_items;
+        std::unordered_map<Key, typename Items::iterator, Hash> m_index;
+    };
+
+    class FontData
+    {
+    public:
+        FontData(const QFont& font, size_t maxStrings);
+
+        const QFontMetricsF& qtMetrics() const { return m_qtMetrics; }
+
+        double lineSpacing() const { return m_lineSpacing; }
+        double xHeight() const { return m_xHeight; }
+        double height() const { return m_height; }
+        double ascent() const { return m_ascent; }
+        double descent() const { return m_descent; }
+
+        double horizontalAdvance(const Char& ch);
+        RectF boundingRect(const Char& ch);
+
+        double horizontalAdvance(const String& string);
+        RectF boundingRect(const String& string);
+        RectF tightBoundingRect(const String& string);
+
+    private:
+        QFontMetricsF m_qtMetrics;
+
+        double m_lineSpacing = 0.0;
+        double m_xHeight = 0.0;
+        double m_height = 0.0;
+        double m_ascent = 0.0;
+        double m_descent = 0.0;
+
+        std::unordered_map<char16_t, double> m_glyphAdvances;
+        std::unordered_map<char16_t, RectF> m_glyphBBoxes;
+
+        LruCache<String, double> m_stringAdvances;
+        LruCache<String, RectF> m_stringBBoxes;
+        LruCache<String, RectF> m_stringTightBBoxes;
+    };
+
+    QFontMetricsCache(size_t maxFonts = 64, size_t maxStringsPerFont = 2048);
+
+    //! NOTE The returned reference is valid until the next call
+    FontData& fontData(const Font& font);
+
+    void clear();
+
+private:
+    struct FontKey
+    {
+        String family;
+        double pointSizeF = 0.0;
+        int weight = 0;
+        bool bold = false;
+        bool italic = false;
+        bool underline = false;
+        bool strike = false;
+        bool noFontMerging = false;
+        int hinting = 0;
+
+        bool operator ==(const FontKey& other) const;
+    };
+
+    struct FontKeyHash
+    {
+        size_t operator()(const FontKey& key) const;
+    };
+
+    static FontKey fontKey(const Font& font);
+
+    size_t m_maxStringsPerFont = 0;
+    LruCache<FontKey, FontData, FontKeyHash> m_fonts;
+};
+}
+
+#endif // MU_DRAW_QFONTMETRICSCACHE_H
@@ -22,7 +22,6 @@
 #include "qfontprovider.h"
 
 #include <QFontDatabase>
-#include <QFontMetricsF>
 
 #include "libmscore/mscore.h"
 #include "fontengineft.h"
@@ -30,73 +29,68 @@
 using namespace mu;
 using namespace mu::draw;
 
-class FontPaintDevice : public QPaintDevice
-{
-public:
-    QPaintEngine* paintEngine() const override
-    {
-        return nullptr;
-    }
-
-protected:
-    int metric(PaintDeviceMetric m) const override
-    {
-        switch (m) {
-        case QPaintDevice::PdmDpiY:
-            return static_cast<int>(mu::engraving::DPI);
-        default:
-            return 1;
-        }
-    }
-};
-
-static FontPaintDevice device;
-
 int QFontProvider::addApplicationFont(const String& family, const String& path)
 {
     m_paths[family] = path;
-    return QFontDatabase::addApplicationFont(path);
+    int id = QFontDatabase::addApplicationFont(path);
+
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    m_metricsCache.clear();
+
+    return id;
 }
 
 void QFontProvider::insertSubstitution(const String& familyName, const String& substituteName)
 {
     QFont::insertSubstitution(familyName, substituteName);
+
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    m_metricsCache.clear();
 }
 
 double QFontProvider::lineSpacing(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).lineSpacing();
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    return m_metricsCache.fontData(f).lineSpacing();
 }
 
 double QFontProvider::xHeight(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).xHeight();
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    return m_metricsCache.fontData(f).xHeight();
 }
 
 double QFontProvider::height(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).height();
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    return m_metricsCache.fontData(f).height();
 }
 
 double QFontProvider::ascent(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).ascent();
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    return m_metricsCache.fontData(f).ascent();
 }
 
 double QFontProvider::descent(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).descent();
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    return m_metricsCache.fontData(f).descent();
 }
 
 bool QFontProvider::inFont(const Font& f, Char ch) const
 {
-    return QFontMetricsF(f.toQFont(), &device).inFont(ch);
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    return m_metricsCache.fontData(f).qtMetrics().inFont(ch);
 }
 
 bool QFontProvider::inFontUcs4(const Font& f, uint ucs4) const
 {
-    if (!QFontMetricsF(f.toQFont(), &device).inFontUcs4(ucs4)) {
-        return false;
+    {
+        std::lock_guard<std::mutex> lock(m_metricsMutex);
+        if (!m_metricsCache.fontData(f).qtMetrics().inFontUcs4(ucs4)) {
+            return false;
+        }
     }
 
     //! @NOTE some symbols in fonts dont have glyph. For example U+ee80
@@ -107,32 +101,38 @@ bool QFontProvider::inFontUcs4(const Font& f, uint ucs4) const
 
 double QFontProvider::horizontalAdvance(const Font& f, const String& string) const
 {
-    return QFontMetricsF(f.toQFont(), &device).horizontalAdvance(string);
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    return m_metricsCache.fontData(f).horizontalAdvance(string);
 }
 
 double QFontProvider::horizontalAdvance(const Font& f, const Char& ch) const
 {
-    return QFontMetricsF(f.toQFont(), &device).horizontalAdvance(ch);
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    return m_metricsCache.fontData(f).horizontalAdvance(ch);
 }
 
 RectF QFontProvider::boundingRect(const Font& f, const String& string) const
 {
-    return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).boundingRect(string));
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    return m_metricsCache.fontData(f).boundingRect(string);
 }
 
 RectF QFontProvider::boundingRect(const Font& f, const Char& ch) const
 {
-    return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).boundingRect(ch));
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    return m_metricsCache.fontData(f).boundingRect(ch);
 }
 
 RectF QFontProvider::boundingRect(const Font& f, const RectF& r, int flags, const String& string) const
 {
-    return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).boundingRect(r.toQRectF(), flags, string));
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    return RectF::fromQRectF(m_metricsCache.fontData(f).qtMetrics().boundingRect(r.toQRectF(), flags, string));
 }
 
 RectF QFontProvider::tightBoundingRect(const Font& f, const String& string) const
 {
-    return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).tightBoundingRect(string));
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    return m_metricsCache.fontData(f).tightBoundingRect(string);
 }
 
 // Score symbols
@@ -22,9 +22,13 @@
 #ifndef MU_DRAW_QFONTPROVIDER_H
 #define MU_DRAW_QFONTPROVIDER_H
 
+#include <mutex>
+
 #include <QHash>
 #include "infrastructure/draw/ifontprovider.h"
 
+#include "qfontmetricscache.h"
+
 namespace mu::draw {
 class FontEngineFT;
 class QFontProvider : public IFontProvider
@@ -63,6 +67,9 @@ private:
 
     QHash<QString /*family*/, QString /*path*/> m_paths;
     mutable QHash<QString /*path*/, FontEngineFT*> m_symEngines;
+
+    mutable std::mutex m_metricsMutex;
+    mutable QFontMetricsCache m_metricsCache;
 };
 }
 
@@ -21,6 +21,12 @@
  */
 #include "qpainterprovider.h"
 
+#include <algorithm>
+#include <mutex>
+
+#include <QCache>
+#include <QCoreApplication>
+#include <QImage>
 #include <QPainter>
 #include <QRawFont>
 #include <QTextLayout>
@@ -29,6 +35,7 @@
 #include <QPixmapCache>
 #include <QStaticText>
 #include <QPainterPath>
+#include <QThread>
 
 #include "draw/utils/drawlogger.h"
 #include "draw/transform.h"
@@ -288,7 +295,8 @@ void QPainterProvider::drawTextWorkaround(const Font& f, const PointF& pos, cons
 
 void QPainterProvider::drawSymbol(const PointF& point, char32_t ucs4Code)
 {
-    static QHash<char32_t, QString> cache;
+    //! NOTE The pages may be painted on several threads (e.g. PNG export), so each one has its own cache
+    thread_local QHash<char32_t, QString> cache;
     if (!cache.contains(ucs4Code)) {
         cache[ucs4Code] = QString::fromUcs4(&ucs4Code, 1);
     }
@@ -296,7 +304,37 @@ void QPainterProvider::drawSymbol(const PointF& point, char32_t ucs4Code)
     m_painter->drawText(QPointF(point.x(), point.y()), cache[ucs4Code]);
 }
 
-void QPainterProvider::drawPixmap(const PointF& point, const Pixmap& pm)
+static bool isGuiThread()
+{
+    const QCoreApplication* app = QCoreApplication::instance();
+    return app && QThread::currentThread() == app->thread();
+}
+
+//! NOTE QPixmap and QPixmapCache may only be used on the GUI thread,
+//! the other threads paint the images from a cache of their own
+static QImage cachedImage(const Pixmap& pm)
+{
+    static const int CACHE_LIMIT_KB = 10 * 1024;
+    static QCache<uint, QImage> cache(CACHE_LIMIT_KB);
+    static std::mutex mutex;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (const QImage* image = cache.object(pm.key())) {
+            return *image;
+        }
+    }
+
+    QImage image;
+    image.loadFromData(pm.data().toQByteArrayNoCopy());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    cache.insert(pm.key(), new QImage(image), std::max(1, static_cast<int>(image.sizeInBytes() / 1024)));
+
+    return image;
+}
+
+static QPixmap cachedPixmap(const Pixmap& pm)
 {
     QString key = QString::number(pm.key());
     QPixmap pixmap;
@@ -305,19 +343,30 @@ void QPainterProvider::drawPixmap(const PointF& point, const Pixmap& pm)
         QPixmapCache::insert(key, pixmap);
     }
 
-    m_painter->drawPixmap(QPointF(point.x(), point.y()), pixmap);
+    return pixmap;
+}
+
+void QPainterProvider::drawPixmap(const PointF& point, const Pixmap& pm)
+{
+    if (!isGuiThread()) {
+        m_painter->drawImage(QPointF(point.x(), point.y()), cachedImage(pm));
+        return;
+    }
+
+    m_painter->drawPixmap(QPointF(point.x(), point.y()), cachedPixmap(pm));
 }
 
 void QPainterProvider::drawTiledPixmap(const RectF& rect, const Pixmap& pm, const PointF& offset)
 {
-    QString key = QString::number(pm.key());
-    QPixmap pixmap;
-    if (!QPixmapCache::find(key, &pixmap)) {
-        pixmap.loadFromData(pm.data().toQByteArrayNoCopy());
-        QPixmapCache::insert(key, pixmap);
+    if (!isGuiThread()) {
+        //! NOTE The tiles start at the top left corner of the rect shifted by the offset, as with drawTiledPixmap
+        QBrush brush(cachedImage(pm));
+        brush.setTransform(QTransform::fromTranslate(rect.x() - offset.x(), rect.y() - offset.y()));
+        m_painter->fillRect(rect.toQRectF(), brush);
+        return;
     }
 
-    m_painter->drawTiledPixmap(rect.toQRectF(), pixmap, QPointF(offset.x(), offset.y()));
+    m_painter->drawTiledPixmap(rect.toQRectF(), cachedPixmap(pm), QPointF(offset.x(), offset.y()));
 }
 
 void QPainterProvider::drawPixmap(const PointF& point, const QPixmap& pm)
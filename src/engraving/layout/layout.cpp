@@ -55,6 +55,7 @@
 #include "layoutbeams.h"
 #include "layouttuplets.h"
 
+#include "tracer.h"
 #include "log.h"
 
 using namespace mu::engraving;
@@ -79,6 +80,8 @@ Layout::Layout(Score* score)
 
 void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, const Fraction& et)
 {
+    TRACE_SCOPE("layout", "Layout::doLayoutRange");
+
     CmdStateLocker cmdStateLocker(m_score);
     LayoutContext ctx(m_score);
 
@@ -229,6 +232,8 @@ void Layout::doLayout(const LayoutOptions& options, LayoutContext& lc)
 {
     MeasureBase* lmb;
     do {
+        TRACE_SCOPE("layout", "Layout::doLayout page");
+
         LayoutPage::getNextPage(options, lc);
         LayoutPage::collectPage(options, lc);
 
@@ -275,6 +280,8 @@ void Layout::doLayout(const LayoutOptions& options, LayoutContext& lc)
 
 void Layout::layoutLinear(bool layoutAll, const LayoutOptions& options, LayoutContext& lc)
 {
+    TRACE_SCOPE("layout", "Layout::layoutLinear");
+
     resetSystems(layoutAll, options, lc);
 
     collectLinearSystem(options, lc);
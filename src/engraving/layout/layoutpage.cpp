@@ -48,6 +48,7 @@
 #include "layouttuplets.h"
 #include "verticalgapdata.h"
 
+#include "tracer.h"
 #include "log.h"
 
 using namespace mu::engraving;
@@ -101,7 +102,7 @@ void LayoutPage::getNextPage(const LayoutOptions& options, LayoutContext& lc)
 
 void LayoutPage::collectPage(const LayoutOptions& options, LayoutContext& ctx)
 {
-    TRACEFUNC;
+    TRACE_SCOPE("layout", "LayoutPage::collectPage");
 
     const double slb = ctx.score()->styleMM(Sid::staffLowerBorder);
     bool breakPages = ctx.score()->layoutMode() != LayoutMode::SYSTEM;
@@ -47,6 +47,7 @@
 #include "layoutmeasure.h"
 #include "layouttuplets.h"
 
+#include "tracer.h"
 #include "log.h"
 
 using namespace mu::engraving;
@@ -57,7 +58,7 @@ using namespace mu::engraving;
 
 System* LayoutSystem::collectSystem(const LayoutOptions& options, LayoutContext& ctx, Score* score)
 {
-    TRACEFUNC;
+    TRACE_SCOPE("layout", "LayoutSystem::collectSystem");
 
     if (!ctx.curMeasure) {
         return nullptr;
@@ -408,6 +409,14 @@ System* LayoutSystem::collectSystem(const LayoutOptions& options, LayoutContext&
     // maxIter just serves as a safety exit to not get stuck in the loop in case a system can't be justified
     // (which can only happen if errors are made before getting here). It's set to a very high value to make
     // sure that the system really can't be justified, and it isn't just a "tricky" one needing more iterations.
+    // Only the stretch changes from one iteration to the next, the measures keep the distances
+    // between their segments instead of computing them again from the shapes
+    for (MeasureBase* mb : system->measures()) {
+        if (mb->isMeasure()) {
+            toMeasure(mb)->setSpacingCacheEnabled(true);
+        }
+    }
+
     while (abs(newRest) > epsilon && iter < maxIter) {
         stretchCoeff *= (1 + multiplier * newRest / curSysWidth);
         for (MeasureBase* mb : system->measures()) {
@@ -424,6 +433,12 @@ System* LayoutSystem::collectSystem(const LayoutOptions& options, LayoutContext&
         iter++;
     }
 
+    for (MeasureBase* mb : system->measures()) {
+        if (mb->isMeasure()) {
+            toMeasure(mb)->setSpacingCacheEnabled(false);
+        }
+    }
+
     // LAYOUT MEASURES
     PointF pos;
     firstMeasure = true;
@@ -622,6 +637,8 @@ void LayoutSystem::hideEmptyStaves(Score* score, System* system, bool isFirstSys
 
 void LayoutSystem::layoutSystemElements(const LayoutOptions& options, LayoutContext& lc, Score* score, System* system)
 {
+    TRACE_SCOPE("layout", "LayoutSystem::layoutSystemElements");
+
     if (score->noStaves()) {
         return;
     }
@@ -757,7 +774,7 @@ void LayoutSystem::layoutSystemElements(const LayoutOptions& options, LayoutCont
 
                         // add element to skyline
                         if (e->addToSkyline()) {
-                            skyline.add(e->shape().translated(e->pos() + p));
+                            skyline.add(e->shape(), e->pos() + p);
                         }
 
                         // add tremolo to skyline
@@ -767,7 +784,7 @@ void LayoutSystem::layoutSystemElements(const LayoutOptions& options, LayoutCont
                             Chord* c2 = t->chord2();
                             if (!t->twoNotes() || (c1 && !c1->staffMove() && c2 && !c2->staffMove())) {
                                 if (t->chord() == e && t->addToSkyline()) {
-                                    skyline.add(t->shape().translated(t->pos() + e->pos() + p));
+                                    skyline.add(t->shape(), t->pos() + e->pos() + p);
                                 }
                             }
                         }
@@ -271,6 +271,10 @@ void Score::undoRedo(bool undo, EditData* ed)
     //! NOTE: the order of operations is very important here
     //! 1. for the undo operation, the list of changed elements is available before undo()
     //! 2. for the redo operation, the list of changed elements will be available after redo()
+    //! NOTE The deferred layouts are done before the undo stack moves, so that their changes
+    //! are recorded into the macro which deferred them and are undone together with it
+    masterScore()->doPendingLayouts();
+
     ElementTypeSet changedElementTypes = changedTypes();
 
     cmdState().reset();
@@ -321,9 +325,19 @@ void Score::endCmd(bool rollback)
 
     LOGD() << "Undo stack current macro child count: " << undoStack()->current()->childCount();
 
-    const bool noUndo = undoStack()->current()->empty(); // nothing to undo?
+    const UndoMacro* macro = undoStack()->current();
+    const bool noUndo = macro->empty(); // nothing to undo?
     undoStack()->endMacro(noUndo);
 
+    if (noUndo) {
+        //! NOTE The macro is deleted, so the deferred layouts can't be recorded into it
+        for (Score* s : masterScore()->scoreList()) {
+            if (s->m_pendingLayoutMacro == macro) {
+                s->m_pendingLayoutMacro = nullptr;
+            }
+        }
+    }
+
     if (dirty()) {
         masterScore()->setPlaylistDirty(); // TODO: flag individual operations
         masterScore()->setAutosaveDirty(true);
@@ -398,8 +412,14 @@ void Score::update(bool resetCmdState)
         CmdState& cs = ms->cmdState();
         ms->deletePostponed();
         if (cs.layoutRange()) {
+            //! NOTE Only the master score, the edited score and the parts opened by the notation layer
+            //! are laid out immediately, the layout of other parts is deferred until they are shown, saved or exported
             for (Score* s : ms->scoreList()) {
-                s->doLayoutRange(cs.startTick(), cs.endTick());
+                if (s == ms || s == this || s->isOpen()) {
+                    s->doLayoutRange(cs.startTick(), cs.endTick());
+                } else {
+                    s->markLayoutRangeDirty(cs.startTick(), cs.endTick());
+                }
             }
             updateAll = true;
         }
@@ -436,7 +456,7 @@ void Score::update(bool resetCmdState)
     }
 
     if (_selection.isRange() && !_selection.isLocked()) {
-        _selection.updateSelectedElements();
+        _selection.updateChangedSelectedElements();
     }
 }
 
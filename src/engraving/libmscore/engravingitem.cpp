@@ -2693,6 +2693,13 @@ void EngravingItem::setSelected(bool f)
 
 #ifndef ENGRAVING_NO_ACCESSIBILITY
     if (f) {
+        //! NOTE Each newly selected element takes the focus of the previous one, so with a multiple
+        //! selection only the last one keeps it. Don't create the accessible objects of all the others
+        const std::vector<EngravingItem*>& selectedElements = score()->selection().elements();
+        if (selectedElements.size() > 1 && selectedElements.back() != this) {
+            return;
+        }
+
         initAccessibleIfNeed();
 
         if (m_accessible) {
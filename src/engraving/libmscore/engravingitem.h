@@ -178,6 +178,10 @@ public:
     bool accessibleEnabled() const;
     void setAccessibleEnabled(bool enabled);
 
+    //! NOTE The accessible objects are created on demand, when the element
+    //! (or one of its children) gets the screen reader focus
+    void initAccessibleIfNeed();
+
     EngravingItem& operator=(const EngravingItem&) = delete;
     //@ create a copy of the element
     virtual EngravingItem* clone() const = 0;
@@ -546,9 +550,6 @@ public:
     void setColorsInverionEnabled(bool enabled);
 
     std::pair<int, float> barbeat() const;
-
-private:
-    void initAccessibleIfNeed();
 };
 
 using ElementPtr = std::shared_ptr<EngravingItem>;
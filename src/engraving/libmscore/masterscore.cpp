@@ -57,6 +57,9 @@ MasterScore::MasterScore(std::weak_ptr<engraving::EngravingProject> project)
 {
     m_project = project;
     _undoStack   = new UndoStack();
+    if (configuration()) {
+        _undoStack->setMemoryBudget(configuration()->undoHistoryMemoryBudget());
+    }
     _tempomap    = new TempoMap;
     _sigmap      = new TimeSigMap();
     _repeatList  = new RepeatList(this);
@@ -214,12 +217,21 @@ const RepeatList& MasterScore::repeatList2() const
     return *_repeatList2;
 }
 
+void MasterScore::doPendingLayouts()
+{
+    for (Score* score : scoreList()) {
+        score->doPendingLayout();
+    }
+}
+
 bool MasterScore::writeMscz(MscWriter& mscWriter, bool onlySelection, bool doCreateThumbnail)
 {
     IF_ASSERT_FAILED(mscWriter.isOpened()) {
         return false;
     }
 
+    doPendingLayouts();
+
     // Write style of MasterScore
     {
         //! NOTE The style is writing to a separate file only for the master score.
@@ -325,6 +337,8 @@ bool MasterScore::writeMscz(MscWriter& mscWriter, bool onlySelection, bool doCre
 
 bool MasterScore::exportPart(MscWriter& mscWriter, Score* partScore)
 {
+    doPendingLayouts();
+
     // Write excerpt style as main
     {
         ByteArray excerptStyleData;
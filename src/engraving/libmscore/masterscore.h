@@ -23,6 +23,7 @@
 #define MU_ENGRAVING_MASTERSCORE_H
 
 #include "infrastructure/io/ifileinfoprovider.h"
+#include "iengravingconfiguration.h"
 
 #include "score.h"
 #include "instrument.h"
@@ -76,6 +77,8 @@ public:
 
 class MasterScore : public Score
 {
+    INJECT(engraving, IEngravingConfiguration, configuration)
+
     UndoStack* _undoStack = nullptr;
     TimeSigMap* _sigmap;
     TempoMap* _tempomap;
@@ -171,6 +174,9 @@ public:
     void setLayout(const Fraction& tick, staff_idx_t staff, const EngravingItem* e = nullptr);
     void setLayout(const Fraction& tick1, const Fraction& tick2, staff_idx_t staff1, staff_idx_t staff2, const EngravingItem* e = nullptr);
 
+    //! NOTE Lays out the parts whose layout was deferred (see Score::update), before they are saved or exported
+    void doPendingLayouts();
+
     CmdState& cmdState() override { return _cmdState; }
     const CmdState& cmdState() const override { return _cmdState; }
     void addLayoutFlags(LayoutFlags val) override { _cmdState.layoutFlags |= val; }
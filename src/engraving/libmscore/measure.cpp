@@ -4210,10 +4210,10 @@ void Measure::computeWidth(Segment* s, double x, bool isSystemHeader, Fraction m
         if (ns) {
             if (isSystemHeader && (ns->isStartRepeatBarLineType() || ns->isChordRestType() || (ns->isClefType() && !ns->header()))) {
                 // this is the system header gap
-                w = s->minHorizontalDistance(ns, true);
+                w = minHorizontalDistance(s, ns, true);
                 isSystemHeader = false;
             } else {
-                w = s->minHorizontalDistance(ns, false);
+                w = minHorizontalDistance(s, ns, false);
                 // New spacing algorithm: we apply an additional spacing which depends on the duration of
                 // the note with respect to the shortest note *of the system*.
                 if (s->isChordRestType()) {
@@ -4239,7 +4239,7 @@ void Measure::computeWidth(Segment* s, double x, bool isSystemHeader, Fraction m
             // Clefs (or breaths) are justified right-to-left. It is the clef (or breath) that needs to move left
             //(if there's space), not the following segment that needs to move right.
             if ((ns->isClefType() || ns->isBreathType()) && ns->next()) {
-                w -= std::max(ns->minHorizontalCollidingDistance(ns->next()), double(score()->styleMM(Sid::clefKeyRightMargin)));
+                w -= std::max(minHorizontalCollidingDistance(ns, ns->next()), double(score()->styleMM(Sid::clefKeyRightMargin)));
             }
 
             // Adjust the spacing for cross-staff beams situations
@@ -4264,7 +4264,7 @@ void Measure::computeWidth(Segment* s, double x, bool isSystemHeader, Fraction m
             // look back for collisions with previous segments
             // this is time consuming (ca. +5%) and probably requires more optimization
             if (s == fs) {     // don't let the second segment cross measure start (not covered by the loop below)
-                w = std::max(w, ns->minLeft(ls) - s->x());
+                w = std::max(w, minLeft(ns, ls) - s->x());
             }
 
             int n = 1;
@@ -4276,9 +4276,9 @@ void Measure::computeWidth(Segment* s, double x, bool isSystemHeader, Fraction m
                     break;
                 }
 
-                ww = ps->minHorizontalCollidingDistance(ns) - (s->x() - ps->x());
+                ww = minHorizontalCollidingDistance(ps, ns) - (s->x() - ps->x());
                 if (ps == fs) {
-                    ww = std::max(ww, ns->minLeft(ls) - s->x());
+                    ww = std::max(ww, minLeft(ns, ls) - s->x());
                 }
 
                 if (ww > w) {
@@ -4326,6 +4326,92 @@ void Measure::computeWidth(Segment* s, double x, bool isSystemHeader, Fraction m
     setWidth(x);
 }
 
+//---------------------------------------------------------
+//   setSpacingCacheEnabled
+//---------------------------------------------------------
+
+void Measure::setSpacingCacheEnabled(bool enabled)
+{
+    if (m_spacingCache.enabled == enabled) {
+        return;
+    }
+
+    m_spacingCache.clear();
+    m_spacingCache.enabled = enabled && !MScore::noSpacingCache;
+}
+
+void Measure::SpacingCache::clear()
+{
+    minHorizontalDistances.clear();
+    systemHeaderGaps.clear();
+    minHorizontalCollidingDistances.clear();
+    minLefts.clear();
+}
+
+//---------------------------------------------------------
+//   minHorizontalDistance
+//    the shapes of mm rest segments depend on the measure width, so they are never cached
+//---------------------------------------------------------
+
+double Measure::minHorizontalDistance(Segment* s, Segment* ns, bool isSystemHeaderGap)
+{
+    if (!m_spacingCache.enabled || s->isMMRestSegment() || ns->isMMRestSegment()) {
+        return s->minHorizontalDistance(ns, isSystemHeaderGap);
+    }
+
+    auto& distances = isSystemHeaderGap ? m_spacingCache.systemHeaderGaps : m_spacingCache.minHorizontalDistances;
+    auto it = distances.find({ s, ns });
+    if (it != distances.end()) {
+        return it->second;
+    }
+
+    double distance = s->minHorizontalDistance(ns, isSystemHeaderGap);
+    distances.emplace(SpacingCache::SegmentPair { s, ns }, distance);
+    return distance;
+}
+
+//---------------------------------------------------------
+//   minHorizontalCollidingDistance
+//---------------------------------------------------------
+
+double Measure::minHorizontalCollidingDistance(Segment* s, Segment* ns)
+{
+    if (!m_spacingCache.enabled || s->isMMRestSegment() || ns->isMMRestSegment()) {
+        return s->minHorizontalCollidingDistance(ns);
+    }
+
+    auto it = m_spacingCache.minHorizontalCollidingDistances.find({ s, ns });
+    if (it != m_spacingCache.minHorizontalCollidingDistances.end()) {
+        return it->second;
+    }
+
+    double distance = s->minHorizontalCollidingDistance(ns);
+    m_spacingCache.minHorizontalCollidingDistances.emplace(SpacingCache::SegmentPair { s, ns }, distance);
+    return distance;
+}
+
+//---------------------------------------------------------
+//   minLeft
+//    ls, the left barrier of the measure, only depends on isFirstInSystem(),
+//    that doesn't change while the cache is enabled
+//---------------------------------------------------------
+
+double Measure::minLeft(Segment* s, const Shape& ls)
+{
+    if (!m_spacingCache.enabled || s->isMMRestSegment()) {
+        return s->minLeft(ls);
+    }
+
+    auto it = m_spacingCache.minLefts.find(s);
+    if (it != m_spacingCache.minLefts.end()) {
+        return it->second;
+    }
+
+    double distance = s->minLeft(ls);
+    m_spacingCache.minLefts.emplace(s, distance);
+    return distance;
+}
+
 void Measure::computeWidth(Fraction minTicks, double stretchCoeff)
 {
     Segment* s;
@@ -4347,7 +4433,7 @@ void Measure::computeWidth(Fraction minTicks, double stretchCoeff)
     //
     Shape ls(first ? RectF(0.0, -1000000.0, 0.0, 2000000.0) : RectF(0.0, 0.0, 0.0, spatium() * 4));
 
-    x = s->isMMRestSegment() ? 0 : s->minLeft(ls);
+    x = s->isMMRestSegment() ? 0 : minLeft(s, ls);
 
     if (s->isStartRepeatBarLineType()) {
         System* sys = system();
@@ -4383,7 +4469,10 @@ void Measure::computeWidth(Fraction minTicks, double stretchCoeff)
     minWidth = std::min(minWidth, maxWidth); // Accounts for a case where the user may set the minMeasureWidth to a value larger than the available system width
 
     if (width() < minWidth) {
+        bool spacingCacheWasEnabled = spacingCacheEnabled();
+        setSpacingCacheEnabled(true);
         setWidthToTargetValue(s, x, isSystemHeader, minTicks, stretchCoeff, minWidth);
+        setSpacingCacheEnabled(spacingCacheWasEnabled);
         setWidthLocked(true);
     } else {
         setWidthLocked(false);
@@ -28,6 +28,8 @@
  Definition of class Measure.
 */
 
+#include <map>
+
 #include "measurebase.h"
 #include "segmentlist.h"
 
@@ -54,6 +56,7 @@ class AccidentalState;
 class Spanner;
 class Part;
 class MeasureRepeat;
+class Shape;
 
 //---------------------------------------------------------
 //   MeasureNumberMode
@@ -365,7 +368,30 @@ public:
     void stretchMeasureInPracticeMode(double stretch);
     double squeezableSpace() const { return _squeezableSpace; }
 
+    //! NOTE The distances between the segments come from their shapes only, so they don't change
+    //! while the stretch of the measure is being searched. With the cache they are computed once
+    //! and the next computeWidth() calls only work on numbers.
+    //! The cache must be disabled (and so cleared) before anything in the measure is laid out again.
+    void setSpacingCacheEnabled(bool enabled);
+    bool spacingCacheEnabled() const { return m_spacingCache.enabled; }
+
 private:
+    struct SpacingCache {
+        using SegmentPair = std::pair<const Segment*, const Segment*>;
+
+        bool enabled = false;
+        std::map<SegmentPair, double> minHorizontalDistances;
+        std::map<SegmentPair, double> systemHeaderGaps;
+        std::map<SegmentPair, double> minHorizontalCollidingDistances;
+        std::map<const Segment*, double> minLefts;
+
+        void clear();
+    };
+
+    double minHorizontalDistance(Segment* s, Segment* ns, bool isSystemHeaderGap);
+    double minHorizontalCollidingDistance(Segment* s, Segment* ns);
+    double minLeft(Segment* s, const Shape& ls);
+
     double _squeezableSpace = 0;
     friend class Factory;
     friend class rw::MeasureRW;
@@ -406,6 +432,8 @@ private:
 
     double m_layoutStretch = 1.0;
     bool _isWidthLocked = false;
+
+    SpacingCache m_spacingCache;
 };
 } // namespace mu::engraving
 #endif
@@ -76,6 +76,7 @@ bool MScore::testMode = false;
 
 // #ifndef NDEBUG
 bool MScore::noHorizontalStretch = false;
+bool MScore::noSpacingCache = false;
 bool MScore::noVerticalStretch   = false;
 bool MScore::useFallbackFont     = true;
 // #endif
@@ -285,6 +285,7 @@ public:
 
 // #ifndef NDEBUG
     static bool noHorizontalStretch;
+    static bool noSpacingCache;      // compute the segment distances again on every Measure::computeWidth()
     static bool noVerticalStretch;
     static bool useFallbackFont;
 // #endif
@@ -5481,6 +5481,13 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 {
     TRACEFUNC;
 
+    if (m_layoutPending) {
+        //! NOTE The score is laid out anyway, so catch up with the range deferred earlier
+        markLayoutRangeDirty(st, et);
+        doPendingLayout();
+        return;
+    }
+
     _scoreFont = ScoreFont::fontByName(style().value(Sid::MusicalSymbolFont).value<String>());
     _noteHeadWidth = _scoreFont->width(SymId::noteheadBlack, spatium() / SPATIUM20);
 
@@ -5496,6 +5503,75 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
     }
 }
 
+//---------------------------------------------------------
+//   markLayoutRangeDirty
+//    remember the range to be laid out later by doPendingLayout()
+//---------------------------------------------------------
+
+void Score::markLayoutRangeDirty(const Fraction& st, const Fraction& et)
+{
+    m_pendingLayoutFlags |= cmdState().layoutFlags;
+    m_pendingLayoutMacro = undoStack()->current();
+
+    if (!m_layoutPending) {
+        m_layoutPending = true;
+        m_pendingLayoutStartTick = st;
+        m_pendingLayoutEndTick = et;
+        return;
+    }
+
+    //! NOTE The ticks of an earlier range may have been shifted by the later commands,
+    //! so the merged range is always laid out up to the end of the score
+    Fraction startTick = std::max(st, Fraction(0, 1));
+    m_pendingLayoutStartTick = std::min(std::max(m_pendingLayoutStartTick, Fraction(0, 1)), startTick);
+    m_pendingLayoutEndTick = Fraction(-1, 1);
+}
+
+//---------------------------------------------------------
+//   doPendingLayout
+//---------------------------------------------------------
+
+void Score::doPendingLayout()
+{
+    if (!m_layoutPending) {
+        return;
+    }
+
+    TRACEFUNC;
+
+    m_layoutPending = false;
+
+    //! NOTE The layout flags of the commands are already reset, so restore those which were postponed
+    CmdState& cs = cmdState();
+    LayoutFlags layoutFlags = cs.layoutFlags;
+    cs.layoutFlags |= m_pendingLayoutFlags;
+    m_pendingLayoutFlags = LayoutFlag::NO_FLAGS;
+
+    Fraction startTick = m_pendingLayoutStartTick;
+    Fraction endTick = m_pendingLayoutEndTick;
+    if (startTick < Fraction(0, 1) && endTick < Fraction(0, 1)) {
+        startTick = Fraction(0, 1);
+    }
+
+    //! NOTE The layout changes the score through the undo stack (e.g. adds or removes the multimeasure rests),
+    //! so outside of a command these changes are recorded into the macro of the edit deferring the layout,
+    //! if it is still the last one. Otherwise (e.g. the layout was deferred by undo/redo) they aren't recorded,
+    //! as the ones of the layout done right after undo/redo
+    const UndoMacro* pendingLayoutMacro = m_pendingLayoutMacro;
+    m_pendingLayoutMacro = nullptr;
+
+    UndoStack* undo = undoStack();
+    bool appendingToLast = !undo->active() && pendingLayoutMacro && undo->beginAppendingToLast(pendingLayoutMacro);
+
+    doLayoutRange(startTick, endTick);
+
+    if (appendingToLast) {
+        undo->endAppendingToLast();
+    }
+
+    cs.layoutFlags = layoutFlags;
+}
+
 void Score::createPaddingTable()
 {
     for (int i=0; i < int(ElementType::MAXTYPE); ++i) {
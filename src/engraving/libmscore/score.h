@@ -117,6 +117,7 @@ class TimeSig;
 class TimeSigMap;
 class Tuplet;
 class UndoCommand;
+class UndoMacro;
 class UndoStack;
 class XmlReader;
 class XmlWriter;
@@ -463,6 +464,13 @@ private:
     Layout m_layout;
     LayoutOptions m_layoutOptions;
 
+    //! NOTE Range of a layout that was deferred by Score::update() until the score is shown or exported
+    bool m_layoutPending = false;
+    Fraction m_pendingLayoutStartTick = { -1, 1 };
+    Fraction m_pendingLayoutEndTick = { -1, 1 };
+    LayoutFlags m_pendingLayoutFlags;
+    const UndoMacro* m_pendingLayoutMacro = nullptr; // the macro of the last edit deferring the layout, if any
+
     mu::async::Channel<EngravingItem*> m_elementDestroyed;
 
     mu::async::Channel<ScoreChangesRange> m_changesRangeChannel;
@@ -1067,6 +1075,10 @@ public:
     void doLayout();
     void doLayoutRange(const Fraction& st, const Fraction& et);
 
+    void markLayoutRangeDirty(const Fraction& st, const Fraction& et);
+    bool isLayoutPending() const { return m_layoutPending; }
+    void doPendingLayout();
+
     SynthesizerState& synthesizerState() { return _synthesizerState; }
     void setSynthesizerState(const SynthesizerState& s);
 
@@ -21,8 +21,11 @@
  */
 #include "scorefont.h"
 
+#include <cstring>
+
 #include "serialization/json.h"
 #include "io/file.h"
+#include "io/fileinfo.h"
 #include "draw/painter.h"
 #include "types/symnames.h"
 
@@ -30,6 +33,12 @@
 
 #include "log.h"
 
+#if defined(Q_OS_WIN)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
 using namespace mu;
 using namespace mu::io;
 using namespace mu::draw;
@@ -236,11 +245,42 @@ const char* ScoreFont::fallbackTextFont()
 // =============================================
 
 void ScoreFont::load()
+{
+    if (!loadFontFace()) {
+        return;
+    }
+
+    //! NOTE Computing the metrics of every symbol through FreeType and parsing the metadata
+    //! takes a while, so the results are kept in a binary cache keyed by the sizes and the dates of the sources
+    io::path_t cachePath = metricsCachePath();
+    ByteArray sourceKey = cachePath.empty() ? ByteArray() : metricsSourceKey();
+
+    EngravingDefaultValues engravingDefaults;
+    if (!sourceKey.empty() && readMetricsCache(cachePath, sourceKey, engravingDefaults)) {
+        loadEngravingDefaults(engravingDefaults);
+        m_loaded = true;
+        return;
+    }
+
+    if (!computeAllMetrics(engravingDefaults)) {
+        return;
+    }
+
+    loadEngravingDefaults(engravingDefaults);
+
+    if (!sourceKey.empty()) {
+        writeMetricsCache(cachePath, sourceKey, engravingDefaults);
+    }
+
+    m_loaded = true;
+}
+
+bool ScoreFont::loadFontFace()
 {
     String facePath = m_fontPath + m_filename;
     if (-1 == fontProvider()->addApplicationFont(m_family, facePath)) {
         LOGE() << "fatal error: cannot load internal font: " << facePath;
-        return;
+        return false;
     }
 
     m_font.setWeight(mu::draw::Font::Normal);
@@ -249,6 +289,19 @@ void ScoreFont::load()
     m_font.setNoFontMerging(true);
     m_font.setHinting(mu::draw::Font::Hinting::PreferVerticalHinting);
 
+    return true;
+}
+
+bool ScoreFont::computeAllMetrics(EngravingDefaultValues& engravingDefaults)
+{
+    File metadataFile(m_fontPath + u"metadata.json");
+    if (!metadataFile.open(IODevice::ReadOnly)) {
+        LOGE() << "Failed to open glyph metadata file: " << metadataFile.filePath();
+        return false;
+    }
+
+    ByteArray metadata = metadataFile.readAll();
+
     for (size_t id = 0; id < s_symIdCodes.size(); ++id) {
         Code code = s_symIdCodes[id];
         if (code.smuflCode == 0 && code.musicSymBlockCode == 0) {
@@ -258,25 +311,20 @@ void ScoreFont::load()
         computeMetrics(sym, code);
     }
 
-    File metadataFile(m_fontPath + u"metadata.json");
-    if (!metadataFile.open(IODevice::ReadOnly)) {
-        LOGE() << "Failed to open glyph metadata file: " << metadataFile.filePath();
-        return;
-    }
-
     std::string error;
-    JsonObject metadataJson = JsonDocument::fromJson(metadataFile.readAll(), &error).rootObject();
+    JsonObject metadataJson = JsonDocument::fromJson(metadata, &error).rootObject();
     if (!error.empty()) {
         LOGE() << "Json parse error in " << metadataFile.filePath() << ", error: " << error;
-        return;
+        return false;
     }
 
+    engravingDefaults = readEngravingDefaults(metadataJson.value("engravingDefaults").toObject());
+
     loadGlyphsWithAnchors(metadataJson.value("glyphsWithAnchors").toObject());
     loadComposedGlyphs();
     loadStylisticAlternates(metadataJson.value("glyphsWithAlternates").toObject());
-    loadEngravingDefaults(metadataJson.value("engravingDefaults").toObject());
 
-    m_loaded = true;
+    return true;
 }
 
 void ScoreFont::loadGlyphsWithAnchors(const JsonObject& glyphsWithAnchors)
@@ -555,7 +603,21 @@ void ScoreFont::loadStylisticAlternates(const JsonObject& glyphsWithAlternatesOb
     }
 }
 
-void ScoreFont::loadEngravingDefaults(const JsonObject& engravingDefaultsObject)
+ScoreFont::EngravingDefaultValues ScoreFont::readEngravingDefaults(const JsonObject& engravingDefaultsObject)
+{
+    EngravingDefaultValues engravingDefaults;
+
+    for (const std::string& key : engravingDefaultsObject.keys()) {
+        JsonValue value = engravingDefaultsObject.value(key);
+        if (value.isNumber()) {
+            engravingDefaults.push_back({ key, value.toDouble() });
+        }
+    }
+
+    return engravingDefaults;
+}
+
+void ScoreFont::loadEngravingDefaults(const EngravingDefaultValues& engravingDefaults)
 {
     static const std::unordered_map<std::string, Sid> engravingDefaultsMapping = {
         { "staffLineThickness",            Sid::staffLineWidth },
@@ -581,21 +643,19 @@ void ScoreFont::loadEngravingDefaults(const JsonObject& engravingDefaultsObject)
         { "tupletBracketThickness",        Sid::tupletBracketWidth }
     };
 
-    for (const std::string& key : engravingDefaultsObject.keys()) {
+    for (const auto& [key, value] : engravingDefaults) {
         if (key == "textEnclosureThickness") {
-            m_textEnclosureThickness = engravingDefaultsObject.value(key).toDouble();
+            m_textEnclosureThickness = value;
             continue;
         }
 
         if (key == "beamSpacing") {
-            bool value = engravingDefaultsObject.value(key).toDouble() > 0.75;
-            m_engravingDefaults.insert({ Sid::useWideBeams, value });
+            m_engravingDefaults.insert({ Sid::useWideBeams, value > 0.75 });
             continue;
         }
 
         auto search = engravingDefaultsMapping.find(key);
         if (search != engravingDefaultsMapping.cend()) {
-            double value = engravingDefaultsObject.value(key).toDouble();
             m_engravingDefaults.insert({ search->second, value });
         }
     }
@@ -617,6 +677,285 @@ void ScoreFont::computeMetrics(ScoreFont::Sym& sym, const Code& code)
     }
 }
 
+// =============================================
+// Metrics cache
+// =============================================
+
+//! NOTE The cache file consists of plain records, so it can be used right after reading (or mapping) it:
+//! MetricsCacheHeader, SymbolRecord per SymId, AnchorRecord per anchor of the symbols in order,
+//! uint32_t per sub symbol of the composed symbols in order, EngravingDefaultRecord per engraving default
+
+static constexpr char METRICS_CACHE_MAGIC[4] = { 'M', 'S', 'F', 'M' };
+static constexpr uint32_t METRICS_CACHE_VERSION = 2;
+static constexpr size_t METRICS_CACHE_MAX_HASH_SIZE = 32;
+static constexpr size_t METRICS_CACHE_MAX_KEY_SIZE = 56;
+
+struct MetricsCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t hashSize;
+    uint8_t hash[METRICS_CACHE_MAX_HASH_SIZE];
+    uint32_t symbolsCount;
+    uint32_t anchorsCount;
+    uint32_t subSymbolsCount;
+    uint32_t engravingDefaultsCount;
+};
+
+struct SymbolRecord {
+    uint32_t code;
+    uint16_t anchorsCount;
+    uint16_t subSymbolsCount;
+    double bbox[4];
+    double advance;
+};
+
+struct AnchorRecord {
+    uint32_t anchorId;
+    uint32_t reserved;
+    double x;
+    double y;
+};
+
+struct EngravingDefaultRecord {
+    char key[METRICS_CACHE_MAX_KEY_SIZE];
+    double value;
+};
+
+//! NOTE FNV-1a, the key only has to change when a source changes
+static void hashBytes(uint64_t& hash, const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+static void hashString(uint64_t& hash, const std::string& str)
+{
+    hashBytes(hash, str.data(), str.size());
+    hashBytes(hash, "", 1);
+}
+
+static int64_t currentProcessId()
+{
+#if defined(Q_OS_WIN)
+    return static_cast<int64_t>(_getpid());
+#else
+    return static_cast<int64_t>(getpid());
+#endif
+}
+
+ByteArray ScoreFont::metricsSourceKey() const
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    //! NOTE The files are not read, their paths, sizes and modification dates are enough to notice a change
+    for (const io::path_t& path : { io::path_t(m_fontPath + m_filename), io::path_t(m_fontPath + u"metadata.json") }) {
+        RetVal<uint64_t> size = fileSystem()->fileSize(path);
+        if (!size.ret) {
+            return ByteArray();
+        }
+
+        hashString(hash, path.toStdString());
+        hashBytes(hash, &size.val, sizeof(size.val));
+        hashString(hash, io::FileInfo(path).lastModified().toString().toStdString());
+    }
+
+    //! NOTE The symbol codes come from glyphnames.json, so they are a source as well
+    hashBytes(hash, s_symIdCodes.data(), sizeof(s_symIdCodes));
+
+    return ByteArray(reinterpret_cast<const uint8_t*>(&hash), sizeof(hash));
+}
+
+io::path_t ScoreFont::metricsCachePath() const
+{
+    if (!engravingConfiguration()) {
+        return io::path_t();
+    }
+
+    io::path_t dir = engravingConfiguration()->scoreFontsMetricsCachePath();
+    if (dir.empty()) {
+        return io::path_t();
+    }
+
+    return dir + "/" + m_name + ".metrics";
+}
+
+bool ScoreFont::readMetricsCache(const io::path_t& cachePath, const ByteArray& sourceKey, EngravingDefaultValues& engravingDefaults)
+{
+    TRACEFUNC;
+
+    if (!File::exists(cachePath)) {
+        return false;
+    }
+
+    File file(cachePath);
+    if (!file.open(IODevice::ReadOnly)) {
+        return false;
+    }
+
+    ByteArray data = file.readAll();
+    if (data.size() < sizeof(MetricsCacheHeader)) {
+        return false;
+    }
+
+    const uint8_t* ptr = data.constData();
+
+    MetricsCacheHeader header;
+    std::memcpy(&header, ptr, sizeof(header));
+    ptr += sizeof(header);
+
+    if (std::memcmp(header.magic, METRICS_CACHE_MAGIC, sizeof(header.magic)) != 0
+        || header.version != METRICS_CACHE_VERSION
+        || header.hashSize != sourceKey.size()
+        || std::memcmp(header.hash, sourceKey.constData(), sourceKey.size()) != 0
+        || header.symbolsCount != m_symbols.size()) {
+        LOGI() << "metrics cache is outdated: " << cachePath;
+        return false;
+    }
+
+    const size_t expectedSize = sizeof(MetricsCacheHeader)
+                                + header.symbolsCount * sizeof(SymbolRecord)
+                                + header.anchorsCount * sizeof(AnchorRecord)
+                                + header.subSymbolsCount * sizeof(uint32_t)
+                                + header.engravingDefaultsCount * sizeof(EngravingDefaultRecord);
+    if (data.size() != expectedSize) {
+        LOGW() << "metrics cache is corrupted: " << cachePath;
+        return false;
+    }
+
+    const SymbolRecord* symbols = reinterpret_cast<const SymbolRecord*>(ptr);
+    ptr += header.symbolsCount * sizeof(SymbolRecord);
+    const AnchorRecord* anchors = reinterpret_cast<const AnchorRecord*>(ptr);
+    ptr += header.anchorsCount * sizeof(AnchorRecord);
+    const uint32_t* subSymbols = reinterpret_cast<const uint32_t*>(ptr);
+    ptr += header.subSymbolsCount * sizeof(uint32_t);
+    const EngravingDefaultRecord* defaults = reinterpret_cast<const EngravingDefaultRecord*>(ptr);
+
+    size_t anchorIdx = 0;
+    size_t subSymbolIdx = 0;
+
+    for (size_t id = 0; id < header.symbolsCount; ++id) {
+        const SymbolRecord& record = symbols[id];
+        if (anchorIdx + record.anchorsCount > header.anchorsCount
+            || subSymbolIdx + record.subSymbolsCount > header.subSymbolsCount) {
+            LOGW() << "metrics cache is corrupted: " << cachePath;
+            m_symbols.assign(m_symbols.size(), Sym());
+            return false;
+        }
+
+        Sym& sym = m_symbols[id];
+        sym = Sym();
+        sym.code = record.code;
+        sym.bbox = RectF(record.bbox[0], record.bbox[1], record.bbox[2], record.bbox[3]);
+        sym.advance = record.advance;
+
+        for (uint16_t i = 0; i < record.anchorsCount; ++i, ++anchorIdx) {
+            const AnchorRecord& anchor = anchors[anchorIdx];
+            sym.smuflAnchors[static_cast<SmuflAnchorId>(anchor.anchorId)] = PointF(anchor.x, anchor.y);
+        }
+
+        for (uint16_t i = 0; i < record.subSymbolsCount; ++i, ++subSymbolIdx) {
+            sym.subSymbolIds.push_back(static_cast<SymId>(subSymbols[subSymbolIdx]));
+        }
+    }
+
+    for (size_t i = 0; i < header.engravingDefaultsCount; ++i) {
+        const EngravingDefaultRecord& record = defaults[i];
+        std::string key(record.key, strnlen(record.key, METRICS_CACHE_MAX_KEY_SIZE));
+        engravingDefaults.push_back({ key, record.value });
+    }
+
+    return true;
+}
+
+void ScoreFont::writeMetricsCache(const io::path_t& cachePath, const ByteArray& sourceKey,
+                                  const EngravingDefaultValues& engravingDefaults) const
+{
+    TRACEFUNC;
+
+    std::vector<SymbolRecord> symbols;
+    std::vector<AnchorRecord> anchors;
+    std::vector<uint32_t> subSymbols;
+    std::vector<EngravingDefaultRecord> defaults;
+
+    symbols.reserve(m_symbols.size());
+
+    for (const Sym& sym : m_symbols) {
+        SymbolRecord record {};
+        record.code = sym.code;
+        record.anchorsCount = static_cast<uint16_t>(sym.smuflAnchors.size());
+        record.subSymbolsCount = static_cast<uint16_t>(sym.subSymbolIds.size());
+        record.bbox[0] = sym.bbox.x();
+        record.bbox[1] = sym.bbox.y();
+        record.bbox[2] = sym.bbox.width();
+        record.bbox[3] = sym.bbox.height();
+        record.advance = sym.advance;
+        symbols.push_back(record);
+
+        for (const auto& [anchorId, pos] : sym.smuflAnchors) {
+            AnchorRecord anchor {};
+            anchor.anchorId = static_cast<uint32_t>(anchorId);
+            anchor.x = pos.x();
+            anchor.y = pos.y();
+            anchors.push_back(anchor);
+        }
+
+        for (SymId subSymbolId : sym.subSymbolIds) {
+            subSymbols.push_back(static_cast<uint32_t>(subSymbolId));
+        }
+    }
+
+    for (const auto& [key, value] : engravingDefaults) {
+        if (key.size() >= METRICS_CACHE_MAX_KEY_SIZE) {
+            continue;
+        }
+
+        EngravingDefaultRecord record {};
+        std::memcpy(record.key, key.data(), key.size());
+        record.value = value;
+        defaults.push_back(record);
+    }
+
+    MetricsCacheHeader header {};
+    std::memcpy(header.magic, METRICS_CACHE_MAGIC, sizeof(header.magic));
+    header.version = METRICS_CACHE_VERSION;
+    header.hashSize = static_cast<uint32_t>(sourceKey.size());
+    std::memcpy(header.hash, sourceKey.constData(), sourceKey.size());
+    header.symbolsCount = static_cast<uint32_t>(symbols.size());
+    header.anchorsCount = static_cast<uint32_t>(anchors.size());
+    header.subSymbolsCount = static_cast<uint32_t>(subSymbols.size());
+    header.engravingDefaultsCount = static_cast<uint32_t>(defaults.size());
+
+    Ret ret = fileSystem()->makePath(io::dirpath(cachePath));
+    if (!ret) {
+        LOGW() << "failed to create the metrics cache directory: " << ret.toString();
+        return;
+    }
+
+    //! NOTE Written to a temporary file first, so a concurrently loading process never reads a partial cache.
+    //! The name is unique per process, so two processes writing the cache at once don't write into the same file
+    io::path_t tmpPath = cachePath + "." + std::to_string(currentProcessId()) + ".tmp";
+    File file(tmpPath);
+    if (!file.open(IODevice::WriteOnly)) {
+        LOGW() << "failed to write the metrics cache: " << tmpPath;
+        return;
+    }
+
+    file.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const uint8_t*>(symbols.data()), symbols.size() * sizeof(SymbolRecord));
+    file.write(reinterpret_cast<const uint8_t*>(anchors.data()), anchors.size() * sizeof(AnchorRecord));
+    file.write(reinterpret_cast<const uint8_t*>(subSymbols.data()), subSymbols.size() * sizeof(uint32_t));
+    file.write(reinterpret_cast<const uint8_t*>(defaults.data()), defaults.size() * sizeof(EngravingDefaultRecord));
+    file.close();
+
+    ret = fileSystem()->move(tmpPath, cachePath, true);
+    if (!ret) {
+        LOGW() << "failed to write the metrics cache: " << ret.toString();
+    }
+}
+
 // =============================================
 // Symbol properties
 // =============================================
@@ -763,11 +1102,13 @@ void ScoreFont::draw(SymId id, Painter* painter, const SizeF& mag, const PointF&
         return;
     }
 
+    //! NOTE The font is shared by the pages painted concurrently, so the size is set on a copy
+    mu::draw::Font font = m_font;
+    font.setPointSizeF(20.0 * MScore::pixelRatio);
+
     painter->save();
-    double size = 20.0 * MScore::pixelRatio;
-    m_font.setPointSizeF(size);
     painter->scale(mag.width(), mag.height());
-    painter->setFont(m_font);
+    painter->setFont(font);
     painter->drawSymbol(PointF(pos.x() / mag.width(), pos.y() / mag.height()), symCode(id));
     painter->restore();
 }
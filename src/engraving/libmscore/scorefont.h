@@ -24,12 +24,16 @@
 
 #include <unordered_map>
 
+#include <gtest/gtest_prod.h>
+
 #include "style/style.h"
 
 #include "infrastructure/draw/geometry.h"
 
 #include "modularity/ioc.h"
 #include "infrastructure/draw/ifontprovider.h"
+#include "io/ifilesystem.h"
+#include "iengravingconfiguration.h"
 
 namespace mu {
 class JsonObject;
@@ -43,6 +47,8 @@ namespace mu::engraving {
 class ScoreFont
 {
     INJECT_STATIC(score, mu::draw::IFontProvider, fontProvider)
+    INJECT_STATIC(score, io::IFileSystem, fileSystem)
+    INJECT_STATIC(score, IEngravingConfiguration, engravingConfiguration)
 
 public:
     ScoreFont(const char* name, const char* family, const char* path, const char* filename);
@@ -88,13 +94,15 @@ public:
 
 private:
 
+    FRIEND_TEST(Engraving_ScoreFontTests, MetricsCacheRoundTrip);
+
     struct Code {
         uint smuflCode = 0;
         uint musicSymBlockCode = 0;
     };
 
     struct Sym {
-        uint code;
+        uint code = 0;
         mu::RectF bbox;
         double advance = 0.0;
 
@@ -115,18 +123,27 @@ private:
     static bool initGlyphNamesJson();
 
     void load();
+    bool loadFontFace();
     void loadGlyphsWithAnchors(const JsonObject& glyphsWithAnchors);
     void loadComposedGlyphs();
     void loadStylisticAlternates(const JsonObject& glyphsWithAlternatesObject);
-    void loadEngravingDefaults(const JsonObject& engravingDefaultsObject);
+    using EngravingDefaultValues = std::vector<std::pair<std::string, double> >;
+    static EngravingDefaultValues readEngravingDefaults(const JsonObject& engravingDefaultsObject);
+    void loadEngravingDefaults(const EngravingDefaultValues& engravingDefaults);
     void computeMetrics(Sym& sym, const Code& code);
+    bool computeAllMetrics(EngravingDefaultValues& engravingDefaults);
+
+    ByteArray metricsSourceKey() const;
+    io::path_t metricsCachePath() const;
+    bool readMetricsCache(const io::path_t& cachePath, const ByteArray& sourceKey, EngravingDefaultValues& engravingDefaults);
+    void writeMetricsCache(const io::path_t& cachePath, const ByteArray& sourceKey, const EngravingDefaultValues& engravingDefaults) const;
 
     Sym& sym(SymId id);
     const Sym& sym(SymId id) const;
 
     bool m_loaded = false;
     std::vector<Sym> m_symbols;
-    mutable mu::draw::Font m_font;
+    mu::draw::Font m_font;
 
     String m_name;
     String m_family;
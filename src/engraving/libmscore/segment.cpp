@@ -237,7 +237,7 @@ void Segment::init()
     size_t staves = score()->nstaves();
     size_t tracks = staves * VOICES;
     _elist.assign(tracks, 0);
-    _preAppendedItems.assign(tracks, 0);
+    _preAppendedItems.clear();
     _dotPosX.assign(staves, 0.0);
     _shapes.assign(staves, Shape());
 }
@@ -493,7 +493,11 @@ void Segment::insertStaff(staff_idx_t staff)
     track_idx_t track = staff * VOICES;
     for (voice_idx_t voice = 0; voice < VOICES; ++voice) {
         _elist.insert(_elist.begin() + track, 0);
-        _preAppendedItems.insert(_preAppendedItems.begin() + track, 0);
+    }
+    for (auto& preAppended : _preAppendedItems) {
+        if (preAppended.first >= track) {
+            preAppended.first += VOICES;
+        }
     }
     _dotPosX.insert(_dotPosX.begin() + staff, 0.0);
     _shapes.insert(_shapes.begin() + staff, Shape());
@@ -515,7 +519,14 @@ void Segment::removeStaff(staff_idx_t staff)
 {
     track_idx_t track = staff * VOICES;
     _elist.erase(_elist.begin() + track, _elist.begin() + track + VOICES);
-    _preAppendedItems.erase(_preAppendedItems.begin() + track, _preAppendedItems.begin() + track + VOICES);
+    _preAppendedItems.erase(std::remove_if(_preAppendedItems.begin(), _preAppendedItems.end(), [track](const auto& preAppended) {
+        return preAppended.first >= track && preAppended.first < track + VOICES;
+    }), _preAppendedItems.end());
+    for (auto& preAppended : _preAppendedItems) {
+        if (preAppended.first >= track) {
+            preAppended.first -= VOICES;
+        }
+    }
     _dotPosX.erase(_dotPosX.begin() + staff);
     _shapes.erase(_shapes.begin() + staff);
 
@@ -2253,13 +2264,19 @@ void Segment::createShape(staff_idx_t staffIdx)
         return;
     }
 
-    if (!score()->staff(staffIdx)->show()) {
+    const Staff* staff = score()->staff(staffIdx);
+    if (!staff->show()) {
         return;
     }
 
     track_idx_t strack = staffIdx * VOICES;
     track_idx_t etrack = strack + VOICES;
-    for (EngravingItem* e : _elist) {
+    //! NOTE Cross-staff elements can only be moved to the other staves of their part,
+    //! so only the tracks of the part need to be looked at, not those of the whole score
+    track_idx_t partStartTrack = (staffIdx - staff->rstaff()) * VOICES;
+    track_idx_t partEndTrack = std::min(partStartTrack + staff->part()->nstaves() * VOICES, _elist.size());
+    for (track_idx_t track = partStartTrack; track < partEndTrack; ++track) {
+        EngravingItem* e = _elist[track];
         if (!e) {
             continue;
         }
@@ -2312,13 +2329,66 @@ void Segment::createShape(staff_idx_t staffIdx)
     addPreAppendedToShape(static_cast<int>(staffIdx), s);
 }
 
+//---------------------------------------------------------
+//   preAppendedTrackLess
+//---------------------------------------------------------
+
+static bool preAppendedTrackLess(const std::pair<track_idx_t, EngravingItem*>& preAppended, track_idx_t track)
+{
+    return preAppended.first < track;
+}
+
+//---------------------------------------------------------
+//   preAppendedItem
+//---------------------------------------------------------
+
+EngravingItem* Segment::preAppendedItem(int track) const
+{
+    auto it = std::lower_bound(_preAppendedItems.cbegin(), _preAppendedItems.cend(), static_cast<track_idx_t>(track), preAppendedTrackLess);
+    if (it == _preAppendedItems.cend() || it->first != static_cast<track_idx_t>(track)) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+//---------------------------------------------------------
+//   preAppend
+//---------------------------------------------------------
+
+void Segment::preAppend(EngravingItem* item, int track)
+{
+    if (!item) {
+        clearPreAppended(track);
+        return;
+    }
+
+    auto it = std::lower_bound(_preAppendedItems.begin(), _preAppendedItems.end(), static_cast<track_idx_t>(track), preAppendedTrackLess);
+    if (it != _preAppendedItems.end() && it->first == static_cast<track_idx_t>(track)) {
+        it->second = item;
+    } else {
+        _preAppendedItems.insert(it, { static_cast<track_idx_t>(track), item });
+    }
+}
+
+//---------------------------------------------------------
+//   clearPreAppended
+//---------------------------------------------------------
+
+void Segment::clearPreAppended(int track)
+{
+    auto it = std::lower_bound(_preAppendedItems.begin(), _preAppendedItems.end(), static_cast<track_idx_t>(track), preAppendedTrackLess);
+    if (it != _preAppendedItems.end() && it->first == static_cast<track_idx_t>(track)) {
+        _preAppendedItems.erase(it);
+    }
+}
+
 void Segment::addPreAppendedToShape(int staffIdx, Shape& s)
 {
-    for (unsigned track = staffIdx * VOICES; track < staffIdx * VOICES + VOICES; ++track) {
-        if (!_preAppendedItems[track]) {
-            continue;
-        }
-        EngravingItem* item = _preAppendedItems[track];
+    track_idx_t strack = staffIdx * VOICES;
+    track_idx_t etrack = strack + VOICES;
+    auto it = std::lower_bound(_preAppendedItems.cbegin(), _preAppendedItems.cend(), strack, preAppendedTrackLess);
+    for (; it != _preAppendedItems.cend() && it->first < etrack; ++it) {
+        EngravingItem* item = it->second;
         item->layout();
         Shape itemShape = item->shape();
         double offset = -itemShape.minHorizontalDistance(s, score());
@@ -2327,6 +2397,25 @@ void Segment::addPreAppendedToShape(int staffIdx, Shape& s)
     }
 }
 
+//---------------------------------------------------------
+//   memoryUsage
+//    the segment and its own storage, the elements are not included
+//---------------------------------------------------------
+
+size_t Segment::memoryUsage() const
+{
+    size_t usage = sizeof(*this);
+    usage += _annotations.capacity() * sizeof(EngravingItem*);
+    usage += _elist.capacity() * sizeof(EngravingItem*);
+    usage += _preAppendedItems.capacity() * sizeof(std::pair<track_idx_t, EngravingItem*>);
+    usage += _dotPosX.capacity() * sizeof(double);
+    usage += _shapes.capacity() * sizeof(Shape);
+    for (const Shape& shape : _shapes) {
+        usage += shape.capacity() * sizeof(ShapeElement);
+    }
+    return usage;
+}
+
 //---------------------------------------------------------
 //   minRight
 //    calculate minimum distance needed to the right
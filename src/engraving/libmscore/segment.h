@@ -75,8 +75,12 @@ class Segment final : public EngravingItem
     Segment* _prev = nullptr;
 
     std::vector<EngravingItem*> _annotations;
+    //! NOTE Still dense, so the memory of a segment grows with the number of staves even if most of them are empty.
+    //! elist() hands out this track-indexed vector to ~40 call sites across engraving, layout and export,
+    //! so storing only the occupied tracks needs those call sites to move to element(track) and an iterator first.
+    //! Until then, the memory per segment is tracked by memoryUsage() and the segment memory benchmark
     std::vector<EngravingItem*> _elist;         // EngravingItem storage, size = staves * VOICES.
-    std::vector<EngravingItem*> _preAppendedItems; // Container for items appended to the left of this segment (example: grace notes), size = staves * VOICES.
+    std::vector<std::pair<track_idx_t, EngravingItem*> > _preAppendedItems; // Items appended to the left of this segment (example: grace notes), sorted by track, only the occupied tracks are stored
     std::vector<Shape> _shapes;           // size = staves
     std::vector<double> _dotPosX;          // size = staves
     double m_spacing{ 0 };
@@ -294,11 +298,13 @@ public:
     Fraction shortestChordRest() const;
     CrossStaffContent crossStaffContent() const;
 
-    EngravingItem* preAppendedItem(int track) { return _preAppendedItems[track]; }
-    void preAppend(EngravingItem* item, int track) { _preAppendedItems[track] = item; }
-    void clearPreAppended(int track) { _preAppendedItems[track] = nullptr; }
+    EngravingItem* preAppendedItem(int track) const;
+    void preAppend(EngravingItem* item, int track);
+    void clearPreAppended(int track);
     void addPreAppendedToShape(int staffIdx, Shape& s);
 
+    size_t memoryUsage() const;
+
     static constexpr SegmentType durationSegmentsMask = SegmentType::ChordRest;   // segment types which may have non-zero tick length
 };
 
@@ -63,6 +63,7 @@
 #include "text.h"
 #include "tremolo.h"
 #include "tuplet.h"
+#include "undo.h"
 #include "utils.h"
 #include "staff.h"
 #include "part.h"
@@ -441,6 +442,8 @@ void Selection::clear()
         }
     }
     _el.clear();
+    _rangeItems.clear();
+    _rangeItemsValid = false;
     _startSegment  = 0;
     _endSegment    = 0;
     _activeSegment = 0;
@@ -454,6 +457,7 @@ void Selection::remove(EngravingItem* el)
 {
     const bool removed = mu::remove(_el, el);
     el->setSelected(false);
+    _rangeItemsValid = false;
     if (removed) {
         updateState();
     }
@@ -466,6 +470,7 @@ void Selection::add(EngravingItem* el)
         return;
     }
     _el.push_back(el);
+    _rangeItemsValid = false;
     update();
 }
 
@@ -486,7 +491,7 @@ void Selection::appendChord(Chord* chord)
         LOGE() << "selection locked, reason: " << lockReason();
         return;
     }
-    if (chord->beam() && !mu::contains(_el, static_cast<EngravingItem*>(chord->beam()))) {
+    if (chord->beam() && _appendedBeams.insert(chord->beam()).second) {
         _el.push_back(chord->beam());
     }
     if (chord->stem()) {
@@ -576,6 +581,8 @@ void Selection::updateSelectedElements()
         e->setSelected(false);
     }
     _el.clear();
+    _rangeItems.clear();
+    _appendedBeams.clear();
 
     // assert:
     size_t staves = _score->nstaves();
@@ -593,79 +600,339 @@ void Selection::updateSelectedElements()
             continue;
         }
         for (Segment* s = _startSegment; s && (s != _endSegment); s = s->next1MM()) {
-            if (!s->enabled() || s->isEndBarLineType()) {      // do not select end bar line
+            appendSegmentElements(s, st);
+            _rangeItems.resize(_el.size(), { st, s->measure()->tick() });
+        }
+    }
+    Fraction stick = startSegment()->tick();
+    Fraction etick = tickEnd();
+
+    for (auto i = _score->spanner().begin(); i != _score->spanner().end(); ++i) {
+        Spanner* sp = (*i).second;
+        if (isRangeSpanner(sp, stick, etick)) {
+            appendFiltered(sp);
+        }
+    }
+    _rangeItems.resize(_el.size(), { mu::nidx, Fraction() });
+    _appendedBeams.clear();
+
+    _rangeBounds = currentRangeBounds();
+    _rangeItemsValid = true;
+
+    update();
+}
+
+//---------------------------------------------------------
+//   appendSegmentElements
+//    append the elements of the segment on the track
+//---------------------------------------------------------
+
+void Selection::appendSegmentElements(Segment* s, track_idx_t st)
+{
+    if (!s->enabled() || s->isEndBarLineType()) {      // do not select end bar line
+        return;
+    }
+    for (EngravingItem* e : s->annotations()) {
+        if (e->track() != st) {
+            continue;
+        }
+        appendFiltered(e);
+    }
+    EngravingItem* e = s->element(st);
+    if (!e || e->generated() || e->isTimeSig() || e->isKeySig()) {
+        return;
+    }
+    if (e->isChordRest()) {
+        ChordRest* cr = toChordRest(e);
+        for (EngravingItem* el : cr->lyrics()) {
+            if (el) {
+                appendFiltered(el);
+            }
+        }
+    }
+    if (e->isChord()) {
+        Chord* chord = toChord(e);
+        for (Chord* graceNote : chord->graceNotes()) {
+            if (canSelect(graceNote)) {
+                appendChord(graceNote);
+            }
+        }
+        appendChord(chord);
+        for (Articulation* art : chord->articulations()) {
+            appendFiltered(art);
+        }
+    } else {
+        appendFiltered(e);
+        if (e->isRest()) {
+            Rest* r = toRest(e);
+            for (int i = 0; i < r->dots(); ++i) {
+                appendFiltered(r->dot(i));
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   isRangeSpanner
+//    whether the spanner belongs to the range selection
+//    from stick to etick
+//---------------------------------------------------------
+
+bool Selection::isRangeSpanner(Spanner* sp, const Fraction& stick, const Fraction& etick) const
+{
+    // ignore spanners belonging to other tracks
+    if (sp->track() < _staffStart * VOICES || sp->track() >= _staffEnd * VOICES) {
+        return false;
+    }
+    if (!canSelectVoice(sp->track())) {
+        return false;
+    }
+    // ignore voltas
+    if (sp->isVolta()) {
+        return false;
+    }
+    if (sp->isSlur()) {
+        // ignore if start & end elements not calculated yet
+        if (!sp->startElement() || !sp->endElement()) {
+            return false;
+        }
+        if ((sp->tick() >= stick && sp->tick() < etick) || (sp->tick2() >= stick && sp->tick2() < etick)) {
+            return canSelect(sp->startCR()) && canSelect(sp->endCR());      // slur with start or end in range selection
+        }
+        return false;
+    }
+    return (sp->tick() >= stick && sp->tick() < etick) && (sp->tick2() >= stick && sp->tick2() <= etick);      // spanner with start and end in range selection
+}
+
+//---------------------------------------------------------
+//   currentRangeBounds
+//---------------------------------------------------------
+
+Selection::RangeBounds Selection::currentRangeBounds() const
+{
+    RangeBounds bounds;
+    bounds.startSegment = _startSegment;
+    bounds.endSegment = _endSegment;
+    bounds.tickStart = _startSegment ? _startSegment->tick() : Fraction(-1, 1);
+    bounds.tickEnd = _endSegment ? _endSegment->tick() : _score->endTick();
+    bounds.staffStart = _staffStart;
+    bounds.staffEnd = _staffEnd;
+    bounds.staves = _score->nstaves();
+    bounds.filteredTypes = selectionFilter().filteredTypes();
+    return bounds;
+}
+
+//---------------------------------------------------------
+//   rangeBoundsChanged
+//---------------------------------------------------------
+
+bool Selection::rangeBoundsChanged() const
+{
+    const RangeBounds bounds = currentRangeBounds();
+    return bounds.startSegment != _rangeBounds.startSegment
+           || bounds.endSegment != _rangeBounds.endSegment
+           || bounds.tickStart != _rangeBounds.tickStart
+           || bounds.tickEnd != _rangeBounds.tickEnd
+           || bounds.staffStart != _rangeBounds.staffStart
+           || bounds.staffEnd != _rangeBounds.staffEnd
+           || bounds.staves != _rangeBounds.staves
+           || bounds.filteredTypes != _rangeBounds.filteredTypes;
+}
+
+//---------------------------------------------------------
+//   updateChangedSelectedElements
+//    Refresh the elements of a range selection at the end
+//    of a command. Only the measures touched by the command
+//    (its changed objects and its layout range) are scanned
+//    again, as well as the spanners overlapping them and the
+//    changed spanners; the elements of the other measures are
+//    kept from the previous scan.
+//    Falls back to the full rescan of updateSelectedElements()
+//    if the selection bounds have changed or the changes of
+//    the command can not be located.
+//---------------------------------------------------------
+
+void Selection::updateChangedSelectedElements()
+{
+    IF_ASSERT_FAILED(!isLocked()) {
+        LOGE() << "selection locked, reason: " << lockReason();
+        return;
+    }
+
+    if (_state != SelState::RANGE || !_rangeItemsValid || _rangeItems.size() != _el.size()
+        || _plannedTick1 != Fraction(-1, 1) || _plannedTick2 != Fraction(-1, 1)
+        || !_startSegment || rangeBoundsChanged() || _score->styleB(Sid::createMultiMeasureRests)) {
+        updateSelectedElements();
+        return;
+    }
+
+    const UndoMacro* macro = _score->undoStack()->current();
+    if (!macro) {
+        updateSelectedElements();
+        return;
+    }
+
+    const CmdState& cmdState = _score->cmdState();
+    Fraction tick1 = Fraction(-1, 1);
+    Fraction tick2 = Fraction(-1, 1);
+    if (cmdState.startTick() >= Fraction(0, 1) && cmdState.endTick() >= Fraction(0, 1)) {
+        tick1 = cmdState.startTick();
+        tick2 = cmdState.endTick();
+    } else if (cmdState.layoutRange()) {
+        updateSelectedElements();
+        return;
+    }
+
+    if (macro->empty()) {
+        //! NOTE A rolled back command leaves an empty macro, but the score may have been laid out again
+        if (cmdState.layoutRange() || cmdState.updateAll()) {
+            updateSelectedElements();
+        }
+        return;
+    }
+
+    std::unordered_set<Spanner*> changedSpanners;
+    for (const UndoCommand* cmd : macro->commands()) {
+        const std::vector<const EngravingObject*> objects = cmd->objectItems();
+        if (objects.empty() || cmd->childCount() > 0) {
+            updateSelectedElements();
+            return;
+        }
+        for (const EngravingObject* object : objects) {
+            if (!object) {
                 continue;
             }
-            for (EngravingItem* e : s->annotations()) {
-                if (e->track() != st) {
-                    continue;
-                }
-                appendFiltered(e);
+            //! NOTE The changes of measures, systems, staves, parts or the score itself may move the segments
+            if (!object->isEngravingItem() || object->isMeasureBase() || object->isSystem() || object->isPage()) {
+                updateSelectedElements();
+                return;
             }
-            EngravingItem* e = s->element(st);
-            if (!e || e->generated() || e->isTimeSig() || e->isKeySig()) {
+            const EngravingItem* item = static_cast<const EngravingItem*>(object);
+            if (item->score() != _score) {
                 continue;
             }
-            if (e->isChordRest()) {
-                ChordRest* cr = toChordRest(e);
-                for (EngravingItem* el : cr->lyrics()) {
-                    if (el) {
-                        appendFiltered(el);
-                    }
-                }
+            const Fraction tick = item->tick();
+            if (tick < Fraction(0, 1)) {
+                updateSelectedElements();
+                return;
             }
-            if (e->isChord()) {
-                Chord* chord = toChord(e);
-                for (Chord* graceNote : chord->graceNotes()) {
-                    if (canSelect(graceNote)) {
-                        appendChord(graceNote);
-                    }
-                }
-                appendChord(chord);
-                for (Articulation* art : chord->articulations()) {
-                    appendFiltered(art);
-                }
-            } else {
-                appendFiltered(e);
-                if (e->isRest()) {
-                    Rest* r = toRest(e);
-                    for (int i = 0; i < r->dots(); ++i) {
-                        appendFiltered(r->dot(i));
-                    }
-                }
+            if (item->isSpanner()) {
+                changedSpanners.insert(toSpanner(const_cast<EngravingItem*>(item)));
+            }
+            if (tick1 < Fraction(0, 1) || tick < tick1) {
+                tick1 = tick;
+            }
+            if (tick2 < Fraction(0, 1) || tick > tick2) {
+                tick2 = tick;
             }
         }
     }
-    Fraction stick = startSegment()->tick();
-    Fraction etick = tickEnd();
 
-    for (auto i = _score->spanner().begin(); i != _score->spanner().end(); ++i) {
-        Spanner* sp = (*i).second;
-        // ignore spanners belonging to other tracks
-        if (sp->track() < startTrack || sp->track() >= endTrack) {
-            continue;
+    if (tick1 < Fraction(0, 1)) {
+        return;
+    }
+
+    // extend the changed ticks to whole measures
+    const Measure* m1 = _score->tick2measure(tick1);
+    const Measure* m2 = tick2 >= _score->endTick() ? _score->lastMeasure() : _score->tick2measure(tick2);
+    if (!m1 || !m2) {
+        updateSelectedElements();
+        return;
+    }
+    const Fraction measureTick1 = m1->tick();
+    const Fraction measureTick2 = m2->endTick();
+
+    std::vector<EngravingItem*> oldEl;
+    std::vector<RangeItem> oldItems;
+    std::swap(oldEl, _el);
+    std::swap(oldItems, _rangeItems);
+    _el.reserve(oldEl.size());
+    _rangeItems.reserve(oldItems.size());
+
+    std::vector<EngravingItem*> dropped;
+    auto keep = [this, &oldEl, &oldItems](size_t i) {
+        EngravingItem* e = oldEl[i];
+        if (e->isBeam()) {
+            _appendedBeams.insert(e);
         }
-        if (!canSelectVoice(sp->track())) {
+        _el.push_back(e);
+        _rangeItems.push_back(oldItems[i]);
+    };
+
+    // the first segment of the changed measures inside the selection, if any
+    Segment* rescanStart = nullptr;
+    if (_startSegment->measure()->tick() >= measureTick1) {
+        rescanStart = _startSegment;
+    } else if (!_endSegment || measureTick1 <= _endSegment->tick()) {
+        rescanStart = _score->tick2measure(measureTick1)->first();
+    }
+
+    const track_idx_t startTrack = _staffStart * VOICES;
+    const track_idx_t endTrack = _staffEnd * VOICES;
+    size_t i = 0;
+    for (track_idx_t st = startTrack; st < endTrack; ++st) {
+        if (!canSelectVoice(st)) {
             continue;
         }
-        // ignore voltas
-        if (sp->isVolta()) {
-            continue;
+        for (; i < oldEl.size() && oldItems[i].track == st && oldItems[i].measureTick < measureTick1; ++i) {
+            keep(i);
+        }
+        for (; i < oldEl.size() && oldItems[i].track == st && oldItems[i].measureTick < measureTick2; ++i) {
+            dropped.push_back(oldEl[i]);
+        }
+        for (Segment* s = rescanStart; s && (s != _endSegment) && s->measure()->tick() < measureTick2; s = s->next1MM()) {
+            appendSegmentElements(s, st);
+            _rangeItems.resize(_el.size(), { st, s->measure()->tick() });
         }
-        if (sp->isSlur()) {
-            // ignore if start & end elements not calculated yet
-            if (!sp->startElement() || !sp->endElement()) {
+        for (; i < oldEl.size() && oldItems[i].track == st; ++i) {
+            keep(i);
+        }
+    }
+
+    // spanners
+    const Fraction stick = _startSegment->tick();
+    const Fraction etick = tickEnd();
+    for (; i < oldEl.size(); ++i) {
+        EngravingItem* e = oldEl[i];
+        if (oldItems[i].track == mu::nidx && e->isSpanner() && !mu::contains(changedSpanners, toSpanner(e))) {
+            Spanner* sp = toSpanner(e);
+            if (sp->tick() >= measureTick2 || sp->tick2() < measureTick1) {
+                keep(i);
                 continue;
             }
-            if ((sp->tick() >= stick && sp->tick() < etick) || (sp->tick2() >= stick && sp->tick2() < etick)) {
-                if (canSelect(sp->startCR()) && canSelect(sp->endCR())) {
-                    appendFiltered(sp);               // slur with start or end in range selection
-                }
+        }
+        dropped.push_back(e);
+    }
+
+    std::vector<Spanner*> spanners;
+    for (const auto& interval : _score->spannerMap().findOverlapping(measureTick1.ticks(), measureTick2.ticks() - 1)) {
+        spanners.push_back(interval.value);
+    }
+    for (Spanner* sp : changedSpanners) {
+        //! NOTE The changed spanners may have been removed from the score
+        auto range = _score->spanner().equal_range(sp->tick().ticks());
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == sp) {
+                spanners.push_back(sp);
+                break;
             }
-        } else if ((sp->tick() >= stick && sp->tick() < etick) && (sp->tick2() >= stick && sp->tick2() <= etick)) {
-            appendFiltered(sp);       // spanner with start and end in range selection
         }
     }
+    std::unordered_set<Spanner*> appendedSpanners;
+    for (Spanner* sp : spanners) {
+        if (appendedSpanners.insert(sp).second && isRangeSpanner(sp, stick, etick)) {
+            appendFiltered(sp);
+        }
+    }
+    _rangeItems.resize(_el.size(), { mu::nidx, Fraction() });
+    _appendedBeams.clear();
+
+    for (EngravingItem* e : dropped) {
+        e->setSelected(false);
+    }
+
+    ++_incrementalUpdatesCount;
+
     update();
 }
 
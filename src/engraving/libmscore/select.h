@@ -23,6 +23,8 @@
 #ifndef __SELECT_H__
 #define __SELECT_H__
 
+#include <unordered_set>
+
 #include "pitchspelling.h"
 #include "mscore.h"
 #include "durationtype.h"
@@ -37,6 +39,7 @@ class Segment;
 class Note;
 class Measure;
 class Chord;
+class Spanner;
 
 //---------------------------------------------------------
 //   ElementPattern
@@ -173,6 +176,32 @@ class Selection
 
     String _lockReason;
 
+    //! NOTE For a range selection, the track and the measure of each of the selected elements
+    //! (mu::nidx track for spanners), in the same order as _el. They are filled by the full rescan
+    //! and let updateChangedSelectedElements() keep the elements of the measures that a command did not touch.
+    struct RangeItem {
+        track_idx_t track = mu::nidx;
+        Fraction measureTick;
+    };
+    std::vector<RangeItem> _rangeItems;
+    bool _rangeItemsValid = false;
+
+    //! NOTE The bounds of the range selection at the moment of the last full rescan
+    struct RangeBounds {
+        Segment* startSegment = nullptr;
+        Segment* endSegment = nullptr;
+        Fraction tickStart;
+        Fraction tickEnd;
+        staff_idx_t staffStart = 0;
+        staff_idx_t staffEnd = 0;
+        size_t staves = 0;
+        int filteredTypes = 0;
+    };
+    RangeBounds _rangeBounds;
+    size_t _incrementalUpdatesCount = 0;
+
+    std::unordered_set<const EngravingItem*> _appendedBeams;   // used while scanning the range
+
     mu::ByteArray staffMimeData() const;
     mu::ByteArray symbolListMimeData() const;
     SelectionFilter selectionFilter() const;
@@ -180,6 +209,10 @@ class Selection
     bool canSelectVoice(track_idx_t track) const { return selectionFilter().canSelectVoice(track); }
     void appendFiltered(EngravingItem* e);
     void appendChord(Chord* chord);
+    void appendSegmentElements(Segment* s, track_idx_t track);
+    bool isRangeSpanner(Spanner* sp, const Fraction& stick, const Fraction& etick) const;
+    RangeBounds currentRangeBounds() const;
+    bool rangeBoundsChanged() const;
 
 public:
     Selection() { _score = 0; _state = SelState::NONE; }
@@ -244,6 +277,9 @@ public:
     void setActiveTrack(track_idx_t v) { _activeTrack = v; }
     bool canCopy() const;
     void updateSelectedElements();
+    void updateChangedSelectedElements();
+    //! NOTE The number of the refreshes that kept the elements of the unchanged measures, for the tests
+    size_t incrementalUpdatesCount() const { return _incrementalUpdatesCount; }
     bool measureRange(Measure** m1, Measure** m2) const;
     void extendRangeSelection(ChordRest* cr);
     void extendRangeSelection(Segment* seg, Segment* segAfter, staff_idx_t staffIdx, const Fraction& tick, const Fraction& etick);
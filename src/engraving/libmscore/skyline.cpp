@@ -21,6 +21,10 @@
  */
 
 #include "skyline.h"
+
+#include <algorithm>
+#include <limits>
+
 #include "segment.h"
 
 #include "infrastructure/draw/painter.h"
@@ -121,6 +125,13 @@ void Skyline::add(const Shape& s)
     }
 }
 
+void Skyline::add(const Shape& s, const PointF& pos)
+{
+    for (const auto& r : s) {
+        add(r.translated(pos));
+    }
+}
+
 void SkylineLine::add(double x, double y, double w)
 {
 //      assert(w >= 0.0);
@@ -205,6 +216,154 @@ void SkylineLine::add(double x, double y, double w)
     }
 }
 
+//---------------------------------------------------------
+//   SkylineSpan
+//---------------------------------------------------------
+
+struct SkylineSpan {
+    double x;
+    double xr;
+    double top;
+    double bottom;
+};
+
+static std::vector<SkylineSpan> sortedSpans(const std::vector<RectF>& rects)
+{
+    std::vector<SkylineSpan> spans;
+    spans.reserve(rects.size());
+    for (const RectF& r : rects) {
+        double x = r.x();
+        double w = r.width();
+        if (x < 0.0) {
+            w -= -x;
+            x = 0.0;
+            if (w <= 0.0) {
+                continue;
+            }
+        }
+        //! NOTE Zero width rectangles are kept, they split the line as they do in add()
+        if (w >= 0.0) {
+            spans.push_back({ x, x + w, r.top(), r.bottom() });
+        }
+    }
+    std::sort(spans.begin(), spans.end(), [](const SkylineSpan& a, const SkylineSpan& b) { return a.x < b.x; });
+    return spans;
+}
+
+//---------------------------------------------------------
+//   build
+//    Replaces the skyline by the outline of all the rectangles,
+//    computed in one sort and sweep pass instead of adding
+//    the rectangles one by one.
+//---------------------------------------------------------
+
+void Skyline::build(const std::vector<RectF>& rects)
+{
+    const std::vector<SkylineSpan> spans = sortedSpans(rects);
+    _north.sweep(spans);
+    _south.sweep(spans);
+}
+
+void SkylineLine::build(const std::vector<RectF>& rects)
+{
+    sweep(sortedSpans(rects));
+}
+
+//---------------------------------------------------------
+//   sweep
+//    spans are sorted by x. Only the start of a span and the
+//    end of the outermost span can change the outline.
+//---------------------------------------------------------
+
+void SkylineLine::sweep(const std::vector<SkylineSpan>& spans)
+{
+    seg.clear();
+    if (spans.empty()) {
+        return;
+    }
+
+    //! NOTE The depth grows away from the outline on both lines, the outermost span has the smallest depth
+    const double sign = north ? 1.0 : -1.0;
+    const double emptyDepth = MAXIMUM_Y;
+
+    struct ActiveSpan {
+        double depth;
+        double xr;
+    };
+
+    // The started spans that may still show in the outline, the outermost one first.
+    // A span that is deeper and ends earlier than another one never shows, so both
+    // the depth and the end grow along this list and it stays short.
+    std::vector<ActiveSpan> active;
+    size_t front = 0;
+
+    auto emit = [this, sign](double x, double depth, double w) {
+        const double y = sign * depth;
+        if (!seg.empty() && w > 0.0 && seg.back().w > 0.0 && seg.back().y == y) {
+            seg.back().w = x + w - seg.back().x;
+        } else {
+            seg.emplace_back(x, y, w);
+        }
+    };
+
+    auto next = spans.cbegin();
+    double x = next->x;
+    if (x > 0.0) {
+        emit(0.0, emptyDepth, x);
+    }
+
+    for (;;) {
+        while (front < active.size() && active[front].xr <= x) {
+            ++front;
+        }
+        if (front == active.size()) {
+            active.clear();
+            front = 0;
+        }
+
+        double pointDepth = emptyDepth;
+        for (; next != spans.cend() && next->x <= x; ++next) {
+            const double depth = sign * (north ? next->top : next->bottom);
+            if (next->xr == next->x) {
+                pointDepth = std::min(pointDepth, depth);
+                continue;
+            }
+            auto first = std::lower_bound(active.begin() + front, active.end(), depth,
+                                          [](const ActiveSpan& s, double d) { return s.depth < d; });
+            if (first != active.begin() + front && (first - 1)->xr >= next->xr) {
+                continue;
+            }
+            if (first != active.end() && first->depth == depth && first->xr >= next->xr) {
+                continue;
+            }
+            auto last = first;
+            while (last != active.end() && last->xr <= next->xr) {
+                ++last;
+            }
+            first = active.erase(first, last);
+            active.insert(first, { depth, next->xr });
+        }
+
+        const double depth = front < active.size() ? active[front].depth : emptyDepth;
+        if (pointDepth < depth) {
+            emit(x, pointDepth, 0.0);
+        }
+
+        double nx = std::numeric_limits<double>::max();
+        if (next != spans.cend()) {
+            nx = next->x;
+        }
+        if (front < active.size()) {
+            nx = std::min(nx, active[front].xr);
+        }
+        if (nx == std::numeric_limits<double>::max()) {
+            break;
+        }
+        emit(x, depth, nx - x);
+        x = nx;
+    }
+}
+
 //---------------------------------------------------------
 //   clear
 //---------------------------------------------------------
@@ -34,6 +34,7 @@ class Painter;
 namespace mu::engraving {
 class Segment;
 class Shape;
+struct SkylineSpan;
 
 //---------------------------------------------------------
 //   SkylineSegment
@@ -63,6 +64,9 @@ class SkylineLine
     void append(double x, double y, double w);
     SegIter find(double x);
     SegConstIter find(double x) const;
+    void sweep(const std::vector<SkylineSpan>& spans);
+
+    friend class Skyline;
 
 public:
     SkylineLine(bool n)
@@ -70,6 +74,7 @@ public:
     void add(const Shape& s);
     void add(const mu::RectF& r);
     void add(double x, double y, double w);
+    void build(const std::vector<mu::RectF>& rects);
     void clear() { seg.clear(); }
     void paint(mu::draw::Painter& painter) const;
     void dump() const;
@@ -100,7 +105,9 @@ public:
 
     void clear();
     void add(const Shape& s);
+    void add(const Shape& s, const mu::PointF& pos); // adds the shape moved by pos, without a translated copy
     void add(const mu::RectF& r);
+    void build(const std::vector<mu::RectF>& rects);
 
     double minDistance(const Skyline&) const;
 
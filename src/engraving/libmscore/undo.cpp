@@ -152,6 +152,20 @@ UndoCommand::~UndoCommand()
     }
 }
 
+//---------------------------------------------------------
+//   UndoCommand::memoryUsage
+//---------------------------------------------------------
+
+size_t UndoCommand::memoryUsage() const
+{
+    // every child is also a node of std::list: two links and the pointer
+    size_t usage = instanceSize() + ownedMemoryUsage() + childList.size() * 3 * sizeof(void*);
+    for (const UndoCommand* c : childList) {
+        usage += c->memoryUsage();
+    }
+    return usage;
+}
+
 //---------------------------------------------------------
 //   UndoCommand::cleanup
 //---------------------------------------------------------
@@ -381,6 +395,9 @@ void UndoStack::remove(size_t idx)
 
 void UndoStack::mergeCommands(size_t startIdx)
 {
+    // startIdx comes from getCurIdx()
+    startIdx = startIdx > m_droppedCount ? startIdx - m_droppedCount : 0;
+
     assert(startIdx <= curIdx);
 
     if (startIdx >= list.size()) {
@@ -393,6 +410,7 @@ void UndoStack::mergeCommands(size_t startIdx)
         startMacro->append(std::move(*list[idx]));
     }
     remove(startIdx + 1);   // TODO: remove from startIdx to curIdx only
+    startMacro->updateMemoryUsage();
 }
 
 //---------------------------------------------------------
@@ -445,11 +463,102 @@ void UndoStack::endMacro(bool rollback)
             cmd->cleanup(false);        // delete elements for which UndoCommand() holds ownership
             delete cmd;
         }
+        curCmd->updateMemoryUsage();
         list.push_back(curCmd);
         stateList.push_back(nextState++);
         ++curIdx;
     }
     curCmd = 0;
+
+    trimToMemoryBudget();
+}
+
+//---------------------------------------------------------
+//   setMemoryBudget
+//---------------------------------------------------------
+
+void UndoStack::setMemoryBudget(size_t bytes)
+{
+    m_memoryBudget = bytes;
+    if (!active()) {
+        trimToMemoryBudget();
+    }
+}
+
+//---------------------------------------------------------
+//   memoryUsage
+//---------------------------------------------------------
+
+size_t UndoStack::memoryUsage() const
+{
+    size_t usage = 0;
+    for (const UndoMacro* macro : list) {
+        usage += macro->cachedMemoryUsage();
+    }
+    return usage;
+}
+
+//---------------------------------------------------------
+//   macrosMemoryUsage
+//---------------------------------------------------------
+
+std::vector<size_t> UndoStack::macrosMemoryUsage() const
+{
+    std::vector<size_t> usages;
+    usages.reserve(list.size());
+    for (const UndoMacro* macro : list) {
+        usages.push_back(macro->cachedMemoryUsage());
+    }
+    return usages;
+}
+
+//---------------------------------------------------------
+//   trimToMemoryBudget
+//    Merging the oldest macros would not free anything and the commands
+//    hold raw pointers to the score, so they can't be written to disk;
+//    they are dropped like QUndoStack does with its undo limit
+//---------------------------------------------------------
+
+void UndoStack::trimToMemoryBudget()
+{
+    if (m_memoryBudget == 0) {
+        return;
+    }
+
+    size_t usage = memoryUsage();
+
+    // the oldest macros go first; list[curIdx - 1] is always kept,
+    // so that the last action can be undone
+    while (usage > m_memoryBudget && curIdx > 1) {
+        UndoMacro* macro = list.front();
+        usage -= macro->cachedMemoryUsage();
+
+        LOGD() << "drop undo macro, commands: " << macro->childCount() << ", memory: " << macro->cachedMemoryUsage()
+               << ", history memory: " << usage << ", budget: " << m_memoryBudget;
+
+        list.erase(list.begin());
+        stateList.erase(stateList.begin());
+        --curIdx;
+        ++m_droppedCount;
+
+        macro->cleanup(true);
+        delete macro;
+    }
+
+    // then the redo macros, the newest first; they are above curIdx
+    // and nothing below them depends on them
+    while (usage > m_memoryBudget && list.size() > curIdx) {
+        UndoMacro* macro = mu::takeLast(list);
+        usage -= macro->cachedMemoryUsage();
+
+        LOGD() << "drop redo macro, commands: " << macro->childCount() << ", memory: " << macro->cachedMemoryUsage()
+               << ", history memory: " << usage << ", budget: " << m_memoryBudget;
+
+        stateList.pop_back();
+
+        macro->cleanup(false);
+        delete macro;
+    }
 }
 
 //---------------------------------------------------------
@@ -469,6 +578,36 @@ void UndoStack::reopen()
     }
 }
 
+//---------------------------------------------------------
+//   beginAppendingToLast
+//---------------------------------------------------------
+
+bool UndoStack::beginAppendingToLast(const UndoMacro* macro)
+{
+    if (curCmd || curIdx == 0 || canRedo() || list[curIdx - 1] != macro) {
+        return false;
+    }
+
+    curCmd = list[curIdx - 1];
+    return true;
+}
+
+//---------------------------------------------------------
+//   endAppendingToLast
+//---------------------------------------------------------
+
+void UndoStack::endAppendingToLast()
+{
+    IF_ASSERT_FAILED(curCmd && curCmd == last()) {
+        return;
+    }
+
+    curCmd->updateMemoryUsage();
+    curCmd = 0;
+
+    trimToMemoryBudget();
+}
+
 //---------------------------------------------------------
 //   setClean
 //---------------------------------------------------------
@@ -940,6 +1079,26 @@ RemoveElement::RemoveElement(EngravingItem* e)
     }
 }
 
+//---------------------------------------------------------
+//   RemoveElement::ownedMemoryUsage
+//    The exact type of the items is unknown here,
+//    every item of the removed tree is counted as an EngravingItem
+//---------------------------------------------------------
+
+static size_t estimatedTreeMemoryUsage(const EngravingObject* obj)
+{
+    size_t usage = sizeof(EngravingItem);
+    for (const EngravingObject* child : obj->children()) {
+        usage += estimatedTreeMemoryUsage(child);
+    }
+    return usage;
+}
+
+size_t RemoveElement::ownedMemoryUsage() const
+{
+    return element ? estimatedTreeMemoryUsage(element) : 0;
+}
+
 //---------------------------------------------------------
 //   RemoveElement::cleanup
 //---------------------------------------------------------
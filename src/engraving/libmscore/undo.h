@@ -103,7 +103,8 @@ enum class PlayEventType : char;
 class Excerpt;
 class EditData;
 
-#define UNDO_NAME(a) const char* name() const override { return a; }
+#define UNDO_NAME(a) const char* name() const override { return a; } \
+    size_t instanceSize() const override { return sizeof(*this); }
 #define UNDO_CHANGED_OBJECTS(...) std::vector<const EngravingObject*> objectItems() const override { return __VA_ARGS__; }
 
 //---------------------------------------------------------
@@ -143,6 +144,11 @@ public:
     virtual const char* name() const { return "UndoCommand"; }
 // #endif
 
+    //! NOTE Estimated memory used by the command, its children and the objects it owns
+    size_t memoryUsage() const;
+    virtual size_t instanceSize() const { return sizeof(UndoCommand); }
+    virtual size_t ownedMemoryUsage() const { return 0; }
+
     virtual bool isFiltered(Filter, const EngravingItem* /* target */) const { return false; }
     bool hasFilteredChildren(Filter, const EngravingItem* target) const;
     bool hasUnfilteredChildren(const std::vector<Filter>& filters, const EngravingItem* target) const;
@@ -183,9 +189,15 @@ public:
 
     static bool canRecordSelectedElement(const EngravingItem* e);
 
+    //! NOTE memoryUsage() walks all the children, the stack keeps the value from the last update
+    size_t cachedMemoryUsage() const { return m_memoryUsage; }
+    void updateMemoryUsage() { m_memoryUsage = memoryUsage(); }
+
     UNDO_NAME("UndoMacro");
 
 private:
+    size_t m_memoryUsage = 0;
+
     InputState m_undoInputState;
     InputState m_redoInputState;
     SelectionInfo m_undoSelectionInfo;
@@ -210,7 +222,11 @@ class UndoStack
     int cleanState;
     size_t curIdx = 0;
 
+    size_t m_memoryBudget = 0;
+    size_t m_droppedCount = 0;
+
     void remove(size_t idx);
+    void trimToMemoryBudget();
 
 public:
     UndoStack();
@@ -227,7 +243,8 @@ public:
     bool canRedo() const { return curIdx < list.size(); }
     int state() const { return stateList[curIdx]; }
     bool isClean() const { return cleanState == state(); }
-    size_t getCurIdx() const { return curIdx; }
+    //! NOTE Counts the macros dropped from the history too, so it stays valid for mergeCommands() after a trim
+    size_t getCurIdx() const { return curIdx + m_droppedCount; }
     bool empty() const { return !canUndo() && !canRedo(); }
     UndoMacro* current() const { return curCmd; }
     UndoMacro* last() const { return curIdx > 0 ? list[curIdx - 1] : 0; }
@@ -237,8 +254,23 @@ public:
     void rollback();
     void reopen();
 
+    //! NOTE Records the following changes into the given macro without a new undo state (so a clean score stays clean),
+    //! e.g. the changes of a deferred layout, so that they are undone together with the edit that caused them.
+    //! Returns false if a macro is active or the given one isn't the last one with nothing to redo after it
+    bool beginAppendingToLast(const UndoMacro* macro);
+    void endAppendingToLast();
+
     void mergeCommands(size_t startIdx);
     void cleanRedoStack() { remove(curIdx); }
+
+    //! NOTE When the history uses more than the budget (in bytes, 0 - unlimited),
+    //! the oldest macros are dropped and can't be undone anymore, then the redo macros;
+    //! the macro of the last action is always kept
+    void setMemoryBudget(size_t bytes);
+    size_t memoryBudget() const { return m_memoryBudget; }
+    size_t memoryUsage() const;
+    std::vector<size_t> macrosMemoryUsage() const;
+    size_t droppedCount() const { return m_droppedCount; }
 };
 
 //---------------------------------------------------------
@@ -651,6 +683,8 @@ public:
 
     bool isFiltered(UndoCommand::Filter f, const EngravingItem* target) const override;
 
+    size_t instanceSize() const override { return sizeof(*this); }
+
     UNDO_CHANGED_OBJECTS({ element });
 };
 
@@ -671,6 +705,9 @@ public:
 
     bool isFiltered(UndoCommand::Filter f, const EngravingItem* target) const override;
 
+    size_t instanceSize() const override { return sizeof(*this); }
+    size_t ownedMemoryUsage() const override;
+
     UNDO_CHANGED_OBJECTS({ element });
 };
 
@@ -34,6 +34,8 @@
 
 #include "utils/pitchutils.h"
 
+#include "tracer.h"
+
 using namespace mu;
 using namespace mu::engraving;
 using namespace mu::mpe;
@@ -45,6 +47,8 @@ const InstrumentTrackId PlaybackModel::METRONOME_TRACK_ID = { 999, METRONOME_INS
 
 void PlaybackModel::load(Score* score)
 {
+    TRACE_SCOPE("playback", "PlaybackModel::load");
+
     if (!score || score->measures()->empty() || !score->lastMeasure()) {
         return;
     }
@@ -64,8 +68,9 @@ void PlaybackModel::load(Score* score)
 
         InstrumentTrackIdSet existingTracks = existingTrackIdSet();
         ChangedTrackIdSet trackChanges;
-        update(tickRange.tickFrom, tickRange.tickTo, trackRange.trackFrom, trackRange.trackTo, &trackChanges);
-        notifyAboutChanges(std::move(trackChanges), std::move(existingTracks));
+        TimestampBoundaries changedTimestamps = timestampBoundaries(tickRange);
+        update(tickRange.tickFrom, tickRange.tickTo, trackRange.trackFrom, trackRange.trackTo, &trackChanges, &changedTimestamps);
+        notifyAboutChanges(std::move(trackChanges), std::move(existingTracks), changedTimestamps);
     });
 
     update(0, m_score->lastMeasure()->endTick().ticks(), 0, m_score->ntracks());
@@ -79,6 +84,8 @@ void PlaybackModel::load(Score* score)
 
 void PlaybackModel::reload()
 {
+    TRACE_SCOPE("playback", "PlaybackModel::reload");
+
     int trackFrom = 0;
     size_t trackTo = m_score->ntracks();
 
@@ -95,7 +102,8 @@ void PlaybackModel::reload()
     update(tickFrom, tickTo, trackFrom, trackTo);
 
     for (auto& pair : m_playbackDataMap) {
-        pair.second.mainStream.send(pair.second.originEvents);
+        pair.second.mainStream.send(PlaybackEventsChunk(pair.second.originEvents, PlaybackEventsChunk::MIN_TIMESTAMP,
+                                                        PlaybackEventsChunk::MAX_TIMESTAMP));
     }
 
     m_dataChanged.notify();
@@ -148,6 +156,8 @@ const PlaybackData& PlaybackModel::resolveTrackPlaybackData(const ID& partId, co
 
 void PlaybackModel::triggerEventsForItem(const EngravingItem* item)
 {
+    TRACE_SCOPE("playback", "PlaybackModel::triggerEventsForItem");
+
     IF_ASSERT_FAILED(item) {
         return;
     }
@@ -179,7 +189,7 @@ void PlaybackModel::triggerEventsForItem(const EngravingItem* item)
     PlaybackEventsMap result;
     m_renderer.render(item, actualTimestamp, actualDuration, actualDynamicLevel, ctx.persistentArticulationType(utick), profile, result);
 
-    trackPlaybackData->second.offStream.send(std::move(result));
+    trackPlaybackData->second.offStream.send(PlaybackEventsChunk(std::move(result)));
 }
 
 async::Channel<InstrumentTrackId> PlaybackModel::trackAdded() const
@@ -193,11 +203,13 @@ async::Channel<InstrumentTrackId> PlaybackModel::trackRemoved() const
 }
 
 void PlaybackModel::update(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
-                           ChangedTrackIdSet* trackChanges)
+                           ChangedTrackIdSet* trackChanges, TimestampBoundaries* changedTimestamps)
 {
+    TRACE_SCOPE("playback", "PlaybackModel::update");
+
     updateSetupData();
     updateContext(trackFrom, trackTo);
-    updateEvents(tickFrom, tickTo, trackFrom, trackTo, trackChanges);
+    updateEvents(tickFrom, tickTo, trackFrom, trackTo, trackChanges, changedTimestamps);
 }
 
 void PlaybackModel::updateSetupData()
@@ -235,7 +247,7 @@ void PlaybackModel::updateContext(const track_idx_t trackFrom, const track_idx_t
 }
 
 void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
-                                 ChangedTrackIdSet* trackChanges)
+                                 ChangedTrackIdSet* trackChanges, TimestampBoundaries* changedTimestamps)
 {
     std::set<ID> changedPartIdSet = m_score->partIdsFromRange(trackFrom, trackTo);
 
@@ -303,6 +315,7 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
                 m_renderer.renderMetronome(m_score, segmentStartTick, segment->ticks().ticks(),
                                            tickPositionOffset, m_playbackDataMap[METRONOME_TRACK_ID].originEvents);
                 collectChangesTracks(METRONOME_TRACK_ID, trackChanges);
+                collectChangedTimestamps(segmentStartTick + tickPositionOffset, segmentEndTick + tickPositionOffset, changedTimestamps);
             }
         }
     }
@@ -416,7 +429,18 @@ void PlaybackModel::collectChangesTracks(const InstrumentTrackId& trackId, Chang
     result->insert(trackId);
 }
 
-void PlaybackModel::notifyAboutChanges(ChangedTrackIdSet&& trackChanges, InstrumentTrackIdSet&& existingTracks)
+void PlaybackModel::collectChangedTimestamps(const int utickFrom, const int utickTo, TimestampBoundaries* result)
+{
+    if (!result) {
+        return;
+    }
+
+    result->from = std::min(result->from, timestampFromTicks(m_score, utickFrom));
+    result->to = std::max(result->to, timestampFromTicks(m_score, utickTo));
+}
+
+void PlaybackModel::notifyAboutChanges(ChangedTrackIdSet&& trackChanges, InstrumentTrackIdSet&& existingTracks,
+                                       const TimestampBoundaries& changedTimestamps)
 {
     for (const InstrumentTrackId& trackId : trackChanges) {
         auto search = m_playbackDataMap.find(trackId);
@@ -425,7 +449,8 @@ void PlaybackModel::notifyAboutChanges(ChangedTrackIdSet&& trackChanges, Instrum
             continue;
         }
 
-        search->second.mainStream.send(search->second.originEvents);
+        //!Note Only the changed range of events is being sent, the receivers are splicing it into the events they already have
+        search->second.mainStream.send(PlaybackEventsChunk(search->second.originEvents, changedTimestamps.from, changedTimestamps.to));
         search->second.dynamicLevelChanges.send(search->second.dynamicLevelMap);
 
         if (existingTracks.find(trackId) == existingTracks.cend()) {
@@ -498,6 +523,23 @@ PlaybackModel::TickBoundaries PlaybackModel::tickBoundaries(const ScoreChangesRa
     return result;
 }
 
+PlaybackModel::TimestampBoundaries PlaybackModel::timestampBoundaries(const TickBoundaries& tickRange) const
+{
+    TimestampBoundaries result;
+
+    if (tickRange.tickFrom == 0) {
+        //!Note Some events might be started RIGHT before the "official" start of the track
+        //!     See removeEvents()
+        result.from = PlaybackEventsChunk::MIN_TIMESTAMP;
+    } else {
+        result.from = timestampFromTicks(m_score, tickRange.tickFrom);
+    }
+
+    result.to = timestampFromTicks(m_score, tickRange.tickTo);
+
+    return result;
+}
+
 const RepeatList& PlaybackModel::repeatList() const
 {
     return m_score->repeatList();
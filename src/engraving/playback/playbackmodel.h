@@ -87,16 +87,22 @@ private:
         track_idx_t trackTo = mu::nidx;
     };
 
+    struct TimestampBoundaries
+    {
+        mpe::timestamp_t from = 0;
+        mpe::timestamp_t to = 0;
+    };
+
     InstrumentTrackId idKey(const EngravingItem* item) const;
     InstrumentTrackId idKey(const ID& partId, const std::string& instrumentId) const;
     InstrumentTrackIdSet existingTrackIdSet() const;
 
     void update(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
-                ChangedTrackIdSet* trackChanges = nullptr);
+                ChangedTrackIdSet* trackChanges = nullptr, TimestampBoundaries* changedTimestamps = nullptr);
     void updateSetupData();
     void updateContext(const track_idx_t trackFrom, const track_idx_t trackTo);
     void updateEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
-                      ChangedTrackIdSet* trackChanges = nullptr);
+                      ChangedTrackIdSet* trackChanges = nullptr, TimestampBoundaries* changedTimestamps = nullptr);
 
     bool hasToReloadTracks(const std::unordered_set<ElementType>& changedTypes) const;
     bool hasToReloadScore(const std::unordered_set<ElementType>& changedTypes) const;
@@ -106,12 +112,15 @@ private:
     void clearExpiredContexts(const track_idx_t trackFrom, const track_idx_t trackTo);
     void clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo);
     void collectChangesTracks(const InstrumentTrackId& trackId, ChangedTrackIdSet* result);
-    void notifyAboutChanges(ChangedTrackIdSet&& trackChanges, InstrumentTrackIdSet&& existingTracks);
+    void collectChangedTimestamps(const int utickFrom, const int utickTo, TimestampBoundaries* result);
+    void notifyAboutChanges(ChangedTrackIdSet&& trackChanges, InstrumentTrackIdSet&& existingTracks,
+                            const TimestampBoundaries& changedTimestamps);
 
     void removeEvents(const InstrumentTrackId& trackId, const mpe::timestamp_t timestampFrom, const mpe::timestamp_t timestampTo);
 
     TrackBoundaries trackBoundaries(const ScoreChangesRange& changesRange) const;
     TickBoundaries tickBoundaries(const ScoreChangesRange& changesRange) const;
+    TimestampBoundaries timestampBoundaries(const TickBoundaries& tickRange) const;
 
     const RepeatList& repeatList() const;
 
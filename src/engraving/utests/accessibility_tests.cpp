@@ -0,0 +1,113 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "libmscore/engravingitem.h"
+#include "libmscore/masterscore.h"
+
+#include "accessibility/accessibleitem.h"
+
+#include "mocks/engravingconfigurationmock.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+class AccessibilityTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_defaultConfiguration = EngravingItem::engravingConfiguration();
+    }
+
+    void TearDown() override
+    {
+        EngravingItem::setengravingConfiguration(m_defaultConfiguration);
+    }
+
+    //! NOTE Emulates a connected screen reader
+    void setAccessibleEnabled(bool enabled)
+    {
+        auto configuration = std::make_shared<::testing::NiceMock<EngravingConfigurationMock> >();
+        ON_CALL(*configuration, isAccessibleEnabled()).WillByDefault(::testing::Return(enabled));
+        ON_CALL(*configuration, defaultColor()).WillByDefault(::testing::Return(draw::Color::black));
+        EngravingItem::setengravingConfiguration(configuration);
+    }
+
+    static size_t accessibleItemsCount(Score* score)
+    {
+        size_t count = 0;
+        score->scanElements(&count, [](void* data, EngravingItem* item) {
+            if (item->accessible()) {
+                ++(*static_cast<size_t*>(data));
+            }
+        }, true);
+        return count;
+    }
+
+private:
+    std::shared_ptr<IEngravingConfiguration> m_defaultConfiguration;
+};
+
+/**
+ * @brief AccessibilityTests_SelectAllCreatesFocusedAccessibleOnly
+ * @details Selects the whole score while a screen reader is connected, only the element
+ *          that keeps the focus (and its parents) must get an accessible object
+ */
+TEST_F(AccessibilityTests, SelectAllCreatesFocusedAccessibleOnly)
+{
+    // [GIVEN] A connected screen reader
+    setAccessibleEnabled(true);
+
+    // [GIVEN] A score with many elements
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    // [THEN] Loading the score doesn't create accessible objects
+    EXPECT_EQ(accessibleItemsCount(score), 0);
+
+    // [WHEN] Select all
+    score->cmdSelectAll();
+
+    // [THEN] Only the focused element and its parents have accessible objects
+    const std::vector<EngravingItem*>& selected = score->selection().elements();
+    ASSERT_GT(selected.size(), 1);
+
+    EngravingItem* focused = selected.back();
+    EXPECT_TRUE(focused->accessible());
+
+    size_t focusedAndParentsCount = 0;
+    for (EngravingItem* item = focused; item; item = item->parentItem()) {
+        ++focusedAndParentsCount;
+    }
+
+    EXPECT_LE(accessibleItemsCount(score), focusedAndParentsCount);
+
+    delete score;
+}
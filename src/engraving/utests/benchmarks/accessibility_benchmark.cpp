@@ -0,0 +1,109 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "libmscore/engravingitem.h"
+#include "libmscore/masterscore.h"
+
+#include "accessibility/accessibleitem.h"
+
+#include "engraving/utests/mocks/engravingconfigurationmock.h"
+
+#include "benchmarkscores.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ORCHESTRAL_SCORE(u"demos/Dawn.mscx");
+
+using Clock = std::chrono::steady_clock;
+
+//! NOTE The benchmarks are disabled by default, run them with --gtest_also_run_disabled_tests
+class AccessibilityBenchmark : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_defaultConfiguration = EngravingItem::engravingConfiguration();
+    }
+
+    void TearDown() override
+    {
+        EngravingItem::setengravingConfiguration(m_defaultConfiguration);
+    }
+
+    //! NOTE Emulates a connected screen reader
+    void setAccessibleEnabled(bool enabled)
+    {
+        auto configuration = std::make_shared<::testing::NiceMock<EngravingConfigurationMock> >();
+        ON_CALL(*configuration, isAccessibleEnabled()).WillByDefault(::testing::Return(enabled));
+        ON_CALL(*configuration, defaultColor()).WillByDefault(::testing::Return(draw::Color::black));
+        EngravingItem::setengravingConfiguration(configuration);
+    }
+
+    static size_t accessibleItemsCount(Score* score)
+    {
+        size_t count = 0;
+        score->scanElements(&count, [](void* data, EngravingItem* item) {
+            if (item->accessible()) {
+                ++(*static_cast<size_t*>(data));
+            }
+        }, true);
+        return count;
+    }
+
+private:
+    std::shared_ptr<IEngravingConfiguration> m_defaultConfiguration;
+};
+
+/**
+ * @brief AccessibilityBenchmark_LoadAndSelectAll
+ * @details Measures loading a score and selecting all of it without and with a connected
+ *          screen reader, and reports the accessible objects that were created
+ */
+TEST_F(AccessibilityBenchmark, DISABLED_LoadAndSelectAll)
+{
+    for (bool screenReader : { false, true }) {
+        setAccessibleEnabled(screenReader);
+
+        Clock::time_point start = Clock::now();
+        MasterScore* score = BenchmarkScores::readScore(ORCHESTRAL_SCORE);
+        std::chrono::duration<double, std::milli> loadElapsed = Clock::now() - start;
+        ASSERT_TRUE(score);
+
+        start = Clock::now();
+        score->cmdSelectAll();
+        std::chrono::duration<double, std::milli> selectElapsed = Clock::now() - start;
+
+        size_t count = accessibleItemsCount(score);
+
+        LOGI() << (screenReader ? "with" : "without") << " screen reader: load " << loadElapsed.count() << " ms, "
+               << "select all " << selectElapsed.count() << " ms, "
+               << count << " accessible objects (" << count * sizeof(AccessibleItem) / 1024 << " KiB)";
+
+        delete score;
+    }
+}
@@ -0,0 +1,188 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarkresults.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "io/file.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+void BenchmarkResults::addSample(const std::string& score, const std::string& phase, double ms)
+{
+    if (std::find(m_phases.begin(), m_phases.end(), phase) == m_phases.end()) {
+        m_phases.push_back(phase);
+    }
+
+    auto it = m_samples.find(score);
+    if (it == m_samples.end()) {
+        m_scores.push_back(score);
+        it = m_samples.emplace(score, std::map<std::string, std::vector<double> >()).first;
+    }
+
+    it->second[phase].push_back(ms);
+}
+
+void BenchmarkResults::addFailedScore(const std::string& score)
+{
+    m_failedScores.push_back(score);
+}
+
+std::vector<double> BenchmarkResults::samples(const std::string& score, const std::string& phase) const
+{
+    auto scoreIt = m_samples.find(score);
+    if (scoreIt == m_samples.end()) {
+        return {};
+    }
+
+    auto phaseIt = scoreIt->second.find(phase);
+    if (phaseIt == scoreIt->second.end()) {
+        return {};
+    }
+
+    return phaseIt->second;
+}
+
+std::vector<double> BenchmarkResults::totalSamples(const std::string& phase) const
+{
+    std::vector<double> totals;
+    for (const auto& score : m_samples) {
+        auto it = score.second.find(phase);
+        if (it == score.second.end()) {
+            continue;
+        }
+
+        const std::vector<double>& values = it->second;
+        if (totals.size() < values.size()) {
+            totals.resize(values.size(), 0.0);
+        }
+
+        for (size_t i = 0; i < values.size(); ++i) {
+            totals[i] += values[i];
+        }
+    }
+
+    return totals;
+}
+
+//! NOTE Linear interpolation between the closest ranks, p is from 0 to 100
+double BenchmarkResults::percentile(std::vector<double> values, double p)
+{
+    if (values.empty()) {
+        return 0.0;
+    }
+
+    std::sort(values.begin(), values.end());
+
+    const double rank = std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(values.size() - 1);
+    const size_t lower = static_cast<size_t>(std::floor(rank));
+    const size_t upper = static_cast<size_t>(std::ceil(rank));
+    const double fraction = rank - static_cast<double>(lower);
+
+    return values[lower] + (values[upper] - values[lower]) * fraction;
+}
+
+JsonObject BenchmarkResults::phaseStats(const std::vector<double>& values)
+{
+    JsonObject stats;
+    stats["count"] = static_cast<int>(values.size());
+
+    if (values.empty()) {
+        return stats;
+    }
+
+    const double sum = std::accumulate(values.begin(), values.end(), 0.0);
+    stats["mean"] = sum / static_cast<double>(values.size());
+    stats["min"] = *std::min_element(values.begin(), values.end());
+    stats["p50"] = percentile(values, 50.0);
+    stats["p90"] = percentile(values, 90.0);
+    stats["p95"] = percentile(values, 95.0);
+    stats["p99"] = percentile(values, 99.0);
+    stats["max"] = *std::max_element(values.begin(), values.end());
+
+    JsonArray samples;
+    for (double v : values) {
+        samples << v;
+    }
+    stats["samples"] = samples;
+
+    return stats;
+}
+
+JsonObject BenchmarkResults::toJson() const
+{
+    JsonObject root;
+    root["unit"] = "ms";
+
+    JsonObject total;
+    for (const std::string& phase : m_phases) {
+        total[phase] = phaseStats(totalSamples(phase));
+    }
+    root["total"] = total;
+
+    JsonArray scores;
+    for (const std::string& name : m_scores) {
+        const std::map<std::string, std::vector<double> >& phases = m_samples.at(name);
+
+        JsonObject score;
+        score["name"] = name;
+        for (const std::string& phase : m_phases) {
+            auto it = phases.find(phase);
+            if (it != phases.end()) {
+                score[phase] = phaseStats(it->second);
+            }
+        }
+        scores << score;
+    }
+    root["scores"] = scores;
+
+    JsonArray failed;
+    for (const std::string& name : m_failedScores) {
+        failed << JsonValue(name);
+    }
+    root["failed"] = failed;
+
+    return root;
+}
+
+ByteArray BenchmarkResults::toJsonData() const
+{
+    return JsonDocument(toJson()).toJson(JsonDocument::Format::Indented);
+}
+
+bool BenchmarkResults::save(const io::path_t& path) const
+{
+    io::File file(path);
+    if (!file.open(io::IODevice::WriteOnly)) {
+        LOGE() << "failed to open the benchmark results file: " << path;
+        return false;
+    }
+
+    ByteArray data = toJsonData();
+    return file.write(data) == data.size();
+}
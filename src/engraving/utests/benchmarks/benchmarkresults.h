@@ -0,0 +1,65 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_BENCHMARKRESULTS_H
+#define MU_ENGRAVING_BENCHMARKRESULTS_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "io/path.h"
+#include "types/bytearray.h"
+#include "serialization/json.h"
+
+namespace mu::engraving {
+//! NOTE Collects the times of the phases of the benchmarked scores, in milliseconds,
+//! and writes them to JSON with percentiles, to compare the runs of different builds
+class BenchmarkResults
+{
+public:
+    BenchmarkResults() = default;
+
+    void addSample(const std::string& score, const std::string& phase, double ms);
+    void addFailedScore(const std::string& score);
+
+    std::vector<double> samples(const std::string& score, const std::string& phase) const;
+
+    //! NOTE The sum over all the scores of each iteration of the phase
+    std::vector<double> totalSamples(const std::string& phase) const;
+
+    static double percentile(std::vector<double> values, double p);
+
+    JsonObject toJson() const;
+    ByteArray toJsonData() const;
+    bool save(const io::path_t& path) const;
+
+private:
+    static JsonObject phaseStats(const std::vector<double>& values);
+
+    std::vector<std::string> m_phases;
+    std::vector<std::string> m_scores;
+    std::map<std::string, std::map<std::string, std::vector<double> > > m_samples;
+    std::vector<std::string> m_failedScores;
+};
+}
+
+#endif // MU_ENGRAVING_BENCHMARKRESULTS_H
@@ -0,0 +1,107 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "benchmarkresults.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+class BenchmarkResultsTests : public ::testing::Test
+{
+};
+
+/**
+ * @brief BenchmarkResultsTests_Percentile
+ * @details Checks the percentiles, interpolated between the closest ranks of the sorted values
+ */
+TEST_F(BenchmarkResultsTests, Percentile)
+{
+    // [GIVEN] Unsorted values
+    std::vector<double> values = { 4.0, 1.0, 3.0, 2.0, 5.0 };
+
+    // [THEN] The percentiles are taken from the sorted values
+    EXPECT_DOUBLE_EQ(BenchmarkResults::percentile(values, 0.0), 1.0);
+    EXPECT_DOUBLE_EQ(BenchmarkResults::percentile(values, 50.0), 3.0);
+    EXPECT_DOUBLE_EQ(BenchmarkResults::percentile(values, 90.0), 4.6);
+    EXPECT_DOUBLE_EQ(BenchmarkResults::percentile(values, 100.0), 5.0);
+
+    // [THEN] One value is every percentile, and no values give zero
+    EXPECT_DOUBLE_EQ(BenchmarkResults::percentile({ 7.0 }, 99.0), 7.0);
+    EXPECT_DOUBLE_EQ(BenchmarkResults::percentile({}, 50.0), 0.0);
+}
+
+/**
+ * @brief BenchmarkResultsTests_TotalSamples
+ * @details Checks that the totals of a phase are the sums over the scores of every iteration
+ */
+TEST_F(BenchmarkResultsTests, TotalSamples)
+{
+    // [GIVEN] Two iterations of two scores
+    BenchmarkResults results;
+    results.addSample("a.mscx", "layout", 1.0);
+    results.addSample("b.mscx", "layout", 10.0);
+    results.addSample("a.mscx", "layout", 2.0);
+    results.addSample("b.mscx", "layout", 20.0);
+    results.addSample("a.mscx", "read", 5.0);
+
+    // [THEN] The samples are kept per score and phase, and summed per iteration
+    EXPECT_EQ(results.samples("a.mscx", "layout"), std::vector<double>({ 1.0, 2.0 }));
+    EXPECT_EQ(results.totalSamples("layout"), std::vector<double>({ 11.0, 22.0 }));
+    EXPECT_EQ(results.totalSamples("read"), std::vector<double>({ 5.0 }));
+    EXPECT_TRUE(results.samples("c.mscx", "layout").empty());
+}
+
+/**
+ * @brief BenchmarkResultsTests_Json
+ * @details Checks that the results are written to JSON with the statistics of every phase
+ */
+TEST_F(BenchmarkResultsTests, Json)
+{
+    // [GIVEN] Results of a score and a failed score
+    BenchmarkResults results;
+    for (double ms : { 3.0, 1.0, 2.0 }) {
+        results.addSample("a.mscx", "layout", ms);
+    }
+    results.addFailedScore("b.mscz");
+
+    // [WHEN] They are written to JSON and read back
+    JsonObject root = JsonDocument::fromJson(results.toJsonData()).rootObject();
+
+    // [THEN] The statistics of the total and of the score are there
+    JsonObject total = root.value("total").toObject().value("layout").toObject();
+    EXPECT_EQ(total.value("count").toInt(), 3);
+    EXPECT_DOUBLE_EQ(total.value("min").toDouble(), 1.0);
+    EXPECT_DOUBLE_EQ(total.value("p50").toDouble(), 2.0);
+    EXPECT_DOUBLE_EQ(total.value("max").toDouble(), 3.0);
+    EXPECT_EQ(total.value("samples").toArray().size(), 3);
+
+    JsonArray scores = root.value("scores").toArray();
+    ASSERT_EQ(scores.size(), 1);
+    EXPECT_EQ(scores.at(0).toObject().value("name").toStdString(), "a.mscx");
+    EXPECT_DOUBLE_EQ(scores.at(0).toObject().value("layout").toObject().value("mean").toDouble(), 2.0);
+
+    JsonArray failed = root.value("failed").toArray();
+    ASSERT_EQ(failed.size(), 1);
+    EXPECT_EQ(failed.at(0).toStdString(), "b.mscz");
+}
@@ -0,0 +1,59 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "benchmarkscores.h"
+
+#include "engraving/compat/mscxcompat.h"
+#include "engraving/compat/scoreaccess.h"
+#include "engraving/infrastructure/io/localfileinfoprovider.h"
+
+#include "libmscore/masterscore.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+io::path_t BenchmarkScores::dataRoot()
+{
+    return io::path_t(engraving_benchmarks_DATA_ROOT);
+}
+
+MasterScore* BenchmarkScores::readScore(const String& path)
+{
+    io::path_t fullPath = dataRoot() + "/" + path;
+    MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle();
+    score->setFileInfoProvider(std::make_shared<LocalFileInfoProvider>(fullPath));
+
+    ScoreLoad sl;
+    Score::FileError rv = compat::loadMsczOrMscx(score, fullPath.toString(), false);
+    if (rv != Score::FileError::FILE_NO_ERROR) {
+        LOGE() << "can't load score, path: " << fullPath;
+        delete score;
+        return nullptr;
+    }
+
+    for (Score* s : score->scoreList()) {
+        s->doLayout();
+    }
+
+    return score;
+}
@@ -0,0 +1,43 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_BENCHMARKSCORES_H
+#define MU_ENGRAVING_BENCHMARKSCORES_H
+
+#include "io/path.h"
+#include "types/string.h"
+
+namespace mu::engraving {
+class MasterScore;
+
+//! NOTE The scores of the benchmarks are the existing test and vtest scores,
+//! their paths are relative to the root of the sources
+class BenchmarkScores
+{
+public:
+    static io::path_t dataRoot();
+
+    //! NOTE Reads the score and lays out all its scores, returns nullptr on failure
+    static MasterScore* readScore(const String& path);
+};
+}
+
+#endif // MU_ENGRAVING_BENCHMARKSCORES_H
@@ -0,0 +1,324 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <QBuffer>
+#include <QImage>
+#include <QPdfWriter>
+
+#include "io/buffer.h"
+#include "io/dir.h"
+#include "mpe/tests/mocks/articulationprofilesrepositorymock.h"
+
+#include "engraving/compat/mscxcompat.h"
+#include "engraving/compat/scoreaccess.h"
+#include "engraving/compat/writescorehook.h"
+#include "engraving/paint/paint.h"
+#include "engraving/playback/playbackmodel.h"
+
+#include "libmscore/chord.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/note.h"
+#include "libmscore/page.h"
+#include "libmscore/part.h"
+#include "libmscore/segment.h"
+
+#include "importexport/midi/internal/midiexport/exportmidi.h"
+
+#include "benchmarkresults.h"
+
+#include "log.h"
+
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::_;
+
+using namespace mu;
+using namespace mu::engraving;
+
+//! NOTE The corpus, relative to the root of the sources
+static const std::vector<String> CORPUS_DIRS = { u"vtest/scores", u"test" };
+
+static constexpr int DEFAULT_ITERATIONS = 5;
+static constexpr int PNG_DPI = 150;
+
+using Clock = std::chrono::steady_clock;
+
+class CorpusBenchmark : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_profilesRepository = std::make_shared<NiceMock<mpe::ArticulationProfilesRepositoryMock> >();
+        ON_CALL(*m_profilesRepository, defaultProfile(_)).WillByDefault(Return(std::make_shared<mpe::ArticulationsProfile>()));
+    }
+
+    //! NOTE The number of iterations and the results file can be set by MU_BENCHMARK_ITERATIONS and MU_BENCHMARK_OUTPUT
+    static int iterations()
+    {
+        const char* value = std::getenv("MU_BENCHMARK_ITERATIONS");
+        int count = value ? std::atoi(value) : 0;
+        return count > 0 ? count : DEFAULT_ITERATIONS;
+    }
+
+    static io::path_t outputPath()
+    {
+        const char* value = std::getenv("MU_BENCHMARK_OUTPUT");
+        return value ? io::path_t(value) : io::path_t("engraving_benchmarks.json");
+    }
+
+    static io::path_t dataRoot()
+    {
+        return io::path_t(engraving_benchmarks_DATA_ROOT);
+    }
+
+    //! NOTE Relative to the root of the sources, as the names of the files in the corpus directories repeat
+    static std::string scoreName(const io::path_t& path)
+    {
+        const std::string root = dataRoot().toStdString() + "/";
+        const std::string str = path.toStdString();
+        return str.compare(0, root.size(), root) == 0 ? str.substr(root.size()) : str;
+    }
+
+    static io::paths_t corpus()
+    {
+        io::paths_t paths;
+        for (const String& dir : CORPUS_DIRS) {
+            io::path_t root = dataRoot() + "/" + dir;
+            RetVal<io::paths_t> files = io::Dir::scanFiles(root, { "*.mscx", "*.mscz" }, io::ScanMode::FilesInCurrentDir);
+            if (!files.ret) {
+                LOGW() << "failed to scan the corpus directory: " << root;
+                continue;
+            }
+            paths.insert(paths.end(), files.val.begin(), files.val.end());
+        }
+
+        std::sort(paths.begin(), paths.end());
+        return paths;
+    }
+
+    static double measure(const std::function<void()>& func)
+    {
+        Clock::time_point start = Clock::now();
+        func();
+        std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+        return elapsed.count();
+    }
+
+    //! NOTE The first note in the middle measure, the place of the scripted edit
+    static Note* editedNote(Score* score)
+    {
+        std::vector<Measure*> measures;
+        for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            measures.push_back(m);
+        }
+
+        for (size_t i = measures.size() / 2; i < measures.size(); ++i) {
+            for (Segment* s = measures[i]->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+                for (EngravingItem* e : s->elist()) {
+                    if (e && e->isChord()) {
+                        return toChord(e)->upNote();
+                    }
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    static void paintPages(draw::Painter& painter, Score* score, int deviceDpi, size_t fromPage, size_t toPage,
+                           const std::function<void()>& onNewPage)
+    {
+        const std::vector<Page*>& pages = score->pages();
+        const Page* firstPage = pages.front();
+        const SizeF pageSize(firstPage->bbox().width() / DPI, firstPage->bbox().height() / DPI);
+
+        painter.setAntialiasing(true);
+        painter.setViewport(RectF(0.0, 0.0, pageSize.width() * deviceDpi, pageSize.height() * deviceDpi));
+        painter.setWindow(RectF(0.0, 0.0, pageSize.width() * DPI, pageSize.height() * DPI));
+
+        //! NOTE The painting state is global, it is restored for the phases and the scores that follow
+        const double pixelRatio = MScore::pixelRatio;
+        MScore::pixelRatio = DPI / deviceDpi;
+        MScore::pdfPrinting = true;
+        score->setPrinting(true);
+
+        for (size_t i = fromPage; i <= toPage && i < pages.size(); ++i) {
+            Page* page = pages.at(i);
+            if (i > fromPage && onNewPage) {
+                onNewPage();
+            }
+
+            painter.fillRect(page->bbox(), draw::Color::white);
+            std::vector<EngravingItem*> elements = page->items(page->bbox());
+            Paint::paintElements(painter, elements, true);
+        }
+
+        score->setPrinting(false);
+        MScore::pdfPrinting = false;
+        MScore::pixelRatio = pixelRatio;
+    }
+
+    void benchmarkScore(const io::path_t& path, int iteration, BenchmarkResults& results) const
+    {
+        const std::string name = scoreName(path);
+
+        MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle();
+        Score::FileError err = Score::FileError::FILE_NO_ERROR;
+        double readMs = measure([&]() {
+            err = compat::loadMsczOrMscx(score, path.toString(), true);
+        });
+
+        if (err != Score::FileError::FILE_NO_ERROR) {
+            if (iteration == 0) {
+                LOGW() << "can't load score, path: " << path;
+                results.addFailedScore(name);
+            }
+            delete score;
+            return;
+        }
+
+        results.addSample(name, "read", readMs);
+
+        results.addSample(name, "layout", measure([score]() {
+            for (Score* s : score->scoreList()) {
+                s->doLayout();
+            }
+        }));
+
+        if (Note* note = editedNote(score)) {
+            score->select(note, SelectType::SINGLE, 0);
+            results.addSample(name, "edit", measure([score]() {
+                score->startCmd();
+                score->upDown(true, UpDownMode::CHROMATIC);
+                score->endCmd();
+            }));
+            score->undoRedo(true, nullptr);
+            score->deselectAll();
+        }
+
+        results.addSample(name, "playback", measure([this, score]() {
+            PlaybackModel model;
+            model.setprofilesRepository(m_profilesRepository);
+            model.load(score);
+            for (const Part* part : score->parts()) {
+                model.resolveTrackPlaybackData(part->id(), part->instrumentId().toStdString());
+            }
+        }));
+
+        results.addSample(name, "save", measure([score]() {
+            io::Buffer buffer;
+            buffer.open(io::IODevice::WriteOnly);
+            compat::WriteScoreHook hook;
+            score->writeScore(&buffer, false, false, hook);
+        }));
+
+        if (!score->pages().empty()) {
+            results.addSample(name, "pdf", measure([score]() {
+                QBuffer buffer;
+                buffer.open(QIODevice::WriteOnly);
+                QPdfWriter pdfWriter(&buffer);
+                const Page* page = score->pages().front();
+                pdfWriter.setPageMargins(QMarginsF());
+                pdfWriter.setPageLayout(QPageLayout(QPageSize(QSizeF(page->bbox().width() / DPI, page->bbox().height() / DPI),
+                                                              QPageSize::Inch), QPageLayout::Orientation::Portrait, QMarginsF()));
+
+                draw::Painter painter(&pdfWriter, "benchmark_pdf");
+                paintPages(painter, score, pdfWriter.logicalDpiX(), 0, score->pages().size() - 1, [&pdfWriter]() {
+                    pdfWriter.newPage();
+                });
+                painter.endDraw();
+            }));
+
+            results.addSample(name, "png", measure([score]() {
+                const Page* page = score->pages().front();
+                QImage image(std::lrint(page->bbox().width() / DPI * PNG_DPI), std::lrint(page->bbox().height() / DPI * PNG_DPI),
+                             QImage::Format_ARGB32_Premultiplied);
+
+                //! NOTE Every page is painted and encoded as a separate image, as the PNG export does
+                for (size_t i = 0; i < score->pages().size(); ++i) {
+                    draw::Painter painter(&image, "benchmark_png");
+                    paintPages(painter, score, PNG_DPI, i, i, nullptr);
+                    painter.endDraw();
+
+                    QBuffer buffer;
+                    buffer.open(QIODevice::WriteOnly);
+                    image.save(&buffer, "png");
+                }
+            }));
+        }
+
+        results.addSample(name, "midi", measure([score]() {
+            QBuffer buffer;
+            buffer.open(QIODevice::WriteOnly);
+            iex::midi::ExportMidi exportMidi(score);
+            exportMidi.write(&buffer, true, false, score->synthesizerState());
+        }));
+
+        delete score;
+    }
+
+private:
+    std::shared_ptr<NiceMock<mpe::ArticulationProfilesRepositoryMock> > m_profilesRepository;
+};
+
+//! NOTE The benchmark is disabled by default, run it with --gtest_also_run_disabled_tests
+//! --gtest_filter=CorpusBenchmark.*
+
+/**
+ * @brief CorpusBenchmark_DISABLED_Phases
+ * @details Times the read, layout, the relayout after an edit, the rendering of the playback events,
+ *          the save, the PDF and PNG painting and the MIDI export of every score of the corpus,
+ *          and writes the times with percentiles to JSON
+ */
+TEST_F(CorpusBenchmark, DISABLED_Phases)
+{
+    const io::paths_t paths = corpus();
+    ASSERT_FALSE(paths.empty());
+
+    BenchmarkResults results;
+    const int count = iterations();
+    for (int i = 0; i < count; ++i) {
+        for (const io::path_t& path : paths) {
+            benchmarkScore(path, i, results);
+        }
+    }
+
+    const io::path_t output = outputPath();
+    EXPECT_TRUE(results.save(output));
+
+    LOGI() << paths.size() << " scores, " << count << " iterations, results: " << output;
+    for (const char* phase : { "read", "layout", "edit", "playback", "save", "pdf", "png", "midi" }) {
+        std::vector<double> totals = results.totalSamples(phase);
+        LOGI() << "    " << phase << ": p50 " << BenchmarkResults::percentile(totals, 50.0)
+               << " ms, p90 " << BenchmarkResults::percentile(totals, 90.0) << " ms";
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+
+#include "benchmarkscores.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String MANY_STAVES_SCORE(u"src/engraving/tests/midi_data/testMidiPort.mscx");
+static const String ORCHESTRAL_SCORE(u"demos/Dawn.mscx");
+
+static constexpr int LAYOUTS_COUNT = 10;
+
+using Clock = std::chrono::steady_clock;
+
+//! NOTE The benchmarks are disabled by default, run them with --gtest_also_run_disabled_tests
+class SegmentMemoryBenchmark : public ::testing::Test
+{
+public:
+    void reportScore(const String& path) const
+    {
+        MasterScore* score = BenchmarkScores::readScore(path);
+        ASSERT_TRUE(score);
+
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < LAYOUTS_COUNT; ++i) {
+            score->doLayout();
+        }
+        std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+
+        size_t measuresCount = 0;
+        size_t segmentsCount = 0;
+        size_t segmentsMemory = 0;
+        for (Measure* measure = score->firstMeasure(); measure; measure = measure->nextMeasure()) {
+            ++measuresCount;
+            for (const Segment* segment = measure->first(); segment; segment = segment->next()) {
+                ++segmentsCount;
+                segmentsMemory += segment->memoryUsage();
+            }
+        }
+
+        size_t measuresMemory = measuresCount * sizeof(Measure) + segmentsMemory;
+
+        //! NOTE Until the pre-appended items were stored sparsely, every segment kept a pointer for each track
+        size_t denseTracksMemory = segmentsCount * score->ntracks() * sizeof(EngravingItem*);
+
+        LOGI() << path << ": " << score->nstaves() << " staves, " << measuresCount << " measures, " << segmentsCount << " segments";
+        LOGI() << "    segments: " << segmentsMemory / 1024 << " KiB, "
+               << (segmentsCount ? segmentsMemory / segmentsCount : 0) << " bytes per segment";
+        LOGI() << "    measures (with their segments): " << measuresMemory / 1024 << " KiB, "
+               << (measuresCount ? measuresMemory / measuresCount : 0) << " bytes per measure";
+        LOGI() << "    saved by the sparse pre-appended items: " << denseTracksMemory / 1024 << " KiB";
+        LOGI() << "    layout: " << elapsed.count() / LAYOUTS_COUNT << " ms per layout";
+
+        delete score;
+    }
+};
+
+/**
+ * @brief SegmentMemoryBenchmark_ManyStavesScore
+ * @details Reports the memory of the segments and measures of a score with a lot of staves,
+ *          where most of the staves rest in every measure
+ */
+TEST_F(SegmentMemoryBenchmark, DISABLED_ManyStavesScore)
+{
+    reportScore(MANY_STAVES_SCORE);
+}
+
+/**
+ * @brief SegmentMemoryBenchmark_OrchestralScore
+ * @details Reports the memory of the segments and measures of an orchestral score
+ */
+TEST_F(SegmentMemoryBenchmark, DISABLED_OrchestralScore)
+{
+    reportScore(ORCHESTRAL_SCORE);
+}
@@ -0,0 +1,190 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/skyline.h"
+#include "libmscore/stafflines.h"
+#include "libmscore/system.h"
+
+#include "benchmarkscores.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String PIANO_SCORE(u"src/engraving/utests/all_elements_data/moonlight.mscx");
+static const String PERCUSSION_SCORE(u"src/engraving/tests/midimapping_data/test1withDrums.mscx");
+
+static constexpr int BUILDS_COUNT = 100;
+
+using Clock = std::chrono::steady_clock;
+
+//! NOTE The benchmarks are disabled by default, run them with --gtest_also_run_disabled_tests
+class SkylineBenchmark : public ::testing::Test
+{
+public:
+    Skyline addedSkyline(const std::vector<RectF>& rects) const
+    {
+        Skyline skyline;
+        for (const RectF& r : rects) {
+            skyline.add(r);
+        }
+        return skyline;
+    }
+
+    Skyline builtSkyline(const std::vector<RectF>& rects) const
+    {
+        Skyline skyline;
+        skyline.build(rects);
+        return skyline;
+    }
+
+    //! NOTE The rectangles that the layout of the system elements puts to the skyline of a staff before the beams
+    std::vector<RectF> staffRects(const System* system, staff_idx_t staffIdx) const
+    {
+        std::vector<RectF> rects;
+        for (MeasureBase* mb : system->measures()) {
+            if (!mb->isMeasure()) {
+                continue;
+            }
+            Measure* m = toMeasure(mb);
+            rects.push_back(m->staffLines(staffIdx)->bbox().translated(m->pos()));
+            for (Segment& s : m->segments()) {
+                if (!s.enabled() || s.isTimeSigType()) {
+                    continue;
+                }
+                PointF p(s.pos() + m->pos());
+                for (track_idx_t track = staffIdx * VOICES; track < (staffIdx + 1) * VOICES; ++track) {
+                    EngravingItem* e = s.element(track);
+                    if (!e || !e->addToSkyline()) {
+                        continue;
+                    }
+                    for (const ShapeElement& r : e->shape()) {
+                        rects.push_back(r.translated(e->pos() + p));
+                    }
+                }
+            }
+        }
+        return rects;
+    }
+
+    void benchmarkScore(const String& path) const
+    {
+        MasterScore* score = BenchmarkScores::readScore(path);
+        ASSERT_TRUE(score);
+        score->doLayout();
+
+        std::vector<std::vector<RectF> > staves;
+        size_t rectsCount = 0;
+        for (const System* system : score->systems()) {
+            for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+                staves.push_back(staffRects(system, staffIdx));
+                rectsCount += staves.back().size();
+            }
+        }
+
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < BUILDS_COUNT; ++i) {
+            for (const std::vector<RectF>& rects : staves) {
+                addedSkyline(rects);
+            }
+        }
+        std::chrono::duration<double, std::milli> addElapsed = Clock::now() - start;
+
+        start = Clock::now();
+        for (int i = 0; i < BUILDS_COUNT; ++i) {
+            for (const std::vector<RectF>& rects : staves) {
+                builtSkyline(rects);
+            }
+        }
+        std::chrono::duration<double, std::milli> buildElapsed = Clock::now() - start;
+
+        std::vector<Skyline> added;
+        std::vector<Skyline> built;
+        for (const std::vector<RectF>& rects : staves) {
+            added.push_back(addedSkyline(rects));
+            built.push_back(builtSkyline(rects));
+        }
+
+        start = Clock::now();
+        for (int i = 0; i < BUILDS_COUNT; ++i) {
+            for (size_t j = 1; j < added.size(); ++j) {
+                added[j - 1].minDistance(added[j]);
+            }
+        }
+        std::chrono::duration<double, std::milli> addedDistanceElapsed = Clock::now() - start;
+
+        start = Clock::now();
+        for (int i = 0; i < BUILDS_COUNT; ++i) {
+            for (size_t j = 1; j < built.size(); ++j) {
+                built[j - 1].minDistance(built[j]);
+            }
+        }
+        std::chrono::duration<double, std::milli> builtDistanceElapsed = Clock::now() - start;
+
+        for (size_t j = 1; j < added.size(); ++j) {
+            EXPECT_DOUBLE_EQ(added[j - 1].minDistance(added[j]), built[j - 1].minDistance(built[j]));
+        }
+
+        start = Clock::now();
+        for (int i = 0; i < BUILDS_COUNT / 10; ++i) {
+            score->doLayout();
+        }
+        std::chrono::duration<double, std::milli> layoutElapsed = Clock::now() - start;
+
+        LOGI() << path << ": " << staves.size() << " staff skylines, " << rectsCount << " rectangles";
+        LOGI() << "    add one by one: " << addElapsed.count() / BUILDS_COUNT << " ms";
+        LOGI() << "    build at once: " << buildElapsed.count() / BUILDS_COUNT << " ms";
+        LOGI() << "    minDistance of added skylines: " << addedDistanceElapsed.count() / BUILDS_COUNT << " ms";
+        LOGI() << "    minDistance of built skylines: " << builtDistanceElapsed.count() / BUILDS_COUNT << " ms";
+        LOGI() << "    layout: " << layoutElapsed.count() / (BUILDS_COUNT / 10) << " ms per layout";
+
+        delete score;
+    }
+};
+
+/**
+ * @brief SkylineBenchmark_PianoScore
+ * @details Compares adding the rectangles of the staff skylines one by one and building them at once,
+ *          on a piano score with runs and chords on both staves
+ */
+TEST_F(SkylineBenchmark, DISABLED_PianoScore)
+{
+    benchmarkScore(PIANO_SCORE);
+}
+
+/**
+ * @brief SkylineBenchmark_PercussionScore
+ * @details Compares adding the rectangles of the staff skylines one by one and building them at once,
+ *          on a score with a drum set
+ */
+TEST_F(SkylineBenchmark, DISABLED_PercussionScore)
+{
+    benchmarkScore(PERCUSSION_SCORE);
+}
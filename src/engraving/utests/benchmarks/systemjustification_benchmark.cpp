@@ -0,0 +1,76 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/mscore.h"
+
+#include "benchmarkscores.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ORCHESTRAL_SCORE(u"demos/Dawn.mscx");
+
+static constexpr int LAYOUTS_COUNT = 10;
+
+using Clock = std::chrono::steady_clock;
+
+//! NOTE The benchmarks are disabled by default, run them with --gtest_also_run_disabled_tests
+class SystemJustificationBenchmark : public ::testing::Test
+{
+};
+
+/**
+ * @brief SystemJustificationBenchmark_OrchestralScoreLayout
+ * @details Measures the full layout of an orchestral score without and with the spacing cache
+ */
+TEST_F(SystemJustificationBenchmark, DISABLED_OrchestralScoreLayout)
+{
+    MasterScore* score = BenchmarkScores::readScore(ORCHESTRAL_SCORE);
+    ASSERT_TRUE(score);
+
+    auto measureLayout = [score](bool noSpacingCache) {
+        MScore::noSpacingCache = noSpacingCache;
+
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < LAYOUTS_COUNT; ++i) {
+            score->doLayout();
+        }
+        std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+
+        MScore::noSpacingCache = false;
+
+        return elapsed.count() / LAYOUTS_COUNT;
+    };
+
+    double uncachedMs = measureLayout(true);
+    double cachedMs = measureLayout(false);
+
+    LOGI() << "orchestral score layout, without spacing cache: " << uncachedMs << " ms, with spacing cache: " << cachedMs << " ms";
+
+    delete score;
+}
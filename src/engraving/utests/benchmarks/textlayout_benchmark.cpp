@@ -0,0 +1,168 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include <QFontMetricsF>
+
+#include "libmscore/chordrest.h"
+#include "libmscore/factory.h"
+#include "libmscore/harmony.h"
+#include "libmscore/lyrics.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+
+#include "infrastructure/draw/fontmetrics.h"
+
+#include "benchmarkscores.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String LYRICS_DENSE_SCORE(u"src/engraving/utests/all_elements_data/moonlight.mscx");
+
+static const std::vector<String> SYLLABLES = {
+    u"Glo-", u"ri-", u"a", u"in", u"ex-", u"cel-", u"sis", u"De-", u"o", u"et", u"in", u"ter-", u"ra", u"pax", u"ho-", u"mi-", u"ni-", u"bus"
+};
+
+static const std::vector<String> CHORD_SYMBOLS = {
+    u"Cmaj7", u"Am7", u"Dm7", u"G7(b9)", u"Em7b5", u"A7alt", u"Fmaj7#11", u"Bb13"
+};
+
+static constexpr int VERSES_COUNT = 4;
+static constexpr int LAYOUTS_COUNT = 10;
+
+using Clock = std::chrono::steady_clock;
+
+//! NOTE The benchmarks are disabled by default, run them with --gtest_also_run_disabled_tests
+class TextLayoutBenchmark : public ::testing::Test
+{
+public:
+    MasterScore* readLyricsDenseScore() const
+    {
+        MasterScore* score = BenchmarkScores::readScore(LYRICS_DENSE_SCORE);
+        EXPECT_TRUE(score);
+        if (!score) {
+            return nullptr;
+        }
+
+        size_t syllableIdx = 0;
+        for (Segment* segment = score->firstSegment(SegmentType::ChordRest); segment;
+             segment = segment->next1(SegmentType::ChordRest)) {
+            for (track_idx_t track = 0; track < score->ntracks(); track += VOICES) {
+                EngravingItem* item = segment->element(track);
+                if (!item || !item->isChord()) {
+                    continue;
+                }
+
+                ChordRest* chord = toChordRest(item);
+                for (int verse = 0; verse < VERSES_COUNT; ++verse) {
+                    Lyrics* lyrics = Factory::createLyrics(chord);
+                    lyrics->setTrack(track);
+                    lyrics->setParent(chord);
+                    lyrics->setNo(verse);
+                    lyrics->setPlainText(SYLLABLES[syllableIdx++ % SYLLABLES.size()]);
+                    chord->add(lyrics);
+                }
+            }
+        }
+
+        size_t chordSymbolIdx = 0;
+        for (Measure* measure = score->firstMeasure(); measure; measure = measure->nextMeasure()) {
+            Segment* segment = measure->first(SegmentType::ChordRest);
+            if (!segment) {
+                continue;
+            }
+
+            Harmony* harmony = Factory::createHarmony(segment);
+            harmony->setTrack(0);
+            harmony->setHarmony(CHORD_SYMBOLS[chordSymbolIdx++ % CHORD_SYMBOLS.size()]);
+            segment->add(harmony);
+        }
+
+        score->doLayout();
+
+        return score;
+    }
+};
+
+/**
+ * @brief TextLayoutBenchmark_LyricsDenseScoreLayout
+ * @details Measures the full layout of a score where every chord has several verses of lyrics
+ *          and every measure has a chord symbol
+ */
+TEST_F(TextLayoutBenchmark, DISABLED_LyricsDenseScoreLayout)
+{
+    MasterScore* score = readLyricsDenseScore();
+    ASSERT_TRUE(score);
+
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < LAYOUTS_COUNT; ++i) {
+        score->doLayout();
+    }
+    std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+
+    LOGI() << "lyrics dense score layout: " << elapsed.count() / LAYOUTS_COUNT << " ms per layout";
+
+    delete score;
+}
+
+/**
+ * @brief TextLayoutBenchmark_SyllableWidths
+ * @details Compares measuring the lyrics syllables through the font provider with measuring them
+ *          by a new QFontMetricsF for every call, as the font provider used to do
+ */
+TEST_F(TextLayoutBenchmark, DISABLED_SyllableWidths)
+{
+    static constexpr int ROUNDS_COUNT = 10000;
+
+    draw::Font font(u"Edwin");
+    font.setPointSizeF(10.0);
+
+    double cachedSum = 0.0;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < ROUNDS_COUNT; ++i) {
+        for (const String& syllable : SYLLABLES) {
+            cachedSum += draw::FontMetrics::width(font, syllable);
+        }
+    }
+    std::chrono::duration<double, std::milli> cachedElapsed = Clock::now() - start;
+
+    double qtSum = 0.0;
+    start = Clock::now();
+    for (int i = 0; i < ROUNDS_COUNT; ++i) {
+        for (const String& syllable : SYLLABLES) {
+            qtSum += QFontMetricsF(font.toQFont()).horizontalAdvance(syllable.toQString());
+        }
+    }
+    std::chrono::duration<double, std::milli> qtElapsed = Clock::now() - start;
+
+    LOGI() << "syllable widths, cached: " << cachedElapsed.count() << " ms, QFontMetricsF per call: " << qtElapsed.count() << " ms";
+
+    EXPECT_GT(cachedSum, 0.0);
+    EXPECT_GT(qtSum, 0.0);
+}
@@ -31,6 +31,7 @@ class EngravingConfigurationMock : public IEngravingConfiguration
 {
 public:
     MOCK_METHOD(io::path_t, appDataPath, (), (const, override));
+    MOCK_METHOD(io::path_t, scoreFontsMetricsCachePath, (), (const, override));
 
     MOCK_METHOD(io::path_t, defaultStyleFilePath, (), (const, override));
     MOCK_METHOD(void, setDefaultStyleFilePath, (const io::path_t&), (override));
@@ -67,6 +68,9 @@ public:
     MOCK_METHOD(async::Notification, debuggingOptionsChanged, (), (const, override));
 
     MOCK_METHOD(bool, isAccessibleEnabled, (), (const, override));
+
+    MOCK_METHOD(size_t, undoHistoryMemoryBudget, (), (const, override));
+    MOCK_METHOD(void, setUndoHistoryMemoryBudget, (size_t), (override));
 };
 }
 
@@ -398,7 +398,9 @@ TEST_F(PlaybackModelTests, SimpleRepeat_Changes_Notification)
     ON_CALL(*m_repositoryMock, defaultProfile(ArticulationFamily::Strings)).WillByDefault(Return(m_defaultProfile));
 
     // [GIVEN] Expected amount of changed events
-    int expectedChangedEventsCount = 24;
+    //         Both passes of the 2-nd measure and the first beat of the 3-rd measure are being re-rendered,
+    //         so that the range from 2000ms up to 8500ms is expected to be sent
+    int expectedChangedEventsCount = 14;
 
     // [GIVEN] The playback model requested to be loaded
     PlaybackModel model;
@@ -408,8 +410,11 @@ TEST_F(PlaybackModelTests, SimpleRepeat_Changes_Notification)
     PlaybackData result = model.resolveTrackPlaybackData(part->id(), part->instrumentId().toStdString());
 
     // [THEN] Updated events map will match our expectations
-    result.mainStream.onReceive(this, [expectedChangedEventsCount](const PlaybackEventsMap& updatedEvents) {
-        EXPECT_EQ(updatedEvents.size(), expectedChangedEventsCount);
+    result.mainStream.onReceive(this, [expectedChangedEventsCount](const PlaybackEventsChunk& updatedEvents) {
+        EXPECT_FALSE(updatedEvents.replacesAll());
+        EXPECT_EQ(updatedEvents.from, 2000);
+        EXPECT_EQ(updatedEvents.to, 8500);
+        EXPECT_EQ(updatedEvents.events->size(), expectedChangedEventsCount);
     });
 
     // [WHEN] Notation has been changed on the 2-nd measure
@@ -540,7 +545,9 @@ TEST_F(PlaybackModelTests, Note_Entry_Playback_Note)
     const mu::mpe::NoteEvent& expectedEvent = std::get<mu::mpe::NoteEvent>(result.originEvents.at(firstNoteTimestamp).front());
 
     // [THEN] Triggered events map will match our expectations
-    result.offStream.onReceive(this, [firstNoteTimestamp, expectedEvent](const PlaybackEventsMap& triggeredEvents) {
+    result.offStream.onReceive(this, [firstNoteTimestamp, expectedEvent](const PlaybackEventsChunk& triggeredChunk) {
+        const PlaybackEventsMap& triggeredEvents = *triggeredChunk.events;
+
         EXPECT_EQ(triggeredEvents.size(), 1);
 
         const PlaybackEventList& eventList = triggeredEvents.at(firstNoteTimestamp);
@@ -604,7 +611,9 @@ TEST_F(PlaybackModelTests, Note_Entry_Playback_Chord)
     const PlaybackEventList& expectedEvents = result.originEvents.at(thirdChordTimestamp);
 
     // [THEN] Triggered events map will match our expectations
-    result.offStream.onReceive(this, [thirdChordTimestamp, expectedEvents](const PlaybackEventsMap& triggeredEvents) {
+    result.offStream.onReceive(this, [thirdChordTimestamp, expectedEvents](const PlaybackEventsChunk& triggeredChunk) {
+        const PlaybackEventsMap& triggeredEvents = *triggeredChunk.events;
+
         EXPECT_EQ(triggeredEvents.size(), 1);
 
         const PlaybackEventList& actualEvents = triggeredEvents.at(thirdChordTimestamp);
@@ -0,0 +1,113 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "infrastructure/internal/qfontmetricscache.h"
+
+using namespace mu;
+using namespace mu::draw;
+
+class QFontMetricsCacheTests : public ::testing::Test
+{
+public:
+    Font testFont() const
+    {
+        Font font(u"Edwin");
+        font.setPointSizeF(10.0);
+        return font;
+    }
+};
+
+/**
+ * @brief QFontMetricsCacheTests_LruEvictsLeastRecentlyUsed
+ * @details The LRU list keeps the recently accessed entries and drops the oldest one when it is full
+ */
+TEST_F(QFontMetricsCacheTests, LruEvictsLeastRecentlyUsed)
+{
+    // [GIVEN] A full LRU list with the capacity of 2
+    QFontMetricsCache::LruCache<String, double> cache(2);
+    cache.emplace(u"first", 1.0);
+    cache.emplace(u"second", 2.0);
+
+    // [WHEN] The first entry is accessed and a new one is added
+    EXPECT_TRUE(cache.find(u"first"));
+    cache.emplace(u"third", 3.0);
+
+    // [THEN] The second entry is dropped, since it was used least recently
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_FALSE(cache.find(u"second"));
+
+    ASSERT_TRUE(cache.find(u"first"));
+    EXPECT_EQ(*cache.find(u"first"), 1.0);
+    ASSERT_TRUE(cache.find(u"third"));
+    EXPECT_EQ(*cache.find(u"third"), 3.0);
+}
+
+/**
+ * @brief QFontMetricsCacheTests_CachedMetricsMatchQtMetrics
+ * @details The cached values are the same as the values returned by Qt for the same font
+ */
+TEST_F(QFontMetricsCacheTests, CachedMetricsMatchQtMetrics)
+{
+    // [GIVEN] A cache and a text font
+    QFontMetricsCache cache;
+    Font font = testFont();
+
+    const String syllable = u"Glo-";
+    const Char ch = u'g';
+
+    // [WHEN] The metrics are requested twice, so the second time they come from the cache
+    for (int i = 0; i < 2; ++i) {
+        QFontMetricsCache::FontData& data = cache.fontData(font);
+        const QFontMetricsF& qtMetrics = data.qtMetrics();
+
+        // [THEN] They match the Qt metrics
+        EXPECT_DOUBLE_EQ(data.lineSpacing(), qtMetrics.lineSpacing());
+        EXPECT_DOUBLE_EQ(data.ascent(), qtMetrics.ascent());
+        EXPECT_DOUBLE_EQ(data.horizontalAdvance(syllable), qtMetrics.horizontalAdvance(syllable.toQString()));
+        EXPECT_DOUBLE_EQ(data.horizontalAdvance(ch), qtMetrics.horizontalAdvance(QChar(ch.unicode())));
+        EXPECT_EQ(data.boundingRect(syllable), RectF::fromQRectF(qtMetrics.boundingRect(syllable.toQString())));
+        EXPECT_EQ(data.tightBoundingRect(syllable), RectF::fromQRectF(qtMetrics.tightBoundingRect(syllable.toQString())));
+    }
+}
+
+/**
+ * @brief QFontMetricsCacheTests_FontsWithDifferentStyleAreCachedSeparately
+ * @details A font which differs only by the style gets its own metrics
+ */
+TEST_F(QFontMetricsCacheTests, FontsWithDifferentStyleAreCachedSeparately)
+{
+    // [GIVEN] A cache and two fonts which differ only by italic
+    QFontMetricsCache cache;
+    Font font = testFont();
+    Font italicFont = testFont();
+    italicFont.setItalic(true);
+
+    // [WHEN] The metrics of both fonts are requested
+    const QFontMetricsCache::FontData* data = &cache.fontData(font);
+    const QFontMetricsCache::FontData* italicData = &cache.fontData(italicFont);
+
+    // [THEN] They are different entries, and the first one is still cached
+    EXPECT_NE(data, italicData);
+    EXPECT_EQ(&cache.fontData(font), data);
+}
@@ -0,0 +1,90 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+
+#include "libmscore/scorefont.h"
+
+namespace mu::engraving {
+class Engraving_ScoreFontTests : public ::testing::Test
+{
+};
+
+/**
+ * @brief Engraving_ScoreFontTests_MetricsCacheRoundTrip
+ * @details The metrics read back from the cache are the same as the metrics computed from the font and its metadata
+ */
+TEST_F(Engraving_ScoreFontTests, MetricsCacheRoundTrip)
+{
+    // [GIVEN] The freshly computed metrics of a font
+    ScoreFont* font = ScoreFont::fontByName(u"Leland");
+    ASSERT_TRUE(font);
+
+    ScoreFont computed(*font);
+    computed.m_symbols.assign(computed.m_symbols.size(), ScoreFont::Sym());
+    ASSERT_TRUE(computed.loadFontFace());
+
+    ScoreFont::EngravingDefaultValues computedDefaults;
+    ASSERT_TRUE(computed.computeAllMetrics(computedDefaults));
+    ASSERT_FALSE(computedDefaults.empty());
+
+    // [WHEN] The metrics are written to the cache and read back into another font
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    io::path_t cachePath = io::path_t(dir.path()) + "/Leland.metrics";
+    ByteArray sourceKey = computed.metricsSourceKey();
+    ASSERT_FALSE(sourceKey.empty());
+
+    computed.writeMetricsCache(cachePath, sourceKey, computedDefaults);
+
+    ScoreFont cached(*font);
+    cached.m_symbols.assign(cached.m_symbols.size(), ScoreFont::Sym());
+
+    ScoreFont::EngravingDefaultValues cachedDefaults;
+    ASSERT_TRUE(cached.readMetricsCache(cachePath, sourceKey, cachedDefaults));
+
+    // [THEN] Every symbol has the same code, bbox, advance, anchors and sub symbols
+    ASSERT_EQ(cached.m_symbols.size(), computed.m_symbols.size());
+
+    for (size_t id = 0; id < computed.m_symbols.size(); ++id) {
+        const ScoreFont::Sym& expected = computed.m_symbols.at(id);
+        const ScoreFont::Sym& actual = cached.m_symbols.at(id);
+
+        EXPECT_EQ(actual.code, expected.code) << "symbol: " << id;
+        EXPECT_EQ(actual.bbox, expected.bbox) << "symbol: " << id;
+        EXPECT_EQ(actual.advance, expected.advance) << "symbol: " << id;
+        EXPECT_EQ(actual.smuflAnchors, expected.smuflAnchors) << "symbol: " << id;
+        EXPECT_EQ(actual.subSymbolIds, expected.subSymbolIds) << "symbol: " << id;
+    }
+
+    // [THEN] The engraving defaults are the same as well
+    EXPECT_EQ(cachedDefaults, computedDefaults);
+
+    // [THEN] A cache written for other sources is not used
+    ByteArray otherKey("other sources");
+    ScoreFont::EngravingDefaultValues otherDefaults;
+    EXPECT_FALSE(cached.readMetricsCache(cachePath, otherKey, otherDefaults));
+}
+}
@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "libmscore/breath.h"
+#include "libmscore/factory.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/segment.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String IMPLODEEXP_DATA_DIR("implode_explode_data/");
+
+class SegmentTests : public ::testing::Test
+{
+};
+
+/**
+ * @brief SegmentTests_PreAppendedItemsTakeOccupiedTracksOnly
+ * @details Pre-appends an item to one track of a segment of a score with many staves,
+ *          only that track must take memory, not every track of the score
+ */
+TEST_F(SegmentTests, PreAppendedItemsTakeOccupiedTracksOnly)
+{
+    // [GIVEN] A score with many staves
+    MasterScore* score = ScoreRW::readScore(IMPLODEEXP_DATA_DIR + u"explode1.mscx");
+    ASSERT_TRUE(score);
+
+    const track_idx_t tracksCount = score->ntracks();
+    ASSERT_GE(tracksCount, 8 * VOICES);
+
+    Segment* segment = score->firstSegment(SegmentType::ChordRest);
+    ASSERT_TRUE(segment);
+
+    // [GIVEN] Nothing is pre-appended to the segment
+    for (track_idx_t track = 0; track < tracksCount; ++track) {
+        ASSERT_FALSE(segment->preAppendedItem(static_cast<int>(track)));
+    }
+
+    const size_t usageBefore = segment->memoryUsage();
+
+    // [WHEN] Pre-append an item to the last track
+    const int lastTrack = static_cast<int>(tracksCount - 1);
+    Breath* item = Factory::createBreath(segment);
+    segment->preAppend(item, lastTrack);
+
+    // [THEN] The item is pre-appended to that track only
+    EXPECT_EQ(segment->preAppendedItem(lastTrack), item);
+    for (int track = 0; track < lastTrack; ++track) {
+        EXPECT_FALSE(segment->preAppendedItem(track));
+    }
+
+    // [THEN] The segment grew by less than a pointer per track of the score
+    const size_t usageAfter = segment->memoryUsage();
+    EXPECT_GT(usageAfter, usageBefore);
+    EXPECT_LT(usageAfter - usageBefore, tracksCount * sizeof(EngravingItem*));
+
+    // [WHEN] Clear it
+    segment->clearPreAppended(lastTrack);
+
+    // [THEN] The segment doesn't keep it
+    EXPECT_FALSE(segment->preAppendedItem(lastTrack));
+
+    delete item;
+    delete score;
+}
@@ -20,6 +20,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 #include "libmscore/masterscore.h"
@@ -201,3 +203,47 @@ TEST_F(SelectionRangeDeleteTests, deleteSkipAnnotations)
                                             SELRANGEDELETE_DATA_DIR + String(u"selectionrangedelete05-ref.mscx")));
     delete score;
 }
+
+TEST_F(SelectionRangeDeleteTests, updateChangedSelectedElements)
+{
+    MasterScore* score = ScoreRW::readScore(SELRANGEDELETE_DATA_DIR + String(u"selectionrangedelete01.mscx"));
+    EXPECT_TRUE(score);
+
+    score->doLayout();
+    score->cmdSelectAll();
+
+    auto expectRescanned = [score]() {
+        std::vector<EngravingItem*> refreshed = score->selection().elements();
+        score->selection().updateSelectedElements();
+        std::vector<EngravingItem*> rescanned = score->selection().elements();
+        std::sort(refreshed.begin(), refreshed.end());
+        std::sort(rescanned.begin(), rescanned.end());
+        EXPECT_EQ(refreshed, rescanned);
+        for (EngravingItem* e : rescanned) {
+            EXPECT_TRUE(e->selected());
+        }
+    };
+
+    // a change inside a slur only refreshes the elements of its measure and the overlapping spanners
+    size_t incrementalUpdates = score->selection().incrementalUpdatesCount();
+    score->startCmd();
+    score->deleteItem(chordRestAtBeat(score, 1));
+    score->endCmd();
+    EXPECT_GT(score->selection().incrementalUpdatesCount(), incrementalUpdates);
+    expectRescanned();
+
+    incrementalUpdates = score->selection().incrementalUpdatesCount();
+    score->startCmd();
+    score->deleteItem(chordRestAtBeat(score, 3, 1));
+    score->endCmd();
+    EXPECT_GT(score->selection().incrementalUpdatesCount(), incrementalUpdates);
+    expectRescanned();
+
+    // undo has no current macro, the selection is rescanned completely
+    incrementalUpdates = score->selection().incrementalUpdatesCount();
+    score->undoRedo(true, 0);
+    EXPECT_EQ(score->selection().incrementalUpdatesCount(), incrementalUpdates);
+    expectRescanned();
+
+    delete score;
+}
@@ -0,0 +1,149 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "libmscore/shape.h"
+#include "libmscore/skyline.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+class SkylineTests : public ::testing::Test
+{
+public:
+    std::vector<RectF> randomRects(std::mt19937& random, size_t count) const
+    {
+        std::uniform_real_distribution<double> x(-5.0, 100.0);
+        std::uniform_real_distribution<double> y(-10.0, 10.0);
+        std::uniform_real_distribution<double> size(0.0, 8.0);
+
+        std::vector<RectF> rects;
+        for (size_t i = 0; i < count; ++i) {
+            //! NOTE Some zero width rectangles, as the bounding boxes of lines can be
+            double width = (i % 10 == 0) ? 0.0 : size(random);
+            rects.emplace_back(x(random), y(random), width, size(random));
+        }
+        return rects;
+    }
+
+    Skyline addedSkyline(const std::vector<RectF>& rects) const
+    {
+        Skyline skyline;
+        for (const RectF& r : rects) {
+            skyline.add(r);
+        }
+        return skyline;
+    }
+
+    Skyline builtSkyline(const std::vector<RectF>& rects) const
+    {
+        Skyline skyline;
+        skyline.build(rects);
+        return skyline;
+    }
+};
+
+/**
+ * @brief SkylineTests_BuildMatchesAdd
+ * @details Checks that a skyline built from all the rectangles at once keeps the same outline
+ *          as one made by adding the rectangles one by one
+ */
+TEST_F(SkylineTests, BuildMatchesAdd)
+{
+    std::mt19937 random(42);
+
+    for (int i = 0; i < 100; ++i) {
+        // [GIVEN] Two sets of rectangles in random order
+        std::vector<RectF> upperRects = randomRects(random, 1 + i * 3);
+        std::vector<RectF> lowerRects = randomRects(random, 1 + i * 2);
+        for (RectF& r : lowerRects) {
+            r.translate(0.0, 20.0);
+        }
+
+        // [WHEN] The skylines are made by adding the rectangles one by one and by building them at once
+        Skyline addedUpper = addedSkyline(upperRects);
+        Skyline addedLower = addedSkyline(lowerRects);
+        Skyline builtUpper = builtSkyline(upperRects);
+        Skyline builtLower = builtSkyline(lowerRects);
+
+        // [THEN] The distances and extents are the same
+        double distance = addedUpper.minDistance(addedLower);
+        EXPECT_DOUBLE_EQ(builtUpper.minDistance(builtLower), distance);
+        EXPECT_DOUBLE_EQ(builtUpper.minDistance(addedLower), distance);
+        EXPECT_DOUBLE_EQ(addedUpper.minDistance(builtLower), distance);
+
+        EXPECT_DOUBLE_EQ(builtUpper.north().max(), addedUpper.north().max());
+        EXPECT_DOUBLE_EQ(builtUpper.south().max(), addedUpper.south().max());
+    }
+}
+
+/**
+ * @brief SkylineTests_BuildEmpty
+ * @details Checks that building a skyline without rectangles clears it
+ */
+TEST_F(SkylineTests, BuildEmpty)
+{
+    // [GIVEN] A skyline with a rectangle
+    Skyline skyline;
+    skyline.add(RectF(0.0, 0.0, 10.0, 4.0));
+    EXPECT_TRUE(skyline.north().valid());
+
+    // [WHEN] It is built from no rectangles
+    skyline.build({});
+
+    // [THEN] It is empty
+    EXPECT_FALSE(skyline.north().valid());
+    EXPECT_FALSE(skyline.south().valid());
+}
+
+/**
+ * @brief SkylineTests_AddMovedShape
+ * @details Checks that adding a shape moved by an offset gives the same outline as adding its translated copy
+ */
+TEST_F(SkylineTests, AddMovedShape)
+{
+    std::mt19937 random(7);
+
+    // [GIVEN] A shape and an offset
+    Shape shape;
+    for (const RectF& r : randomRects(random, 50)) {
+        shape.add(r);
+    }
+    const PointF pos(12.5, -3.0);
+
+    // [WHEN] The shape is added moved by the offset and as a translated copy
+    Skyline moved;
+    moved.add(shape, pos);
+
+    Skyline translated;
+    translated.add(shape.translated(pos));
+
+    // [THEN] The outlines are the same
+    Skyline lower = addedSkyline({ RectF(0.0, 30.0, 200.0, 4.0) });
+    EXPECT_DOUBLE_EQ(moved.minDistance(lower), translated.minDistance(lower));
+    EXPECT_DOUBLE_EQ(moved.north().max(), translated.north().max());
+    EXPECT_DOUBLE_EQ(moved.south().max(), translated.south().max());
+}
@@ -0,0 +1,95 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/mscore.h"
+#include "libmscore/segment.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+class SystemJustificationTests : public ::testing::Test
+{
+public:
+    struct MeasureSpacing {
+        double width = 0.0;
+        std::vector<double> segmentsX;
+    };
+
+    std::vector<MeasureSpacing> layoutSpacing(MasterScore* score, bool noSpacingCache) const
+    {
+        MScore::noSpacingCache = noSpacingCache;
+        score->doLayout();
+        MScore::noSpacingCache = false;
+
+        std::vector<MeasureSpacing> spacing;
+        for (Measure* measure = score->firstMeasure(); measure; measure = measure->nextMeasure()) {
+            MeasureSpacing measureSpacing;
+            measureSpacing.width = measure->width();
+            for (Segment* segment = measure->first(); segment; segment = segment->next()) {
+                measureSpacing.segmentsX.push_back(segment->x());
+            }
+            spacing.push_back(std::move(measureSpacing));
+        }
+
+        return spacing;
+    }
+};
+
+/**
+ * @brief SystemJustificationTests_SpacingCacheKeepsLayout
+ * @details Lays out a score with many rhythms once computing the distances between
+ *          the segments on every justification step and once with the measures caching them,
+ *          the widths of the measures and the positions of the segments must be the same
+ */
+TEST_F(SystemJustificationTests, SpacingCacheKeepsLayout)
+{
+    // [GIVEN] A score with many rhythms
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    // [WHEN] Lay it out without and with the spacing cache
+    std::vector<MeasureSpacing> uncached = layoutSpacing(score, true);
+    std::vector<MeasureSpacing> cached = layoutSpacing(score, false);
+
+    // [THEN] The spacing is the same
+    ASSERT_EQ(uncached.size(), cached.size());
+    for (size_t i = 0; i < cached.size(); ++i) {
+        EXPECT_NEAR(uncached[i].width, cached[i].width, 0.001) << "measure " << i;
+
+        ASSERT_EQ(uncached[i].segmentsX.size(), cached[i].segmentsX.size());
+        for (size_t j = 0; j < cached[i].segmentsX.size(); ++j) {
+            EXPECT_NEAR(uncached[i].segmentsX[j], cached[i].segmentsX[j], 0.001) << "measure " << i << ", segment " << j;
+        }
+    }
+
+    delete score;
+}
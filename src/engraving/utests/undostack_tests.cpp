@@ -0,0 +1,263 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/undo.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+class UndoStackTests : public ::testing::Test
+{
+public:
+    void changeStretch(MasterScore* score, Measure* measure, double stretch)
+    {
+        score->startCmd();
+        measure->undoChangeProperty(Pid::USER_STRETCH, stretch);
+        score->endCmd();
+    }
+};
+
+/**
+ * @brief UndoStackTests_MemoryBudgetDropsOldestMacros
+ * @details When the undo history uses more memory than the budget, the oldest macros are dropped
+ *          and the newest ones can still be undone
+ */
+TEST_F(UndoStackTests, MemoryBudgetDropsOldestMacros)
+{
+    // [GIVEN] A score with one change in the undo history
+    MasterScore* score = ScoreRW::readScore(u"test.mscx");
+    ASSERT_TRUE(score);
+
+    Measure* measure = score->firstMeasure();
+    ASSERT_TRUE(measure);
+
+    UndoStack* undoStack = score->undoStack();
+    undoStack->setMemoryBudget(0);
+
+    changeStretch(score, measure, 1.1);
+
+    size_t macroMemoryUsage = undoStack->memoryUsage();
+    EXPECT_GT(macroMemoryUsage, 0u);
+
+    // [WHEN] The budget fits about three such changes and ten more are done
+    undoStack->setMemoryBudget(macroMemoryUsage * 3);
+
+    for (int i = 0; i < 10; ++i) {
+        changeStretch(score, measure, 1.2 + i * 0.1);
+    }
+
+    // [THEN] The history fits the budget, the dropped macros are still counted by the index
+    EXPECT_LE(undoStack->memoryUsage(), macroMemoryUsage * 3);
+    EXPECT_LE(undoStack->macrosMemoryUsage().size(), 3u);
+    EXPECT_EQ(undoStack->getCurIdx(), 11u);
+
+    // [THEN] The last change can be undone
+    ASSERT_TRUE(undoStack->canUndo());
+    undoStack->undo(nullptr);
+    EXPECT_DOUBLE_EQ(measure->userStretch(), 2.0);
+
+    delete score;
+}
+
+/**
+ * @brief UndoStackTests_NoBudgetKeepsAllMacros
+ * @details Without a budget the whole history is kept
+ */
+TEST_F(UndoStackTests, NoBudgetKeepsAllMacros)
+{
+    // [GIVEN] A score without a budget for the undo history
+    MasterScore* score = ScoreRW::readScore(u"test.mscx");
+    ASSERT_TRUE(score);
+
+    Measure* measure = score->firstMeasure();
+    ASSERT_TRUE(measure);
+
+    UndoStack* undoStack = score->undoStack();
+    undoStack->setMemoryBudget(0);
+
+    // [WHEN] Ten changes are done
+    for (int i = 0; i < 10; ++i) {
+        changeStretch(score, measure, 1.1 + i * 0.1);
+    }
+
+    // [THEN] All of them are in the history, once each, and there is nothing to redo
+    EXPECT_EQ(undoStack->macrosMemoryUsage().size(), 10u);
+    EXPECT_EQ(undoStack->getCurIdx(), 10u);
+    EXPECT_FALSE(undoStack->canRedo());
+
+    // [THEN] All of them can be undone and redone
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(undoStack->canUndo());
+        undoStack->undo(nullptr);
+    }
+    EXPECT_FALSE(undoStack->canUndo());
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(undoStack->canRedo());
+        undoStack->redo(nullptr);
+    }
+    EXPECT_FALSE(undoStack->canRedo());
+    EXPECT_DOUBLE_EQ(measure->userStretch(), 2.0);
+
+    delete score;
+}
+
+/**
+ * @brief UndoStackTests_MemoryBudgetKeepsLastMacro
+ * @details When the budget is set with undone macros in the history, the redo macros are dropped too,
+ *          but the macro of the last action is kept and can be undone
+ */
+TEST_F(UndoStackTests, MemoryBudgetKeepsLastMacro)
+{
+    // [GIVEN] A score with five changes, three of them undone
+    MasterScore* score = ScoreRW::readScore(u"test.mscx");
+    ASSERT_TRUE(score);
+
+    Measure* measure = score->firstMeasure();
+    ASSERT_TRUE(measure);
+
+    UndoStack* undoStack = score->undoStack();
+    undoStack->setMemoryBudget(0);
+
+    for (int i = 0; i < 5; ++i) {
+        changeStretch(score, measure, 1.1 + i * 0.1);
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        undoStack->undo(nullptr);
+    }
+    EXPECT_DOUBLE_EQ(measure->userStretch(), 1.2);
+
+    // [WHEN] A budget smaller than one macro is set
+    undoStack->setMemoryBudget(1);
+
+    // [THEN] Only the macro of the last action is left
+    EXPECT_EQ(undoStack->macrosMemoryUsage().size(), 1u);
+    EXPECT_EQ(undoStack->getCurIdx(), 2u);
+    EXPECT_FALSE(undoStack->canRedo());
+
+    // [THEN] It can be undone and redone
+    ASSERT_TRUE(undoStack->canUndo());
+    undoStack->undo(nullptr);
+    EXPECT_DOUBLE_EQ(measure->userStretch(), 1.1);
+    EXPECT_FALSE(undoStack->canUndo());
+
+    ASSERT_TRUE(undoStack->canRedo());
+    undoStack->redo(nullptr);
+    EXPECT_DOUBLE_EQ(measure->userStretch(), 1.2);
+
+    delete score;
+}
+
+/**
+ * @brief UndoStackTests_ChangesAppendedToLastMacroAreUndoneWithIt
+ * @details The changes made outside of a command (e.g. by a deferred layout) can be recorded into the last macro,
+ *          they don't add an undo state and are undone together with that macro
+ */
+TEST_F(UndoStackTests, ChangesAppendedToLastMacroAreUndoneWithIt)
+{
+    // [GIVEN] A saved score with one change
+    MasterScore* score = ScoreRW::readScore(u"test.mscx");
+    ASSERT_TRUE(score);
+
+    Measure* measure = score->firstMeasure();
+    ASSERT_TRUE(measure);
+
+    UndoStack* undoStack = score->undoStack();
+    undoStack->setMemoryBudget(0);
+
+    double originalStretch = measure->userStretch();
+
+    // [THEN] There is nothing to append to yet
+    EXPECT_FALSE(undoStack->beginAppendingToLast(nullptr));
+
+    changeStretch(score, measure, 1.1);
+    undoStack->setClean();
+
+    // [WHEN] A change is made outside of a command and appended to the last macro
+    ASSERT_TRUE(undoStack->beginAppendingToLast(undoStack->last()));
+    measure->undoChangeProperty(Pid::USER_STRETCH, 1.5);
+    undoStack->endAppendingToLast();
+
+    // [THEN] It's applied without a new undo state
+    EXPECT_DOUBLE_EQ(measure->userStretch(), 1.5);
+    EXPECT_EQ(undoStack->macrosMemoryUsage().size(), 1u);
+    EXPECT_EQ(undoStack->getCurIdx(), 1u);
+    EXPECT_TRUE(undoStack->isClean());
+
+    // [THEN] It's undone and redone together with the last macro
+    undoStack->undo(nullptr);
+    EXPECT_DOUBLE_EQ(measure->userStretch(), originalStretch);
+    EXPECT_FALSE(undoStack->canUndo());
+
+    undoStack->redo(nullptr);
+    EXPECT_DOUBLE_EQ(measure->userStretch(), 1.5);
+
+    delete score;
+}
+
+/**
+ * @brief UndoStackTests_AppendingToUndoneMacroKeepsRedoStack
+ * @details The changes can only be appended to the macro which is still the last one:
+ *          after undo nothing is appended and the redo history is kept
+ */
+TEST_F(UndoStackTests, AppendingToUndoneMacroKeepsRedoStack)
+{
+    // [GIVEN] A score with two changes
+    MasterScore* score = ScoreRW::readScore(u"test.mscx");
+    ASSERT_TRUE(score);
+
+    Measure* measure = score->firstMeasure();
+    ASSERT_TRUE(measure);
+
+    UndoStack* undoStack = score->undoStack();
+    undoStack->setMemoryBudget(0);
+
+    changeStretch(score, measure, 1.1);
+    const UndoMacro* firstMacro = undoStack->last();
+
+    changeStretch(score, measure, 1.2);
+    const UndoMacro* secondMacro = undoStack->last();
+
+    // [THEN] Nothing is appended to a macro which isn't the last one
+    EXPECT_FALSE(undoStack->beginAppendingToLast(firstMacro));
+
+    // [WHEN] The last change is undone
+    undoStack->undo(nullptr);
+
+    // [THEN] Nothing is appended either to the undone macro or to the new last one, as there is something to redo
+    EXPECT_FALSE(undoStack->beginAppendingToLast(secondMacro));
+    EXPECT_FALSE(undoStack->beginAppendingToLast(firstMacro));
+
+    // [THEN] The redo history is kept
+    ASSERT_TRUE(undoStack->canRedo());
+    undoStack->redo(nullptr);
+    EXPECT_DOUBLE_EQ(measure->userStretch(), 1.2);
+
+    delete score;
+}
@@ -25,6 +25,9 @@
 
 #include <map>
 #include <set>
+#include <functional>
+#include <utility>
+#include <vector>
 
 #include "async/asyncable.h"
 #include "async/channel.h"
@@ -38,12 +41,20 @@ template<class EventType>
 class AbstractEventSequencer : public async::Asyncable
 {
 public:
-    using EventSequence = std::set<EventType>;
+    //! Lets the owner synchronize the incoming changes with its own processing, e.g. rendering on another thread
+    using ChangesHandler = std::function<void(const msecs_t changedFrom, const std::function<void()>& applyChanges)>;
+
+    //! NOTE A multiset, as different origin events may produce equal events at the same time,
+    //! and replacing the events of one of them must keep those of the others
+    using EventSequence = std::multiset<EventType>;
     using EventSequenceMap = std::map<msecs_t, EventSequence>;
 
     typedef typename EventSequenceMap::const_iterator SequenceIterator;
     typedef typename EventSequence::const_iterator EventIterator;
 
+    //! NOTE The sequence and the position in it of each event produced by an origin event
+    using ProducedEvents = std::vector<std::pair<typename EventSequenceMap::iterator, typename EventSequence::iterator> >;
+
     virtual ~AbstractEventSequencer()
     {
         m_mainStreamChanges.resetOnReceive(this);
@@ -59,26 +70,73 @@ public:
         m_offStreamChanges = data.offStream;
         m_dynamicLevelChanges = data.dynamicLevelChanges;
 
-        m_offStreamChanges.onReceive(this, [this](const mpe::PlaybackEventsMap& changes) {
-            updateOffStreamEvents(changes);
+        m_offStreamChanges.onReceive(this, [this](const mpe::PlaybackEventsChunk& changes) {
+            handleChanges(changes.from, [this, &changes]() {
+                updateOffStreamEvents(changes);
+            });
         });
 
-        m_mainStreamChanges.onReceive(this, [this](const mpe::PlaybackEventsMap& changes) {
-            updateMainStreamEvents(changes);
+        m_mainStreamChanges.onReceive(this, [this](const mpe::PlaybackEventsChunk& changes) {
+            handleChanges(changes.from, [this, &changes]() {
+                updateMainStreamEvents(changes);
+            });
         });
 
         m_dynamicLevelChanges.onReceive(this, [this](const mpe::DynamicLevelMap& changes) {
-            updateDynamicChanges(changes);
+            handleChanges(mpe::PlaybackEventsChunk::MIN_TIMESTAMP, [this, &changes]() {
+                updateDynamicChanges(changes);
+            });
         });
 
-        updateMainStreamEvents(data.originEvents);
+        m_mainStreamEvents.clear();
+        m_mainStreamEventsBySource.clear();
+        insertMainStreamEvents(data.originEvents.cbegin(), data.originEvents.cend());
+        updateMainSequenceIterator();
+
         updateDynamicChanges(data.dynamicLevelMap);
     }
 
-    virtual void updateOffStreamEvents(const mpe::PlaybackEventsMap& changes) = 0;
-    virtual void updateMainStreamEvents(const mpe::PlaybackEventsMap& changes) = 0;
+    void updateOffStreamEvents(const mpe::PlaybackEventsChunk& changes)
+    {
+        m_offStreamEvents.clear();
+
+        if (changes.events) {
+            for (const auto& pair : *changes.events) {
+                convertPlaybackEvents(m_offStreamEvents, pair.second);
+            }
+        }
+
+        updateOffSequenceIterator();
+    }
+
+    void updateMainStreamEvents(const mpe::PlaybackEventsChunk& changes)
+    {
+        //!Note Only the events produced by the changed range are being replaced,
+        //!     everything else stays untouched
+        auto lowerBound = m_mainStreamEventsBySource.lower_bound(changes.from);
+        auto upperBound = m_mainStreamEventsBySource.upper_bound(changes.to);
+
+        for (auto it = lowerBound; it != upperBound; ++it) {
+            eraseMainStreamEvents(it->second);
+        }
+
+        m_mainStreamEventsBySource.erase(lowerBound, upperBound);
+
+        if (changes.events) {
+            insertMainStreamEvents(changes.events->cbegin(), changes.events->cend());
+        }
+
+        updateMainSequenceIterator();
+    }
+
+    virtual void convertPlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventList& events) = 0;
     virtual void updateDynamicChanges(const mpe::DynamicLevelMap& changes) = 0;
 
+    void setChangesHandler(ChangesHandler handler)
+    {
+        m_changesHandler = std::move(handler);
+    }
+
     void setActive(const bool active)
     {
         m_isActive = active;
@@ -91,7 +149,7 @@ public:
 
     void setPlaybackPosition(const msecs_t newPlaybackPosition)
     {
-        ONLY_AUDIO_WORKER_THREAD;
+        ONLY_AUDIO_RENDER_THREAD;
 
         m_playbackPosition = newPlaybackPosition;
         resetAllIterators();
@@ -99,16 +157,17 @@ public:
 
     msecs_t playbackPosition() const
     {
-        ONLY_AUDIO_WORKER_THREAD;
+        ONLY_AUDIO_RENDER_THREAD;
 
         return m_playbackPosition;
     }
 
     const EventSequence& eventsToBePlayed(const msecs_t nextMsecs)
     {
-        ONLY_AUDIO_WORKER_THREAD;
+        ONLY_AUDIO_RENDER_THREAD;
 
-        static EventSequence result;
+        //! NOTE Not a static, since the sequencers might be used from several rendering threads at the same time
+        EventSequence& result = m_eventsToBePlayed;
 
         result.clear();
 
@@ -130,6 +189,46 @@ public:
     }
 
 protected:
+    void handleChanges(const msecs_t changedFrom, const std::function<void()>& applyChanges)
+    {
+        if (m_changesHandler) {
+            m_changesHandler(changedFrom, applyChanges);
+        } else {
+            applyChanges();
+        }
+    }
+
+    void insertMainStreamEvents(mpe::PlaybackEventsMap::const_iterator from, mpe::PlaybackEventsMap::const_iterator to)
+    {
+        EventSequenceMap produced;
+
+        for (auto it = from; it != to; ++it) {
+            produced.clear();
+            convertPlaybackEvents(produced, it->second);
+
+            ProducedEvents& producedRefs = m_mainStreamEventsBySource[it->first];
+            for (const auto& pair : produced) {
+                auto sequenceIt = m_mainStreamEvents.try_emplace(pair.first).first;
+                for (const EventType& event : pair.second) {
+                    producedRefs.emplace_back(sequenceIt, sequenceIt->second.insert(event));
+                }
+            }
+        }
+    }
+
+    void eraseMainStreamEvents(const ProducedEvents& events)
+    {
+        //! NOTE The iterators of the other events stay valid, a sequence is removed with its last event
+        for (const auto& pair : events) {
+            auto sequenceIt = pair.first;
+            sequenceIt->second.erase(pair.second);
+
+            if (sequenceIt->second.empty()) {
+                m_mainStreamEvents.erase(sequenceIt);
+            }
+        }
+    }
+
     void resetAllIterators()
     {
         updateMainSequenceIterator();
@@ -152,6 +251,16 @@ protected:
         m_currentDynamicsIt = m_dynamicEvents.lower_bound(m_playbackPosition);
     }
 
+    //! NOTE Equal events (e.g. of several origin events) are played once
+    static void appendUnique(EventSequence& result, const EventSequence& events)
+    {
+        for (EventIterator it = events.cbegin(); it != events.cend(); it = events.upper_bound(*it)) {
+            if (result.find(*it) == result.cend()) {
+                result.insert(*it);
+            }
+        }
+    }
+
     void handleOffStream(EventSequence& result)
     {
         if (m_offStreamEvents.empty()) {
@@ -159,7 +268,7 @@ protected:
         }
 
         if (m_currentOffSequenceIt != m_offStreamEvents.cend()) {
-            result = m_currentOffSequenceIt->second;
+            appendUnique(result, m_currentOffSequenceIt->second);
             m_currentOffSequenceIt = m_offStreamEvents.erase(m_currentOffSequenceIt);
         }
     }
@@ -167,8 +276,7 @@ protected:
     void handleMainStream(EventSequence& result)
     {
         if (m_currentMainSequenceIt->first <= m_playbackPosition) {
-            result.insert(m_currentMainSequenceIt->second.cbegin(),
-                          m_currentMainSequenceIt->second.cend());
+            appendUnique(result, m_currentMainSequenceIt->second);
 
             m_currentMainSequenceIt = std::next(m_currentMainSequenceIt);
         }
@@ -181,8 +289,7 @@ protected:
         }
 
         if (m_currentDynamicsIt->first <= m_playbackPosition) {
-            result.insert(m_currentDynamicsIt->second.cbegin(),
-                          m_currentDynamicsIt->second.cend());
+            appendUnique(result, m_currentDynamicsIt->second);
 
             m_currentDynamicsIt = std::next(m_currentDynamicsIt);
         }
@@ -198,8 +305,15 @@ protected:
     EventSequenceMap m_offStreamEvents;
     EventSequenceMap m_dynamicEvents;
 
+    //! events produced by every timestamp of the origin events, needed to splice the changed ranges in.
+    //! They point into m_mainStreamEvents, not to copies of the events
+    std::map<mpe::timestamp_t, ProducedEvents> m_mainStreamEventsBySource;
+
     bool m_isActive = false;
 
+    ChangesHandler m_changesHandler;
+    EventSequence m_eventsToBePlayed;
+
     mpe::PlaybackEventsChanges m_mainStreamChanges;
     mpe::PlaybackEventsChanges m_offStreamChanges;
     mpe::DynamicLevelChanges m_dynamicLevelChanges;
@@ -70,18 +70,19 @@ void AbstractSynthesizer::setupEvents(const mpe::PlaybackData& playbackData)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
-    loadMainStreamEvents(playbackData.originEvents);
+    loadMainStreamEvents(PlaybackEventsChunk(playbackData.originEvents, PlaybackEventsChunk::MIN_TIMESTAMP,
+                                             PlaybackEventsChunk::MAX_TIMESTAMP));
     m_mainStreamChanges = playbackData.mainStream;
     m_offStreamChanges = playbackData.offStream;
 
     loadDynamicLevelChanges(playbackData.dynamicLevelMap);
     m_dynamicLevelChanges = playbackData.dynamicLevelChanges;
 
-    m_mainStreamChanges.onReceive(this, [this](const PlaybackEventsMap& updatedEvents) {
+    m_mainStreamChanges.onReceive(this, [this](const PlaybackEventsChunk& updatedEvents) {
         loadMainStreamEvents(updatedEvents);
     });
 
-    m_offStreamChanges.onReceive(this, [this](const PlaybackEventsMap& triggeredEvents) {
+    m_offStreamChanges.onReceive(this, [this](const PlaybackEventsChunk& triggeredEvents) {
         loadOffStreamEvents(triggeredEvents);
     });
 
@@ -90,16 +91,18 @@ void AbstractSynthesizer::setupEvents(const mpe::PlaybackData& playbackData)
     });
 }
 
-void AbstractSynthesizer::loadMainStreamEvents(const mpe::PlaybackEventsMap& updatedEvents)
+void AbstractSynthesizer::loadMainStreamEvents(const mpe::PlaybackEventsChunk& updatedEvents)
 {
-    m_mainStreamEvents.clear();
-    m_mainStreamEvents.load(updatedEvents);
+    m_mainStreamEvents.splice(updatedEvents);
 }
 
-void AbstractSynthesizer::loadOffStreamEvents(const mpe::PlaybackEventsMap& updatedEvents)
+void AbstractSynthesizer::loadOffStreamEvents(const mpe::PlaybackEventsChunk& updatedEvents)
 {
     m_offStreamEvents.clear();
-    m_offStreamEvents.load(updatedEvents);
+
+    if (updatedEvents.events) {
+        m_offStreamEvents.load(*updatedEvents.events);
+    }
 }
 
 void AbstractSynthesizer::loadDynamicLevelChanges(const mpe::DynamicLevelMap& updatedDynamicLevelMap)
@@ -73,17 +73,27 @@ protected:
 
         void load(const mpe::PlaybackEventsMap& events)
         {
-            for (const auto& pair : events) {
-                for (const mpe::PlaybackEvent& event : pair.second) {
-                    if (!std::holds_alternative<mpe::NoteEvent>(event)) {
-                        continue;
-                    }
+            insert(events.cbegin(), events.cend());
+            updateBoundaries();
+        }
 
-                    mpe::timestamp_t actualTimestamp = std::get<mpe::NoteEvent>(event).arrangementCtx().actualTimestamp;
+        void splice(const mpe::PlaybackEventsChunk& chunk)
+        {
+            auto lowerBound = m_actualTimestampsBySource.lower_bound(chunk.from);
+            auto upperBound = m_actualTimestampsBySource.upper_bound(chunk.to);
 
-                    m_events[actualTimestamp].emplace_back(event);
+            for (auto it = lowerBound; it != upperBound; ++it) {
+                for (const mpe::timestamp_t actualTimestamp : it->second) {
+                    eraseFromSourceRange(actualTimestamp, chunk.from, chunk.to);
                 }
             }
+
+            m_actualTimestampsBySource.erase(lowerBound, upperBound);
+
+            if (chunk.events) {
+                insert(chunk.events->cbegin(), chunk.events->cend());
+            }
+
             updateBoundaries();
         }
 
@@ -112,6 +122,8 @@ protected:
         void clear()
         {
             m_events.clear();
+            m_sourceTimestamps.clear();
+            m_actualTimestampsBySource.clear();
             updateBoundaries();
         }
 
@@ -122,6 +134,51 @@ protected:
 
     private:
 
+        void insert(mpe::PlaybackEventsMap::const_iterator from, mpe::PlaybackEventsMap::const_iterator to)
+        {
+            for (auto it = from; it != to; ++it) {
+                for (const mpe::PlaybackEvent& event : it->second) {
+                    if (!std::holds_alternative<mpe::NoteEvent>(event)) {
+                        continue;
+                    }
+
+                    mpe::timestamp_t actualTimestamp = std::get<mpe::NoteEvent>(event).arrangementCtx().actualTimestamp;
+
+                    m_events[actualTimestamp].emplace_back(event);
+                    m_sourceTimestamps[actualTimestamp].push_back(it->first);
+                    m_actualTimestampsBySource[it->first].insert(actualTimestamp);
+                }
+            }
+        }
+
+        void eraseFromSourceRange(const mpe::timestamp_t actualTimestamp, const mpe::timestamp_t sourceFrom,
+                                  const mpe::timestamp_t sourceTo)
+        {
+            auto eventsIt = m_events.find(actualTimestamp);
+            auto sourcesIt = m_sourceTimestamps.find(actualTimestamp);
+
+            if (eventsIt == m_events.end() || sourcesIt == m_sourceTimestamps.end()) {
+                return;
+            }
+
+            mpe::PlaybackEventList& events = eventsIt->second;
+            std::vector<mpe::timestamp_t>& sources = sourcesIt->second;
+
+            for (size_t i = sources.size(); i > 0; --i) {
+                if (sources[i - 1] < sourceFrom || sources[i - 1] > sourceTo) {
+                    continue;
+                }
+
+                events.erase(events.begin() + (i - 1));
+                sources.erase(sources.begin() + (i - 1));
+            }
+
+            if (events.empty()) {
+                m_events.erase(eventsIt);
+                m_sourceTimestamps.erase(sourcesIt);
+            }
+        }
+
         void updateBoundaries()
         {
             if (empty()) {
@@ -150,12 +207,17 @@ protected:
         }
 
         mpe::PlaybackEventsMap m_events;
+
+        //! timestamps of the origin events, which the stored events came from,
+        //! so that a changed range can be replaced without touching the rest
+        std::map<mpe::timestamp_t, std::vector<mpe::timestamp_t>> m_sourceTimestamps;
+        std::map<mpe::timestamp_t, std::set<mpe::timestamp_t>> m_actualTimestampsBySource;
     };
 
     virtual void setupSound(const mpe::PlaybackSetupData& setupData) = 0;
     virtual void setupEvents(const mpe::PlaybackData& playbackData);
-    virtual void loadMainStreamEvents(const mpe::PlaybackEventsMap& updatedEvents);
-    virtual void loadOffStreamEvents(const mpe::PlaybackEventsMap& updatedEvents);
+    virtual void loadMainStreamEvents(const mpe::PlaybackEventsChunk& updatedEvents);
+    virtual void loadOffStreamEvents(const mpe::PlaybackEventsChunk& updatedEvents);
     virtual void loadDynamicLevelChanges(const mpe::DynamicLevelMap& updatedDynamicLevelMap);
 
     msecs_t samplesToMsecs(const samples_t samplesPerChannel, const samples_t sampleRate) const;
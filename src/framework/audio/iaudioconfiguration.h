@@ -52,10 +52,13 @@ public:
 
     // synthesizers
     virtual AudioInputParams defaultAudioInputParams() const = 0;
+    virtual msecs_t synthesizerLookAheadMsecs() const = 0; // 0 means the look-ahead rendering is off
     virtual io::paths_t soundFontDirectories() const = 0;
     virtual io::paths_t userSoundFontDirectories() const = 0;
     virtual void setUserSoundFontDirectories(const io::paths_t& paths) = 0;
     virtual async::Channel<io::paths_t> soundFontDirectoriesChanged() const = 0;
+    virtual io::path_t soundFontSamplesCachePath() const = 0;
+    virtual size_t unusedSoundFontSamplesBudget() const = 0; // bytes of the decoded samples kept mapped after their presets are unselected
 
     virtual const synth::SynthesizerState& synthesizerState() const = 0;
     virtual Ret saveSynthesizerState(const synth::SynthesizerState& state) = 0;
@@ -42,6 +42,8 @@ static const audioch_t AUDIO_CHANNELS = 2;
 static const Settings::Key AUDIO_API_KEY("audio", "io/audioApi");
 static const Settings::Key AUDIO_OUTPUT_DEVICE_ID_KEY("audio", "io/outputDevice");
 static const Settings::Key AUDIO_BUFFER_SIZE("audio", "driver_buffer");
+static const Settings::Key SYNTHESIZER_LOOK_AHEAD_MSECS("audio", "synthesizer/lookAheadMsecs");
+static const Settings::Key UNUSED_SOUNDFONT_SAMPLES_BUDGET_MB("audio", "synthesizer/unusedSoundFontSamplesBudgetMb");
 
 static const Settings::Key USER_SOUNDFONTS_PATHS("midi", "application/paths/mySoundfonts");
 
@@ -60,6 +62,8 @@ void AudioConfiguration::init()
     settings()->setDefaultValue(AUDIO_BUFFER_SIZE, Val(defaultBufferSize));
 
     settings()->setDefaultValue(AUDIO_API_KEY, Val("Core Audio"));
+    settings()->setDefaultValue(SYNTHESIZER_LOOK_AHEAD_MSECS, Val(0));
+    settings()->setDefaultValue(UNUSED_SOUNDFONT_SAMPLES_BUDGET_MB, Val(256));
 
     settings()->valueChanged(AUDIO_OUTPUT_DEVICE_ID_KEY).onReceive(nullptr, [this](const Val&) {
         m_audioOutputDeviceNameChanged.notify();
@@ -122,6 +126,11 @@ unsigned int AudioConfiguration::driverBufferSize() const
     return settings()->value(AUDIO_BUFFER_SIZE).toInt();
 }
 
+msecs_t AudioConfiguration::synthesizerLookAheadMsecs() const
+{
+    return settings()->value(SYNTHESIZER_LOOK_AHEAD_MSECS).toInt();
+}
+
 SoundFontPaths AudioConfiguration::soundFontDirectories() const
 {
     SoundFontPaths paths = userSoundFontDirectories();
@@ -146,6 +155,16 @@ async::Channel<io::paths_t> AudioConfiguration::soundFontDirectoriesChanged() co
     return m_soundFontDirsChanged;
 }
 
+io::path_t AudioConfiguration::soundFontSamplesCachePath() const
+{
+    return globalConfiguration()->userAppDataPath() + "/soundfont_samples";
+}
+
+size_t AudioConfiguration::unusedSoundFontSamplesBudget() const
+{
+    return static_cast<size_t>(settings()->value(UNUSED_SOUNDFONT_SAMPLES_BUDGET_MB).toInt()) * 1024 * 1024;
+}
+
 AudioInputParams AudioConfiguration::defaultAudioInputParams() const
 {
     AudioInputParams result;
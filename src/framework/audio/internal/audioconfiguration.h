@@ -53,8 +53,11 @@ public:
     io::paths_t userSoundFontDirectories() const override;
     void setUserSoundFontDirectories(const io::paths_t& paths) override;
     async::Channel<io::paths_t> soundFontDirectoriesChanged() const override;
+    io::path_t soundFontSamplesCachePath() const override;
+    size_t unusedSoundFontSamplesBudget() const override;
 
     AudioInputParams defaultAudioInputParams() const override;
+    msecs_t synthesizerLookAheadMsecs() const override;
 
     const synth::SynthesizerState& defaultSynthesizerState() const;
     const synth::SynthesizerState& synthesizerState() const override;
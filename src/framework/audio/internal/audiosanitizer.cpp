@@ -27,6 +27,7 @@ using namespace mu::audio;
 
 static std::thread::id s_as_mainThreadID;
 static std::thread::id s_as_workerThreadID;
+static thread_local bool s_as_isRenderThread = false;
 
 void AudioSanitizer::setupMainThread()
 {
@@ -57,3 +58,13 @@ bool AudioSanitizer::isWorkerThread()
 {
     return std::this_thread::get_id() == s_as_workerThreadID;
 }
+
+void AudioSanitizer::setupRenderThread()
+{
+    s_as_isRenderThread = true;
+}
+
+bool AudioSanitizer::isRenderThread()
+{
+    return s_as_isRenderThread;
+}
@@ -0,0 +1,393 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "audiokernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MU_AUDIO_X86_KERNELS
+#include <immintrin.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define MU_TARGET_SSE2
+#define MU_TARGET_AVX2
+#else
+#define MU_TARGET_SSE2 __attribute__((target("sse2")))
+#define MU_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+using namespace mu::audio;
+using namespace mu::audio::dsp;
+
+static constexpr size_t LANES_COUNT = 16;
+
+namespace {
+//! NOTE The gain of the interleaved sample i is from[i % LANES_COUNT] + step[i % LANES_COUNT] * sampleIdx,
+//!      where sampleIdx = i / audioChannelsCount, the lanes layout works as long as the audio channels count divides LANES_COUNT
+struct GainRampLanes {
+    float from[LANES_COUNT] = {};
+    float step[LANES_COUNT] = {};
+    int sampleOffset[LANES_COUNT] = {};
+};
+
+bool isLanesLayoutApplicable(const audioch_t audioChannelsCount)
+{
+    return audioChannelsCount > 0 && LANES_COUNT % audioChannelsCount == 0;
+}
+
+float rampStep(const gain_t from, const gain_t to, const samples_t samplesPerChannel)
+{
+    return (to - from) / static_cast<float>(samplesPerChannel);
+}
+
+GainRampLanes gainRampLanes(const audioch_t audioChannelsCount, const samples_t samplesPerChannel, const gain_t* gainsFrom,
+                            const gain_t* gainsTo)
+{
+    GainRampLanes lanes;
+
+    for (size_t lane = 0; lane < LANES_COUNT; ++lane) {
+        audioch_t audioChNum = lane % audioChannelsCount;
+
+        lanes.from[lane] = gainsFrom[audioChNum];
+        lanes.step[lane] = rampStep(gainsFrom[audioChNum], gainsTo[audioChNum], samplesPerChannel);
+        lanes.sampleOffset[lane] = static_cast<int>(lane / audioChannelsCount);
+    }
+
+    return lanes;
+}
+
+//! NOTE Reduces the lanes and processes the rest of the buffer which doesn't fill all the lanes
+void completeChannelGains(float* buffer, const audioch_t audioChannelsCount, const samples_t samplesPerChannel,
+                          const GainRampLanes& lanes, const size_t processedCount, const float* laneSquaredSums,
+                          float* squaredSums)
+{
+    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
+        squaredSums[audioChNum] = 0.f;
+    }
+
+    for (size_t lane = 0; lane < LANES_COUNT; ++lane) {
+        squaredSums[lane % audioChannelsCount] += laneSquaredSums[lane];
+    }
+
+    size_t totalCount = samplesPerChannel * audioChannelsCount;
+
+    for (size_t i = processedCount; i < totalCount; ++i) {
+        size_t lane = i % LANES_COUNT;
+        float sampleIdx = static_cast<float>(static_cast<int>(i / audioChannelsCount));
+
+        float resultSample = buffer[i] * (lanes.from[lane] + lanes.step[lane] * sampleIdx);
+        buffer[i] = resultSample;
+
+        squaredSums[i % audioChannelsCount] += resultSample * resultSample;
+    }
+}
+
+// ============ Scalar ============
+
+void mixAddScalar(float* out, const float* in, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        out[i] += in[i];
+    }
+}
+
+void applyGainScalar(float* buffer, size_t count, gain_t gain)
+{
+    for (size_t i = 0; i < count; ++i) {
+        buffer[i] *= gain;
+    }
+}
+
+void applyChannelGainsScalar(float* buffer, audioch_t audioChannelsCount, samples_t samplesPerChannel,
+                             const gain_t* gainsFrom, const gain_t* gainsTo, float* squaredSums)
+{
+    if (!isLanesLayoutApplicable(audioChannelsCount)) {
+        for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
+            float step = rampStep(gainsFrom[audioChNum], gainsTo[audioChNum], samplesPerChannel);
+            float squaredSum = 0.f;
+
+            for (samples_t s = 0; s < samplesPerChannel; ++s) {
+                size_t idx = s * audioChannelsCount + audioChNum;
+
+                float resultSample = buffer[idx] * (gainsFrom[audioChNum] + step * static_cast<float>(s));
+                buffer[idx] = resultSample;
+
+                squaredSum += resultSample * resultSample;
+            }
+
+            squaredSums[audioChNum] = squaredSum;
+        }
+
+        return;
+    }
+
+    GainRampLanes lanes = gainRampLanes(audioChannelsCount, samplesPerChannel, gainsFrom, gainsTo);
+
+    size_t totalCount = samplesPerChannel * audioChannelsCount;
+    size_t lanesCount = totalCount - totalCount % LANES_COUNT;
+
+    float laneSquaredSums[LANES_COUNT] = {};
+
+    int sampleIdx = 0;
+    int sampleIdxStep = static_cast<int>(LANES_COUNT / audioChannelsCount);
+
+    for (size_t i = 0; i < lanesCount; i += LANES_COUNT, sampleIdx += sampleIdxStep) {
+        for (size_t lane = 0; lane < LANES_COUNT; ++lane) {
+            float gain = lanes.from[lane] + lanes.step[lane] * static_cast<float>(sampleIdx + lanes.sampleOffset[lane]);
+            float resultSample = buffer[i + lane] * gain;
+            buffer[i + lane] = resultSample;
+
+            laneSquaredSums[lane] += resultSample * resultSample;
+        }
+    }
+
+    completeChannelGains(buffer, audioChannelsCount, samplesPerChannel, lanes, lanesCount, laneSquaredSums, squaredSums);
+}
+
+#ifdef MU_AUDIO_X86_KERNELS
+
+// ============ SSE2 ============
+
+MU_TARGET_SSE2 void mixAddSse2(float* out, const float* in, size_t count)
+{
+    size_t vectorCount = count - count % 4;
+
+    for (size_t i = 0; i < vectorCount; i += 4) {
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_loadu_ps(in + i)));
+    }
+
+    mixAddScalar(out + vectorCount, in + vectorCount, count - vectorCount);
+}
+
+MU_TARGET_SSE2 void applyGainSse2(float* buffer, size_t count, gain_t gain)
+{
+    size_t vectorCount = count - count % 4;
+    __m128 gainVec = _mm_set1_ps(gain);
+
+    for (size_t i = 0; i < vectorCount; i += 4) {
+        _mm_storeu_ps(buffer + i, _mm_mul_ps(_mm_loadu_ps(buffer + i), gainVec));
+    }
+
+    applyGainScalar(buffer + vectorCount, count - vectorCount, gain);
+}
+
+MU_TARGET_SSE2 void applyChannelGainsSse2(float* buffer, audioch_t audioChannelsCount, samples_t samplesPerChannel,
+                                          const gain_t* gainsFrom, const gain_t* gainsTo, float* squaredSums)
+{
+    if (!isLanesLayoutApplicable(audioChannelsCount)) {
+        applyChannelGainsScalar(buffer, audioChannelsCount, samplesPerChannel, gainsFrom, gainsTo, squaredSums);
+        return;
+    }
+
+    GainRampLanes lanes = gainRampLanes(audioChannelsCount, samplesPerChannel, gainsFrom, gainsTo);
+
+    size_t totalCount = samplesPerChannel * audioChannelsCount;
+    size_t lanesCount = totalCount - totalCount % LANES_COUNT;
+
+    __m128 from[4];
+    __m128 step[4];
+    __m128i offset[4];
+    __m128 sum[4];
+
+    for (size_t v = 0; v < 4; ++v) {
+        from[v] = _mm_loadu_ps(lanes.from + v * 4);
+        step[v] = _mm_loadu_ps(lanes.step + v * 4);
+        offset[v] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes.sampleOffset + v * 4));
+        sum[v] = _mm_setzero_ps();
+    }
+
+    __m128i sampleIdx = _mm_setzero_si128();
+    __m128i sampleIdxStep = _mm_set1_epi32(static_cast<int>(LANES_COUNT / audioChannelsCount));
+
+    for (size_t i = 0; i < lanesCount; i += LANES_COUNT) {
+        for (size_t v = 0; v < 4; ++v) {
+            __m128 gain = _mm_add_ps(from[v], _mm_mul_ps(step[v], _mm_cvtepi32_ps(_mm_add_epi32(sampleIdx, offset[v]))));
+            __m128 result = _mm_mul_ps(_mm_loadu_ps(buffer + i + v * 4), gain);
+
+            _mm_storeu_ps(buffer + i + v * 4, result);
+
+            sum[v] = _mm_add_ps(sum[v], _mm_mul_ps(result, result));
+        }
+
+        sampleIdx = _mm_add_epi32(sampleIdx, sampleIdxStep);
+    }
+
+    float laneSquaredSums[LANES_COUNT];
+    for (size_t v = 0; v < 4; ++v) {
+        _mm_storeu_ps(laneSquaredSums + v * 4, sum[v]);
+    }
+
+    completeChannelGains(buffer, audioChannelsCount, samplesPerChannel, lanes, lanesCount, laneSquaredSums, squaredSums);
+}
+
+// ============ AVX2 ============
+
+MU_TARGET_AVX2 void mixAddAvx2(float* out, const float* in, size_t count)
+{
+    size_t vectorCount = count - count % 8;
+
+    for (size_t i = 0; i < vectorCount; i += 8) {
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_loadu_ps(in + i)));
+    }
+
+    mixAddScalar(out + vectorCount, in + vectorCount, count - vectorCount);
+}
+
+MU_TARGET_AVX2 void applyGainAvx2(float* buffer, size_t count, gain_t gain)
+{
+    size_t vectorCount = count - count % 8;
+    __m256 gainVec = _mm256_set1_ps(gain);
+
+    for (size_t i = 0; i < vectorCount; i += 8) {
+        _mm256_storeu_ps(buffer + i, _mm256_mul_ps(_mm256_loadu_ps(buffer + i), gainVec));
+    }
+
+    applyGainScalar(buffer + vectorCount, count - vectorCount, gain);
+}
+
+MU_TARGET_AVX2 void applyChannelGainsAvx2(float* buffer, audioch_t audioChannelsCount, samples_t samplesPerChannel,
+                                          const gain_t* gainsFrom, const gain_t* gainsTo, float* squaredSums)
+{
+    if (!isLanesLayoutApplicable(audioChannelsCount)) {
+        applyChannelGainsScalar(buffer, audioChannelsCount, samplesPerChannel, gainsFrom, gainsTo, squaredSums);
+        return;
+    }
+
+    GainRampLanes lanes = gainRampLanes(audioChannelsCount, samplesPerChannel, gainsFrom, gainsTo);
+
+    size_t totalCount = samplesPerChannel * audioChannelsCount;
+    size_t lanesCount = totalCount - totalCount % LANES_COUNT;
+
+    __m256 from[2];
+    __m256 step[2];
+    __m256i offset[2];
+    __m256 sum[2];
+
+    for (size_t v = 0; v < 2; ++v) {
+        from[v] = _mm256_loadu_ps(lanes.from + v * 8);
+        step[v] = _mm256_loadu_ps(lanes.step + v * 8);
+        offset[v] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes.sampleOffset + v * 8));
+        sum[v] = _mm256_setzero_ps();
+    }
+
+    __m256i sampleIdx = _mm256_setzero_si256();
+    __m256i sampleIdxStep = _mm256_set1_epi32(static_cast<int>(LANES_COUNT / audioChannelsCount));
+
+    for (size_t i = 0; i < lanesCount; i += LANES_COUNT) {
+        for (size_t v = 0; v < 2; ++v) {
+            //! NOTE No FMA here, the separate rounding of the multiplication keeps the results equal to the scalar ones
+            __m256 gain = _mm256_add_ps(from[v], _mm256_mul_ps(step[v], _mm256_cvtepi32_ps(_mm256_add_epi32(sampleIdx, offset[v]))));
+            __m256 result = _mm256_mul_ps(_mm256_loadu_ps(buffer + i + v * 8), gain);
+
+            _mm256_storeu_ps(buffer + i + v * 8, result);
+
+            sum[v] = _mm256_add_ps(sum[v], _mm256_mul_ps(result, result));
+        }
+
+        sampleIdx = _mm256_add_epi32(sampleIdx, sampleIdxStep);
+    }
+
+    float laneSquaredSums[LANES_COUNT];
+    for (size_t v = 0; v < 2; ++v) {
+        _mm256_storeu_ps(laneSquaredSums + v * 8, sum[v]);
+    }
+
+    completeChannelGains(buffer, audioChannelsCount, samplesPerChannel, lanes, lanesCount, laneSquaredSums, squaredSums);
+}
+
+bool isAvx2Supported()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuid(regs, 1);
+
+    bool osUsesXsave = regs[2] & (1 << 27);
+    bool avxSupported = regs[2] & (1 << 28);
+
+    if (!osUsesXsave || !avxSupported || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(regs, 7, 0);
+    return regs[1] & (1 << 5);
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+bool isSse2Supported()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuid(regs, 1);
+    return regs[3] & (1 << 26);
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+#endif
+}
+
+InstructionSet mu::audio::dsp::bestSupportedInstructionSet()
+{
+#ifdef MU_AUDIO_X86_KERNELS
+    static const InstructionSet best = isAvx2Supported() ? InstructionSet::AVX2
+                                       : isSse2Supported() ? InstructionSet::SSE2
+                                       : InstructionSet::Scalar;
+    return best;
+#else
+    return InstructionSet::Scalar;
+#endif
+}
+
+const AudioKernels& mu::audio::dsp::audioKernels()
+{
+    static const AudioKernels& kernels = audioKernels(bestSupportedInstructionSet());
+    return kernels;
+}
+
+const AudioKernels& mu::audio::dsp::audioKernels([[maybe_unused]] const InstructionSet instructionSet)
+{
+    static const AudioKernels scalar { mixAddScalar, applyGainScalar, applyChannelGainsScalar };
+
+#ifdef MU_AUDIO_X86_KERNELS
+    static const AudioKernels sse2 { mixAddSse2, applyGainSse2, applyChannelGainsSse2 };
+    static const AudioKernels avx2 { mixAddAvx2, applyGainAvx2, applyChannelGainsAvx2 };
+
+    //! NOTE The unsupported instruction sets fall back to the scalar kernels
+    if (instructionSet > bestSupportedInstructionSet()) {
+        return scalar;
+    }
+
+    switch (instructionSet) {
+    case InstructionSet::AVX2: return avx2;
+    case InstructionSet::SSE2: return sse2;
+    case InstructionSet::Scalar: break;
+    }
+#endif
+
+    return scalar;
+}
@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_AUDIOKERNELS_H
+#define MU_AUDIO_AUDIOKERNELS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "audiotypes.h"
+
+namespace mu::audio::dsp {
+enum class InstructionSet {
+    Scalar = 0,
+    SSE2,
+    AVX2
+};
+
+/**
+ * @brief The AudioKernels struct
+ * @details The hot per-sample loops of the mixer, the gain stages and the dynamics processors.
+ *          Every instruction set produces bit-identical results: the squared sums are accumulated
+ *          in 16 interleaved lanes and reduced in the same order by all of them
+ */
+struct AudioKernels
+{
+    /// out[i] += in[i]
+    void (* mixAdd)(float* out, const float* in, size_t count) = nullptr;
+
+    /// buffer[i] *= gain
+    void (* applyGain)(float* buffer, size_t count, gain_t gain) = nullptr;
+
+    /// Multiplies the interleaved samples of each audio channel by the gain ramping linearly from gainsFrom[ch]
+    /// (the first sample) towards gainsTo[ch] (the first sample of the next block) and writes the sum
+    /// of the squared results of each audio channel into squaredSums[ch]
+    void (* applyChannelGains)(float* buffer, audioch_t audioChannelsCount, samples_t samplesPerChannel,
+                               const gain_t* gainsFrom, const gain_t* gainsTo, float* squaredSums) = nullptr;
+};
+
+InstructionSet bestSupportedInstructionSet();
+
+const AudioKernels& audioKernels(); // the best supported ones
+const AudioKernels& audioKernels(const InstructionSet instructionSet); // falls back to the scalar ones, if not supported
+
+/**
+ * @brief The ChannelGainsRamp class
+ * @details Keeps the gains of the previous block, so that the gain changes (volume, balance)
+ *          are ramped over the next block instead of stepping
+ */
+class ChannelGainsRamp
+{
+public:
+    //! NOTE Returns the sum of the squared output samples of each audio channel
+    template<typename ChannelGainFunc>
+    const std::vector<float>& apply(float* buffer, const audioch_t audioChannelsCount, const samples_t samplesPerChannel,
+                                    ChannelGainFunc channelGain)
+    {
+        if (m_targetGains.size() != audioChannelsCount) {
+            m_targetGains.resize(audioChannelsCount);
+            m_squaredSums.resize(audioChannelsCount);
+            m_previousGains.clear();
+        }
+
+        for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
+            m_targetGains[audioChNum] = channelGain(audioChNum);
+        }
+
+        if (m_previousGains.empty()) {
+            m_previousGains = m_targetGains;
+        }
+
+        audioKernels().applyChannelGains(buffer, audioChannelsCount, samplesPerChannel,
+                                         m_previousGains.data(), m_targetGains.data(), m_squaredSums.data());
+
+        m_previousGains = m_targetGains;
+
+        return m_squaredSums;
+    }
+
+private:
+    std::vector<gain_t> m_previousGains;
+    std::vector<gain_t> m_targetGains;
+    std::vector<float> m_squaredSums;
+};
+}
+
+#endif // MU_AUDIO_AUDIOKERNELS_H
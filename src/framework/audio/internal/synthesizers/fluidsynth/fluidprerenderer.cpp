@@ -0,0 +1,160 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "fluidprerenderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "runtime.h"
+#include "internal/audiosanitizer.h"
+
+using namespace mu::audio;
+using namespace mu::audio::synth;
+
+static constexpr samples_t PRE_RENDER_BLOCK_SIZE = 512;
+
+FluidPreRenderer::FluidPreRenderer(const audioch_t audioChannelsCount, RenderFunc render, RenderedPositionFunc renderedPosition)
+    : m_audioChannelsCount(audioChannelsCount), m_render(std::move(render)), m_renderedPosition(std::move(renderedPosition))
+{
+    m_block.resize(PRE_RENDER_BLOCK_SIZE * m_audioChannelsCount, 0.f);
+}
+
+FluidPreRenderer::~FluidPreRenderer()
+{
+    stop();
+}
+
+void FluidPreRenderer::start(const samples_t lookAheadSamples)
+{
+    if (m_running) {
+        return;
+    }
+
+    m_capacity = std::max(lookAheadSamples, PRE_RENDER_BLOCK_SIZE);
+    m_data.assign(m_capacity * m_audioChannelsCount, 0.f);
+    reset();
+
+    m_running = true;
+    m_thread = std::make_unique<std::thread>([this]() {
+        runtime::setThreadName("fluid_prerender");
+        AudioSanitizer::setupRenderThread();
+        loop();
+    });
+}
+
+void FluidPreRenderer::stop()
+{
+    if (!m_running) {
+        return;
+    }
+
+    m_running = false;
+
+    if (m_thread) {
+        m_thread->join();
+        m_thread.reset();
+    }
+
+    reset();
+}
+
+bool FluidPreRenderer::isRunning() const
+{
+    return m_running;
+}
+
+samples_t FluidPreRenderer::read(float* buffer, const samples_t samplesPerChannel)
+{
+    samples_t count = std::min(samplesPerChannel, availableSamples());
+    uint64_t readPosition = m_readPosition.load(std::memory_order_relaxed);
+
+    for (samples_t copied = 0; copied < count;) {
+        samples_t ringIdx = static_cast<samples_t>((readPosition + copied) % m_capacity);
+        samples_t chunk = std::min(count - copied, m_capacity - ringIdx);
+
+        std::memcpy(buffer + copied * m_audioChannelsCount, m_data.data() + ringIdx * m_audioChannelsCount,
+                    chunk * m_audioChannelsCount * sizeof(float));
+        copied += chunk;
+    }
+
+    m_readPosition.store(readPosition + count, std::memory_order_release);
+
+    if (count < samplesPerChannel) {
+        //! NOTE The render thread didn't manage to keep up, the rest of the block is a dropout
+        std::fill(buffer + count * m_audioChannelsCount, buffer + samplesPerChannel * m_audioChannelsCount, 0.f);
+    }
+
+    return samplesPerChannel;
+}
+
+void FluidPreRenderer::invalidate(const ChangeFunc& change, const msecs_t changedFrom)
+{
+    std::lock_guard<std::mutex> lock(m_renderMutex);
+
+    const bool renderedAudioAffected = changedFrom <= m_renderedPosition();
+
+    change(renderedAudioAffected);
+
+    if (renderedAudioAffected) {
+        reset();
+    }
+}
+
+void FluidPreRenderer::loop()
+{
+    while (m_running) {
+        {
+            std::lock_guard<std::mutex> lock(m_renderMutex);
+
+            if (m_capacity - availableSamples() >= PRE_RENDER_BLOCK_SIZE) {
+                m_render(m_block.data(), PRE_RENDER_BLOCK_SIZE);
+
+                uint64_t writePosition = m_writePosition.load(std::memory_order_relaxed);
+                samples_t ringIdx = static_cast<samples_t>(writePosition % m_capacity);
+                samples_t firstPart = std::min(PRE_RENDER_BLOCK_SIZE, m_capacity - ringIdx);
+
+                std::memcpy(m_data.data() + ringIdx * m_audioChannelsCount, m_block.data(),
+                            firstPart * m_audioChannelsCount * sizeof(float));
+                std::memcpy(m_data.data(), m_block.data() + firstPart * m_audioChannelsCount,
+                            (PRE_RENDER_BLOCK_SIZE - firstPart) * m_audioChannelsCount * sizeof(float));
+
+                m_writePosition.store(writePosition + PRE_RENDER_BLOCK_SIZE, std::memory_order_release);
+                continue;
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void FluidPreRenderer::reset()
+{
+    m_readPosition = 0;
+    m_writePosition = 0;
+}
+
+samples_t FluidPreRenderer::availableSamples() const
+{
+    return static_cast<samples_t>(m_writePosition.load(std::memory_order_acquire) - m_readPosition.load(std::memory_order_acquire));
+}
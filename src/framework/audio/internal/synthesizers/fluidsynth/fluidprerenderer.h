@@ -0,0 +1,87 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_FLUIDPRERENDERER_H
+#define MU_AUDIO_FLUIDPRERENDERER_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "audiotypes.h"
+
+namespace mu::audio::synth {
+/**
+ * @brief The FluidPreRenderer class
+ * @details Renders the audio of a synthesizer ahead of the playback position on a background thread,
+ *          so that the real-time processing mostly copies the audio which is already rendered.
+ *          Any change of the synthesizer state has to be applied through invalidate(),
+ *          which drops the pre-rendered audio if it's affected by the change
+ */
+class FluidPreRenderer
+{
+public:
+    using RenderFunc = std::function<samples_t(float* buffer, samples_t samplesPerChannel)>;
+    using RenderedPositionFunc = std::function<msecs_t()>;
+    using ChangeFunc = std::function<void(bool renderedAudioAffected)>;
+
+    FluidPreRenderer(const audioch_t audioChannelsCount, RenderFunc render, RenderedPositionFunc renderedPosition);
+    ~FluidPreRenderer();
+
+    void start(const samples_t lookAheadSamples);
+    void stop();
+    bool isRunning() const;
+
+    samples_t read(float* buffer, const samples_t samplesPerChannel);
+
+    //! NOTE The rendered audio is affected if the change starts before the rendered position,
+    //! the position is taken before the change is applied, since the change may rewind the synthesizer
+    void invalidate(const ChangeFunc& change, const msecs_t changedFrom = 0);
+
+private:
+    void loop();
+    void reset();
+
+    samples_t availableSamples() const;
+
+    audioch_t m_audioChannelsCount = 0;
+    RenderFunc m_render;
+    RenderedPositionFunc m_renderedPosition;
+
+    std::unique_ptr<std::thread> m_thread;
+    std::atomic<bool> m_running = false;
+    std::mutex m_renderMutex;
+
+    std::vector<float> m_data;
+    std::vector<float> m_block;
+    samples_t m_capacity = 0;
+
+    //! positions in samples per channel since the last reset, the ring index is position % capacity
+    std::atomic<uint64_t> m_writePosition = 0;
+    std::atomic<uint64_t> m_readPosition = 0;
+};
+}
+
+#endif // MU_AUDIO_FLUIDPRERENDERER_H
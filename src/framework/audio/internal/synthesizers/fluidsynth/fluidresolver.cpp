@@ -24,6 +24,8 @@
 
 #include "internal/audiosanitizer.h"
 
+#include "sfsamplestore.h"
+
 #include "log.h"
 
 using namespace mu::audio;
@@ -35,6 +37,9 @@ FluidResolver::FluidResolver()
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    SoundFontSampleStore::instance()->init(configuration()->soundFontSamplesCachePath(),
+                                            configuration()->unusedSoundFontSamplesBudget());
+
     refresh();
     soundFontRepository()->soundFontPathsChanged().onNotify(this, [this]() {
         refresh();
@@ -55,6 +60,7 @@ ISynthesizerPtr FluidResolver::resolveSynth(const TrackId /*trackId*/, const Aud
     }
 
     synth->addSoundFonts({ search->second });
+    synth->setLookAhead(configuration()->synthesizerLookAheadMsecs());
 
     return synth;
 }
@@ -33,20 +33,6 @@ void FluidSequencer::init(const ArticulationMapping& mapping, const std::unorder
     m_channels = channels;
 }
 
-void FluidSequencer::updateOffStreamEvents(const mpe::PlaybackEventsMap& changes)
-{
-    m_offStreamEvents.clear();
-    updatePlaybackEvents(m_offStreamEvents, changes);
-    updateOffSequenceIterator();
-}
-
-void FluidSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& changes)
-{
-    m_mainStreamEvents.clear();
-    updatePlaybackEvents(m_mainStreamEvents, changes);
-    updateMainSequenceIterator();
-}
-
 void FluidSequencer::updateDynamicChanges(const mpe::DynamicLevelMap& changes)
 {
     m_dynamicEvents.clear();
@@ -62,39 +48,37 @@ void FluidSequencer::updateDynamicChanges(const mpe::DynamicLevelMap& changes)
     updateDynamicChangesIterator();
 }
 
-void FluidSequencer::updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& changes)
+void FluidSequencer::convertPlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventList& events)
 {
-    for (const auto& pair : changes) {
-        for (const mpe::PlaybackEvent& event : pair.second) {
-            if (!std::holds_alternative<mpe::NoteEvent>(event)) {
-                continue;
-            }
+    for (const mpe::PlaybackEvent& event : events) {
+        if (!std::holds_alternative<mpe::NoteEvent>(event)) {
+            continue;
+        }
 
-            const mpe::NoteEvent& noteEvent = std::get<mpe::NoteEvent>(event);
+        const mpe::NoteEvent& noteEvent = std::get<mpe::NoteEvent>(event);
 
-            timestamp_t timestampFrom = noteEvent.arrangementCtx().actualTimestamp;
-            timestamp_t timestampTo = timestampFrom + noteEvent.arrangementCtx().actualDuration;
+        timestamp_t timestampFrom = noteEvent.arrangementCtx().actualTimestamp;
+        timestamp_t timestampTo = timestampFrom + noteEvent.arrangementCtx().actualDuration;
 
-            channel_t channelIdx = channel(noteEvent);
-            note_idx_t noteIdx = noteIndex(noteEvent.pitchCtx().nominalPitchLevel);
-            velocity_t velocity = noteVelocity(noteEvent);
+        channel_t channelIdx = channel(noteEvent);
+        note_idx_t noteIdx = noteIndex(noteEvent.pitchCtx().nominalPitchLevel);
+        velocity_t velocity = noteVelocity(noteEvent);
 
-            midi::Event noteOn(Event::Opcode::NoteOn, Event::MessageType::ChannelVoice10);
-            noteOn.setChannel(channelIdx);
-            noteOn.setNote(noteIdx);
-            noteOn.setVelocity(velocity);
+        midi::Event noteOn(Event::Opcode::NoteOn, Event::MessageType::ChannelVoice10);
+        noteOn.setChannel(channelIdx);
+        noteOn.setNote(noteIdx);
+        noteOn.setVelocity(velocity);
 
-            destination[timestampFrom].emplace(std::move(noteOn));
+        destination[timestampFrom].emplace(std::move(noteOn));
 
-            midi::Event noteOff(Event::Opcode::NoteOff, Event::MessageType::ChannelVoice10);
-            noteOff.setChannel(channelIdx);
-            noteOff.setNote(noteIdx);
+        midi::Event noteOff(Event::Opcode::NoteOff, Event::MessageType::ChannelVoice10);
+        noteOff.setChannel(channelIdx);
+        noteOff.setNote(noteIdx);
 
-            destination[timestampTo].emplace(std::move(noteOff));
+        destination[timestampTo].emplace(std::move(noteOff));
 
-            appendControlSwitch(destination, noteEvent, PEDAL_CC_SUPPORTED_TYPES, 64);
-            appendPitchBend(destination, noteEvent, BEND_SUPPORTED_TYPES, channelIdx);
-        }
+        appendControlSwitch(destination, noteEvent, PEDAL_CC_SUPPORTED_TYPES, 64);
+        appendPitchBend(destination, noteEvent, BEND_SUPPORTED_TYPES, channelIdx);
     }
 }
 
@@ -35,13 +35,10 @@ class FluidSequencer : public AbstractEventSequencer<midi::Event>
 public:
     void init(const ArticulationMapping& mapping, const std::unordered_map<midi::channel_t, midi::Program>& channels);
 
-    void updateOffStreamEvents(const mpe::PlaybackEventsMap& changes) override;
-    void updateMainStreamEvents(const mpe::PlaybackEventsMap& changes) override;
+    void convertPlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventList& events) override;
     void updateDynamicChanges(const mpe::DynamicLevelMap& changes) override;
 
 private:
-    void updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& changes);
-
     void appendControlSwitch(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent, const mpe::ArticulationTypeSet& appliableTypes,
                              const int midiControlIdx);
 
@@ -22,6 +22,7 @@
 
 #include "fluidsynth.h"
 
+#include <chrono>
 #include <thread>
 #include <sstream>
 #include <algorithm>
@@ -46,6 +47,19 @@ static constexpr int DEFAULT_MIDI_VOLUME = 100;
 
 static std::vector<double> FLUID_STANDARD_TUNING(12, -150.0);
 
+static fluid_preset_t* findPreset(fluid_synth_t* synth, int bank, int program)
+{
+    for (int i = 0; i < fluid_synth_sfcount(synth); ++i) {
+        fluid_preset_t* preset = fluid_sfont_get_preset(fluid_synth_get_sfont(synth, i), bank, program);
+
+        if (preset) {
+            return preset;
+        }
+    }
+
+    return nullptr;
+}
+
 /// @note
 ///  Fluid does not support MONO, so they start counting audio channels from 1, which means "1 pair of audio channels"
 /// @see https://www.fluidsynth.org/api/settings_synth.html
@@ -68,6 +82,17 @@ FluidSynth::FluidSynth(const AudioSourceParams& params)
     m_fluid = std::make_shared<Fluid>();
 
     init();
+
+    m_sequencer.setChangesHandler([this](const msecs_t changedFrom, const std::function<void()>& change) {
+        applyChanges(changedFrom, change);
+    });
+}
+
+FluidSynth::~FluidSynth()
+{
+    if (m_preRenderer) {
+        m_preRenderer->stop();
+    }
 }
 
 bool FluidSynth::isValid() const
@@ -153,7 +178,7 @@ Ret FluidSynth::init()
     return true;
 }
 
-bool FluidSynth::handleEvent(const midi::Event& event)
+bool FluidSynth::handleEvent(const midi::Event& event, const bool sendToMidiOut)
 {
     int ret = FLUID_OK;
     switch (event.opcode()) {
@@ -176,6 +201,10 @@ bool FluidSynth::handleEvent(const midi::Event& event)
     } break;
     case Event::Opcode::ProgramChange: {
         fluid_synth_program_change(m_fluid->synth, event.channel(), event.program());
+
+        //! NOTE The samples of the new preset which weren't prefetched are decoded in the background,
+        //!      so they have to be loaded once they are ready (see loadPendingSamples)
+        m_programChanged = true;
     } break;
     case Event::Opcode::PitchBend: {
         ret = fluid_synth_pitch_bend(m_fluid->synth, event.channel(), event.data());
@@ -186,7 +215,9 @@ bool FluidSynth::handleEvent(const midi::Event& event)
     }
     }
 
-    midiOutPort()->sendEvent(event);
+    if (sendToMidiOut) {
+        midiOutPort()->sendEvent(event);
+    }
 
     return ret == FLUID_OK;
 }
@@ -226,6 +257,56 @@ Ret FluidSynth::addSoundFonts(const std::vector<io::path_t>& sfonts)
     return ok ? make_ret(Err::NoError) : make_ret(Err::SoundFontFailedLoad);
 }
 
+void FluidSynth::setLookAhead(const msecs_t lookAheadMsecs)
+{
+    if (m_preRenderer) {
+        m_preRenderer->stop();
+        m_sequencer.setPlaybackPosition(m_playbackPosition);
+    }
+
+    m_lookAheadMsecs = lookAheadMsecs;
+
+    if (m_lookAheadMsecs <= 0) {
+        m_preRenderer.reset();
+        return;
+    }
+
+    //! NOTE The pre-rendering thread is the only one which touches the synth while the playback is active,
+    //!      the MIDI output is skipped there, since the events are being handled ahead of time
+    m_preRenderer = std::make_unique<FluidPreRenderer>(audioChannelsCount(), [this](float* buffer, samples_t samplesPerChannel) {
+        return renderAudio(buffer, samplesPerChannel, false /*sendToMidiOut*/);
+    }, [this]() {
+        return m_sequencer.playbackPosition();
+    });
+
+    if (m_sequencer.isActive() && m_sampleRate > 0) {
+        m_preRenderer->start(m_lookAheadMsecs * m_sampleRate / 1000);
+    }
+}
+
+bool FluidSynth::isPreRendering() const
+{
+    return m_preRenderer && m_preRenderer->isRunning();
+}
+
+void FluidSynth::applyChanges(const msecs_t changedFrom, const std::function<void()>& change)
+{
+    if (!isPreRendering()) {
+        change();
+        return;
+    }
+
+    m_preRenderer->invalidate([this, &change](bool renderedAudioAffected) {
+        change();
+
+        //! NOTE The already rendered audio is affected, so let's render it again from the actual position
+        if (renderedAudioAffected) {
+            m_sequencer.setPlaybackPosition(m_playbackPosition);
+            fluid_synth_all_sounds_off(m_fluid->synth, -1);
+        }
+    }, changedFrom);
+}
+
 std::string FluidSynth::name() const
 {
     return "Fluid";
@@ -257,6 +338,22 @@ void FluidSynth::setupSound(const PlaybackSetupData& setupData)
 
     fluid_synth_activate_octave_tuning(m_fluid->synth, 0, 0, "standard", FLUID_STANDARD_TUNING.data(), 0);
 
+    //! NOTE Selecting a preset loads its samples, so the compressed ones are decoded in the background first.
+    //!      The channels get their programs right away, the samples still being decoded stay silent until they are loaded
+    std::vector<fluid_preset_t*> presets;
+    for (const auto& pair : m_channels) {
+        presets.push_back(findPreset(m_fluid->synth, pair.second.bank, pair.second.program));
+    }
+
+    m_samplesLoading = SoundFontSampleStore::instance()->prefetch(presets);
+
+    setupChannels();
+
+    m_sequencer.init(m_articulationMapping, m_channels);
+}
+
+void FluidSynth::setupChannels()
+{
     for (const auto& pair : m_channels) {
         fluid_synth_set_interp_method(m_fluid->synth, pair.first, FLUID_INTERP_DEFAULT);
         fluid_synth_pitch_wheel_sens(m_fluid->synth, pair.first, 2);
@@ -268,8 +365,30 @@ void FluidSynth::setupSound(const PlaybackSetupData& setupData)
         fluid_synth_set_legato_mode(m_fluid->synth, pair.first, FLUID_CHANNEL_LEGATO_MODE_RETRIGGER);
         fluid_synth_activate_tuning(m_fluid->synth, pair.first, 0, 0, 0);
     }
+}
 
-    m_sequencer.init(m_articulationMapping, m_channels);
+void FluidSynth::loadPendingSamples()
+{
+    bool samplesDecoded = m_samplesLoading.valid()
+                          && m_samplesLoading.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+
+    //! NOTE The program changes may have left the samples of the new presets pending, while nothing else was loading
+    bool programChanged = !m_samplesLoading.valid() && m_programChanged.exchange(false);
+
+    if (!samplesDecoded && !programChanged) {
+        return;
+    }
+
+    m_samplesLoading = SoundFontSampleStore::SamplesLoading();
+
+    applyChanges(mpe::PlaybackEventsChunk::MIN_TIMESTAMP, [this]() {
+        std::vector<fluid_preset_t*> presets;
+        for (const auto& pair : m_channels) {
+            presets.push_back(fluid_synth_get_channel_preset(m_fluid->synth, pair.first));
+        }
+
+        m_samplesLoading = SoundFontSampleStore::instance()->loadPendingSamples(presets);
+    });
 }
 
 void FluidSynth::setupEvents(const mpe::PlaybackData& playbackData)
@@ -283,7 +402,9 @@ void FluidSynth::revokePlayingNotes()
         return;
     }
 
-    fluid_synth_all_notes_off(m_fluid->synth, -1);
+    applyChanges(mpe::PlaybackEventsChunk::MIN_TIMESTAMP, [this]() {
+        fluid_synth_all_notes_off(m_fluid->synth, -1);
+    });
 }
 
 void FluidSynth::flushSound()
@@ -294,8 +415,10 @@ void FluidSynth::flushSound()
 
     revokePlayingNotes();
 
-    fluid_synth_all_sounds_off(m_fluid->synth, -1);
-    fluid_synth_cc(m_fluid->synth, -1, 121, 127);
+    applyChanges(mpe::PlaybackEventsChunk::MIN_TIMESTAMP, [this]() {
+        fluid_synth_all_sounds_off(m_fluid->synth, -1);
+        fluid_synth_cc(m_fluid->synth, -1, 121, 127);
+    });
 }
 
 bool FluidSynth::isActive() const
@@ -307,18 +430,37 @@ void FluidSynth::setIsActive(const bool isActive)
 {
     AbstractSynthesizer::setIsActive(isActive);
 
+    if (!isActive && m_preRenderer) {
+        m_preRenderer->stop();
+        m_sequencer.setPlaybackPosition(m_playbackPosition);
+    }
+
     m_sequencer.setActive(isActive);
     toggleExpressionController();
+
+    //! NOTE The off stream events have to be played immediately, so the look-ahead is only used during the playback
+    if (isActive && m_preRenderer && m_sampleRate > 0) {
+        m_playbackPosition = m_sequencer.playbackPosition();
+        m_preRenderer->start(m_lookAheadMsecs * m_sampleRate / 1000);
+    }
 }
 
 msecs_t FluidSynth::playbackPosition() const
 {
+    if (isPreRendering()) {
+        return m_playbackPosition;
+    }
+
     return m_sequencer.playbackPosition();
 }
 
 void FluidSynth::setPlaybackPosition(const msecs_t newPosition)
 {
-    m_sequencer.setPlaybackPosition(newPosition);
+    m_playbackPosition = newPosition;
+
+    applyChanges(mpe::PlaybackEventsChunk::MIN_TIMESTAMP, [this, newPosition]() {
+        m_sequencer.setPlaybackPosition(newPosition);
+    });
 }
 
 unsigned int FluidSynth::audioChannelsCount() const
@@ -332,12 +474,24 @@ samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
         return 0;
     }
 
+    loadPendingSamples();
+
+    if (isPreRendering()) {
+        m_playbackPosition += samplesToMsecs(samplesPerChannel, m_sampleRate);
+        return m_preRenderer->read(buffer, samplesPerChannel);
+    }
+
+    return renderAudio(buffer, samplesPerChannel, true /*sendToMidiOut*/);
+}
+
+samples_t FluidSynth::renderAudio(float* buffer, samples_t samplesPerChannel, const bool sendToMidiOut)
+{
     msecs_t nextMsecs = samplesToMsecs(samplesPerChannel, m_sampleRate);
 
     const FluidSequencer::EventSequence& sequence = m_sequencer.eventsToBePlayed(nextMsecs);
 
     for (const midi::Event& event : sequence) {
-        handleEvent(event);
+        handleEvent(event, sendToMidiOut);
     }
 
     int result = fluid_synth_write_float(m_fluid->synth, samplesPerChannel,
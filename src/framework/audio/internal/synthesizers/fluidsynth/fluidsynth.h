@@ -23,6 +23,7 @@
 #ifndef MU_AUDIO_FLUIDSYNTH_H
 #define MU_AUDIO_FLUIDSYNTH_H
 
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <list>
@@ -35,6 +36,8 @@
 
 #include "abstractsynthesizer.h"
 #include "fluidsequencer.h"
+#include "fluidprerenderer.h"
+#include "sfsamplestore.h"
 #include "soundmapping.h"
 
 namespace mu::audio::synth {
@@ -44,10 +47,13 @@ class FluidSynth : public AbstractSynthesizer
     INJECT(audio, midi::IMidiOutPort, midiOutPort)
 public:
     FluidSynth(const audio::AudioSourceParams& params);
+    ~FluidSynth() override;
 
     SoundFontFormats soundFontFormats() const;
     Ret addSoundFonts(const std::vector<io::path_t>& sfonts);
 
+    void setLookAhead(const msecs_t lookAheadMsecs);
+
     std::string name() const override;
     AudioSourceType type() const override;
     void setupSound(const mpe::PlaybackSetupData& setupData) override;
@@ -72,7 +78,14 @@ public:
 private:
     Ret init();
 
-    bool handleEvent(const midi::Event& event);
+    bool handleEvent(const midi::Event& event, const bool sendToMidiOut = true);
+
+    void setupChannels();
+    void loadPendingSamples();
+
+    samples_t renderAudio(float* buffer, samples_t samplesPerChannel, const bool sendToMidiOut);
+    bool isPreRendering() const;
+    void applyChanges(const msecs_t changedFrom, const std::function<void()>& change);
 
     void updateCurrentExpressionLevel(const midi::Event& event);
     void toggleExpressionController();
@@ -87,6 +100,12 @@ private:
     int m_currentExpressionLevel = 0;
 
     FluidSequencer m_sequencer;
+
+    SoundFontSampleStore::SamplesLoading m_samplesLoading;
+    std::atomic<bool> m_programChanged { false };
+
+    msecs_t m_lookAheadMsecs = 0;
+    std::unique_ptr<FluidPreRenderer> m_preRenderer;
 };
 
 using FluidSynthPtr = std::shared_ptr<FluidSynth>;
@@ -28,8 +28,10 @@ extern "C" {
 #endif
 
 #include <cstdio>
+#include <cstring>
 #include <vector>
 #include <map>
+#include <memory>
 #include <string>
 
 #include <sfloader/fluid_sfont.h>
@@ -37,11 +39,22 @@ extern "C" {
 
 #include "log.h"
 
+#include "sfsamplestore.h"
+
 namespace mu::audio::synth {
+//! NOTE The sound-font files are memory mapped by SoundFontSampleStore,
+//!      so reading doesn't go through the buffered file streams and the pages are shared between the processes
+struct SoundFontFile
+{
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t pos = 0;
+};
+
 struct SoundFontData
 {
     fluid_sfont_t* soundFontPtr = nullptr;
-    std::FILE* fileStream = nullptr;
+    std::unique_ptr<SoundFontFile> file;
 };
 
 struct SoundFontCache : public std::map<std::string, SoundFontData> {
@@ -63,10 +76,6 @@ private:
             }
 
             delete_fluid_sfont(pair.second.soundFontPtr);
-
-            if (pair.second.fileStream) {
-                std::fclose(pair.second.fileStream);
-            }
         }
     }
 };
@@ -76,28 +85,63 @@ void* openSoundFont(const char* filename)
     auto search = SoundFontCache::instance()->find(filename);
 
     if (search != SoundFontCache::instance()->cend()
-        && search->second.fileStream) {
-        return search->second.fileStream;
+        && search->second.file) {
+        search->second.file->pos = 0;
+        return search->second.file.get();
     }
 
-    std::FILE* stream = std::fopen(filename, "r");
+    auto file = std::make_unique<SoundFontFile>();
+    file->data = SoundFontSampleStore::instance()->mapFile(filename, file->size);
 
-    SoundFontData sfData;
-    sfData.fileStream = stream;
+    if (!file->data) {
+        return nullptr;
+    }
 
-    SoundFontCache::instance()->emplace(filename, std::move(sfData));
+    SoundFontFile* result = file.get();
+    SoundFontCache::instance()->operator[](filename).file = std::move(file);
 
-    return stream;
+    return result;
 }
 
 int readSoundFont(void* buf, int count, void* handle)
 {
-    return static_cast<int>(std::fread(buf, count, 1, static_cast<std::FILE*>(handle)));
+    SoundFontFile* file = static_cast<SoundFontFile*>(handle);
+
+    if (count < 0 || file->pos + static_cast<size_t>(count) > file->size) {
+        return FLUID_FAILED;
+    }
+
+    std::memcpy(buf, file->data + file->pos, count);
+    file->pos += count;
+
+    return FLUID_OK;
 }
 
 int seekSoundFont(void* handle, long offset, int origin)
 {
-    return std::fseek(static_cast<std::FILE*>(handle), offset, origin);
+    SoundFontFile* file = static_cast<SoundFontFile*>(handle);
+
+    long base = 0;
+
+    switch (origin) {
+    case SEEK_SET: base = 0;
+        break;
+    case SEEK_CUR: base = static_cast<long>(file->pos);
+        break;
+    case SEEK_END: base = static_cast<long>(file->size);
+        break;
+    default:
+        return FLUID_FAILED;
+    }
+
+    long newPos = base + offset;
+    if (newPos < 0 || static_cast<size_t>(newPos) > file->size) {
+        return FLUID_FAILED;
+    }
+
+    file->pos = static_cast<size_t>(newPos);
+
+    return FLUID_OK;
 }
 
 int closeSoundFont(void* /*handle*/)
@@ -111,7 +155,7 @@ int closeSoundFont(void* /*handle*/)
 
 long tellSoundFont(void* handle)
 {
-    return std::ftell(static_cast<std::FILE*>(handle));
+    return static_cast<long>(static_cast<SoundFontFile*>(handle)->pos);
 }
 
 int deleteSoundFont(fluid_sfont_t* /*sfont*/)
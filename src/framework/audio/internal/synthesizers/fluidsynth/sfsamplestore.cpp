@@ -0,0 +1,753 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sfsamplestore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QLockFile>
+
+extern "C" {
+#include <sfloader/fluid_sffile.h>
+#include <sfloader/fluid_samplecache.h>
+#include <sfloader/fluid_defsfont.h>
+}
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::audio::synth;
+
+static constexpr char DECODED_SAMPLE_MAGIC[4] = { 'M', 'S', 'S', 'D' };
+static constexpr uint32_t DECODED_SAMPLE_VERSION = 2;
+
+namespace {
+struct DecodedSampleHeader {
+    char magic[4] = { 0, 0, 0, 0 };
+    uint32_t version = 0;
+    uint32_t sampleStart = 0;
+    uint32_t sampleEnd = 0;
+    uint32_t sampleCount = 0;
+    uint32_t reserved = 0;
+    uint64_t sourceSize = 0;
+};
+
+static_assert(sizeof(DecodedSampleHeader) == 32, "the sample data must stay aligned after the header");
+
+static int64_t decodedSampleRecordSize(uint32_t sampleCount)
+{
+    return static_cast<int64_t>(sizeof(DecodedSampleHeader) + sampleCount * sizeof(short));
+}
+
+//! NOTE Each background decoding has its own read position within the mapped sound-font file
+struct MappedFileCursor {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t pos = 0;
+};
+}
+
+static bool isLittleEndian()
+{
+    const uint16_t value = 1;
+    return *reinterpret_cast<const uint8_t*>(&value) == 1;
+}
+
+static void* openMappedFile(const char* /*filename*/)
+{
+    return nullptr;
+}
+
+static int readMappedFile(void* buf, int count, void* handle)
+{
+    MappedFileCursor* cursor = static_cast<MappedFileCursor*>(handle);
+
+    if (count < 0 || cursor->pos + static_cast<size_t>(count) > cursor->size) {
+        return FLUID_FAILED;
+    }
+
+    std::memcpy(buf, cursor->data + cursor->pos, count);
+    cursor->pos += count;
+
+    return FLUID_OK;
+}
+
+static int seekMappedFile(void* handle, long offset, int origin)
+{
+    MappedFileCursor* cursor = static_cast<MappedFileCursor*>(handle);
+
+    long base = 0;
+
+    switch (origin) {
+    case SEEK_SET: base = 0;
+        break;
+    case SEEK_CUR: base = static_cast<long>(cursor->pos);
+        break;
+    case SEEK_END: base = static_cast<long>(cursor->size);
+        break;
+    default:
+        return FLUID_FAILED;
+    }
+
+    long newPos = base + offset;
+    if (newPos < 0 || static_cast<size_t>(newPos) > cursor->size) {
+        return FLUID_FAILED;
+    }
+
+    cursor->pos = static_cast<size_t>(newPos);
+
+    return FLUID_OK;
+}
+
+static int closeMappedFile(void* /*handle*/)
+{
+    return FLUID_OK;
+}
+
+static long tellMappedFile(void* handle)
+{
+    return static_cast<long>(static_cast<MappedFileCursor*>(handle)->pos);
+}
+
+static fluid_file_callbacks_t MAPPED_FILE_CALLBACKS {
+    openMappedFile,
+    readMappedFile,
+    seekMappedFile,
+    closeMappedFile,
+    tellMappedFile
+};
+
+SoundFontSampleStore* SoundFontSampleStore::instance()
+{
+    static SoundFontSampleStore s;
+    return &s;
+}
+
+SoundFontSampleStore::~SoundFontSampleStore()
+{
+    fluid_samplecache_set_provider(nullptr, nullptr);
+}
+
+void SoundFontSampleStore::init(const io::path_t& decodedSamplesCachePath, size_t unusedDecodedSamplesBudget)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decodedSamplesCachePath = decodedSamplesCachePath;
+        m_unusedDecodedSamplesBudget = unusedDecodedSamplesBudget;
+    }
+
+    if (!decodedSamplesCachePath.empty()) {
+        QDir().mkpath(decodedSamplesCachePath.toQString());
+    }
+
+    fluid_samplecache_set_provider(&SoundFontSampleStore::provideSampleData, &SoundFontSampleStore::releaseSampleData);
+}
+
+const uint8_t* SoundFontSampleStore::mapFile(const std::string& filePath, size_t& size)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto search = m_files.find(filePath);
+    if (search != m_files.end()) {
+        size = search->second.size;
+        return search->second.data;
+    }
+
+    MappedFile mapped;
+    mapped.file = std::make_unique<QFile>(QString::fromStdString(filePath));
+
+    if (!mapped.file->open(QIODevice::ReadOnly)) {
+        LOGE() << "failed to open: " << filePath;
+        return nullptr;
+    }
+
+    mapped.size = static_cast<size_t>(mapped.file->size());
+    mapped.data = mapped.size > 0 ? mapped.file->map(0, mapped.file->size()) : nullptr;
+
+    if (!mapped.data) {
+        LOGE() << "failed to map: " << filePath;
+        return nullptr;
+    }
+
+    size = mapped.size;
+    const uint8_t* result = mapped.data;
+
+    m_files.emplace(filePath, std::move(mapped));
+
+    return result;
+}
+
+SoundFontSampleStore::SamplesLoading SoundFontSampleStore::prefetch(const std::vector<fluid_preset_t*>& presets)
+{
+    auto batch = std::make_shared<DecodingBatch>();
+    SamplesLoading result = batch->promise.get_future().share();
+
+    std::vector<CompressedSample> samples;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_decodedSamplesCachePath.empty()) {
+            for (fluid_preset_t* preset : presets) {
+                //! NOTE Only the presets of the default sound-font loader are known
+                if (!preset || preset->noteon != fluid_defpreset_preset_noteon) {
+                    continue;
+                }
+
+                fluid_defsfont_t* defsfont = static_cast<fluid_defsfont_t*>(fluid_sfont_get_data(preset->sfont));
+                fluid_defpreset_t* defpreset = static_cast<fluid_defpreset_t*>(fluid_preset_get_data(preset));
+
+                for (fluid_preset_zone_t* presetZone = fluid_defpreset_get_zone(defpreset); presetZone;
+                     presetZone = fluid_preset_zone_next(presetZone)) {
+                    fluid_inst_t* inst = fluid_preset_zone_get_inst(presetZone);
+
+                    for (fluid_inst_zone_t* instZone = inst ? fluid_inst_get_zone(inst) : nullptr; instZone;
+                         instZone = fluid_inst_zone_next(instZone)) {
+                        fluid_sample_t* sample = fluid_inst_zone_get_sample(instZone);
+
+                        if (!sample || sample->data || sample->start == sample->end
+                            || !(sample->sampletype & FLUID_SAMPLETYPE_OGG_VORBIS)) {
+                            continue;
+                        }
+
+                        CompressedSample compressed;
+                        compressed.soundFontPath = defsfont->filename;
+                        compressed.samplePos = defsfont->samplepos;
+                        compressed.sampleSize = defsfont->samplesize;
+                        compressed.sampleStart = sample->source_start;
+                        compressed.sampleEnd = sample->source_end;
+                        compressed.sampleType = sample->sampletype;
+                        compressed.key = decodedSampleKey(compressed.soundFontPath, compressed.sampleStart, compressed.sampleEnd);
+
+                        if (m_pendingDecoding.find(compressed.key) != m_pendingDecoding.end()
+                            || m_decodedSamples.find(compressed.key) != m_decodedSamples.end()
+                            || m_failedDecoding.find(compressed.key) != m_failedDecoding.end()) {
+                            continue;
+                        }
+
+                        DecodedSamplesCache* cache = decodedSamplesCache(compressed.soundFontPath);
+                        if (!cache || findDecodedSampleRecord(*cache, compressed.sampleStart, compressed.sampleEnd)) {
+                            continue;
+                        }
+
+                        m_pendingDecoding.emplace(compressed.key, result);
+                        samples.push_back(std::move(compressed));
+                    }
+                }
+            }
+        }
+    }
+
+    if (samples.empty()) {
+        batch->promise.set_value();
+        return result;
+    }
+
+    scheduleDecoding(std::move(samples), batch);
+
+    return result;
+}
+
+void SoundFontSampleStore::scheduleDecoding(std::vector<CompressedSample> samples, std::shared_ptr<DecodingBatch> batch)
+{
+    batch->remaining = samples.size();
+
+    concurrency::ITaskSchedulerPtr scheduler = taskScheduler();
+
+    for (CompressedSample& sample : samples) {
+        auto decode = [this, batch, sample = std::move(sample)]() {
+            decodeInBackground(sample);
+
+            if (--batch->remaining == 0) {
+                batch->promise.set_value();
+            }
+        };
+
+        if (scheduler) {
+            scheduler->schedule(decode);
+        } else {
+            decode();
+        }
+    }
+}
+
+SoundFontSampleStore::SamplesLoading SoundFontSampleStore::loadPendingSamples(const std::vector<fluid_preset_t*>& presets)
+{
+    SamplesLoading stillPending;
+
+    for (fluid_preset_t* preset : presets) {
+        if (!preset || preset->noteon != fluid_defpreset_preset_noteon) {
+            continue;
+        }
+
+        fluid_defsfont_t* defsfont = static_cast<fluid_defsfont_t*>(fluid_sfont_get_data(preset->sfont));
+        fluid_defpreset_t* defpreset = static_cast<fluid_defpreset_t*>(fluid_preset_get_data(preset));
+
+        MappedFileCursor cursor;
+
+        for (fluid_preset_zone_t* presetZone = fluid_defpreset_get_zone(defpreset); presetZone;
+             presetZone = fluid_preset_zone_next(presetZone)) {
+            fluid_inst_t* inst = fluid_preset_zone_get_inst(presetZone);
+
+            for (fluid_inst_zone_t* instZone = inst ? fluid_inst_get_zone(inst) : nullptr; instZone;
+                 instZone = fluid_inst_zone_next(instZone)) {
+                fluid_sample_t* sample = fluid_inst_zone_get_sample(instZone);
+
+                //! NOTE The pending samples are the selected ones that were left without data
+                if (!sample || sample->data || sample->preset_count == 0 || sample->start == sample->end) {
+                    continue;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+
+                    auto pending = m_pendingDecoding.find(decodedSampleKey(defsfont->filename, sample->source_start,
+                                                                           sample->source_end));
+                    if (pending != m_pendingDecoding.end()) {
+                        stillPending = pending->second;
+                        continue;
+                    }
+                }
+
+                if (!cursor.data) {
+                    cursor.data = mapFile(defsfont->filename, cursor.size);
+                }
+
+                if (!cursor.data) {
+                    return stillPending;
+                }
+
+                //! NOTE The decoded samples are provided from the cache, the file is only read if that fails
+                SFData sf;
+                std::memset(&sf, 0, sizeof(sf));
+                sf.fname = defsfont->filename;
+                sf.samplepos = defsfont->samplepos;
+                sf.samplesize = defsfont->samplesize;
+                sf.sample24pos = defsfont->sample24pos;
+                sf.sample24size = defsfont->sample24size;
+                sf.sffd = reinterpret_cast<FILE*>(&cursor);
+                sf.fcbs = &MAPPED_FILE_CALLBACKS;
+
+                int ret = fluid_defsfont_load_sampledata(defsfont, &sf, sample);
+
+                if (ret == FLUID_OK) {
+                    fluid_sample_sanitize_loop(sample, (sample->end + 1) * sizeof(short));
+                    fluid_voice_optimize_sample(sample);
+                } else if (ret != FLUID_SAMPLECACHE_PENDING) {
+                    LOGE() << "unable to load sample: " << sample->name << ", disabling";
+                    sample->start = sample->end = 0;
+                }
+            }
+        }
+    }
+
+    return stillPending;
+}
+
+void SoundFontSampleStore::decodeInBackground(const CompressedSample& sample)
+{
+    MappedFileCursor cursor;
+    cursor.data = mapFile(sample.soundFontPath, cursor.size);
+
+    bool ok = false;
+
+    if (cursor.data) {
+        SFData sf;
+        std::memset(&sf, 0, sizeof(sf));
+        sf.fname = const_cast<char*>(sample.soundFontPath.c_str());
+        sf.samplepos = sample.samplePos;
+        sf.samplesize = sample.sampleSize;
+        sf.sffd = reinterpret_cast<FILE*>(&cursor);
+        sf.fcbs = &MAPPED_FILE_CALLBACKS;
+
+        ok = decodeSampleData(&sf, sample);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pendingDecoding.erase(sample.key);
+
+    //! NOTE The failed samples aren't decoded again, otherwise they would stay pending forever
+    if (!ok) {
+        LOGE() << "failed to decode the sample: " << sample.key;
+        m_failedDecoding.insert(sample.key);
+    }
+}
+
+int SoundFontSampleStore::provideSampleData(SFData* sf, unsigned int sampleStart, unsigned int sampleEnd, int sampleType,
+                                            short** data, char** data24)
+{
+    SoundFontSampleStore* store = instance();
+
+    if (sampleType & FLUID_SAMPLETYPE_OGG_VORBIS) {
+        return store->mapDecodedSampleData(sf, sampleStart, sampleEnd, sampleType, data);
+    }
+
+    return store->mapPcmSampleData(sf, sampleStart, sampleEnd, data, data24);
+}
+
+void SoundFontSampleStore::releaseSampleData(const short* data)
+{
+    SoundFontSampleStore* store = instance();
+
+    std::lock_guard<std::mutex> lock(store->m_mutex);
+
+    auto search = store->m_decodedSamplesKeys.find(data);
+    if (search == store->m_decodedSamplesKeys.end()) {
+        return;
+    }
+
+    DecodedSample& sample = store->m_decodedSamples[search->second];
+    sample.references--;
+    sample.lastUsed = ++store->m_usageCounter;
+
+    store->unmapUnusedDecodedSamples();
+}
+
+int SoundFontSampleStore::mapPcmSampleData(SFData* sf, unsigned int sampleStart, unsigned int sampleEnd, short** data,
+                                           char** data24)
+{
+    //! NOTE The samples are stored as little endian 16-bit words, so they can be used as they are only on little endian machines
+    if (!isLittleEndian() || sampleEnd < sampleStart) {
+        return -1;
+    }
+
+    if (sampleStart * sizeof(short) > sf->samplesize || sampleEnd * sizeof(short) > sf->samplesize) {
+        return -1;
+    }
+
+    size_t fileSize = 0;
+    const uint8_t* fileData = mapFile(sf->fname, fileSize);
+
+    size_t dataOffset = sf->samplepos + sampleStart * sizeof(short);
+    int sampleCount = static_cast<int>(sampleEnd - sampleStart + 1);
+
+    if (!fileData || dataOffset + sampleCount * sizeof(short) > fileSize) {
+        return -1;
+    }
+
+    if (reinterpret_cast<uintptr_t>(fileData + dataOffset) % alignof(short) != 0) {
+        return -1;
+    }
+
+    *data = reinterpret_cast<short*>(const_cast<uint8_t*>(fileData + dataOffset));
+    *data24 = nullptr;
+
+    if (sf->sample24pos && sampleStart <= sf->sample24size && sampleEnd <= sf->sample24size
+        && sf->sample24pos + sampleEnd < fileSize) {
+        *data24 = reinterpret_cast<char*>(const_cast<uint8_t*>(fileData + sf->sample24pos + sampleStart));
+    }
+
+    return sampleCount;
+}
+
+int SoundFontSampleStore::mapDecodedSampleData(SFData* sf, unsigned int sampleStart, unsigned int sampleEnd, int sampleType,
+                                               short** data)
+{
+    CompressedSample sample;
+    sample.soundFontPath = sf->fname;
+    sample.samplePos = sf->samplepos;
+    sample.sampleSize = sf->samplesize;
+    sample.sampleStart = sampleStart;
+    sample.sampleEnd = sampleEnd;
+    sample.sampleType = sampleType;
+    sample.key = decodedSampleKey(sample.soundFontPath, sampleStart, sampleEnd);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    //! NOTE Doesn't wait for the background decoding, the sample is loaded once it's ready (see loadPendingSamples)
+    if (m_pendingDecoding.find(sample.key) != m_pendingDecoding.end()) {
+        return FLUID_SAMPLECACHE_PENDING;
+    }
+
+    if (m_failedDecoding.find(sample.key) != m_failedDecoding.end()) {
+        return -1;
+    }
+
+    auto useMappedSample = [this, data](DecodedSample& decoded) {
+        decoded.references++;
+        decoded.lastUsed = ++m_usageCounter;
+        *data = const_cast<short*>(decoded.data);
+        return decoded.sampleCount;
+    };
+
+    auto search = m_decodedSamples.find(sample.key);
+    if (search != m_decodedSamples.end()) {
+        return useMappedSample(search->second);
+    }
+
+    DecodedSamplesCache* cache = decodedSamplesCache(sample.soundFontPath);
+    if (!cache) {
+        return -1;
+    }
+
+    //! NOTE The sample wasn't prefetched (e.g. a program change during the playback), so it's decoded
+    //!      in the background as well instead of blocking the caller, which is usually the audio thread
+    const DecodedSampleRecord* record = findDecodedSampleRecord(*cache, sampleStart, sampleEnd);
+    if (!record) {
+        auto batch = std::make_shared<DecodingBatch>();
+        m_pendingDecoding.emplace(sample.key, batch->promise.get_future().share());
+
+        lock.unlock();
+
+        scheduleDecoding({ sample }, batch);
+
+        return FLUID_SAMPLECACHE_PENDING;
+    }
+
+    uint8_t* mapping = cache->file->map(record->offset, record->size);
+    if (!mapping) {
+        LOGE() << "failed to map the decoded samples: " << cache->file->fileName();
+        return -1;
+    }
+
+    DecodedSampleHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+
+    DecodedSample& decoded = m_decodedSamples[sample.key];
+    decoded.soundFontPath = sample.soundFontPath;
+    decoded.mapping = mapping;
+    decoded.data = reinterpret_cast<const short*>(mapping + sizeof(header));
+    decoded.sampleCount = static_cast<int>(header.sampleCount);
+    decoded.size = static_cast<size_t>(record->size);
+
+    m_decodedSamplesKeys[decoded.data] = sample.key;
+
+    return useMappedSample(decoded);
+}
+
+bool SoundFontSampleStore::decodeSampleData(SFData* sf, const CompressedSample& sample)
+{
+    short* decodedData = nullptr;
+    char* decodedData24 = nullptr;
+
+    int sampleCount = fluid_sffile_read_sample_data(sf, sample.sampleStart, sample.sampleEnd, sample.sampleType,
+                                                    &decodedData, &decodedData24);
+    fluid_free(decodedData24);
+
+    if (sampleCount <= 0) {
+        fluid_free(decodedData);
+        return false;
+    }
+
+    bool ok = false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        DecodedSamplesCache* cache = decodedSamplesCache(sample.soundFontPath);
+        ok = cache && appendDecodedSample(*cache, sample, decodedData, sampleCount);
+    }
+
+    fluid_free(decodedData);
+
+    return ok;
+}
+
+std::string SoundFontSampleStore::decodedSampleKey(const std::string& soundFontPath, unsigned int sampleStart,
+                                                   unsigned int sampleEnd)
+{
+    return soundFontPath + ":" + std::to_string(sampleStart) + ":" + std::to_string(sampleEnd);
+}
+
+SoundFontSampleStore::DecodedSamplesCache* SoundFontSampleStore::decodedSamplesCache(const std::string& soundFontPath)
+{
+    if (m_decodedSamplesCachePath.empty()) {
+        return nullptr;
+    }
+
+    auto search = m_decodedSamplesCaches.find(soundFontPath);
+    if (search != m_decodedSamplesCaches.end()) {
+        return &search->second;
+    }
+
+    QFileInfo info(QString::fromStdString(soundFontPath));
+
+    std::string key = soundFontPath
+                      + ":" + std::to_string(info.size())
+                      + ":" + std::to_string(info.lastModified().toSecsSinceEpoch());
+
+    QString fileName = QString::number(static_cast<qulonglong>(std::hash<std::string> {}(key)), 16) + ".smp";
+    io::path_t filePath = m_decodedSamplesCachePath.appendingComponent(io::path_t(fileName));
+
+    DecodedSamplesCache cache;
+    cache.file = std::make_unique<QFile>(filePath.toQString());
+    cache.lockFilePath = filePath + ".lock";
+    cache.sourceSize = static_cast<uint64_t>(info.size());
+
+    if (!cache.file->open(QIODevice::ReadWrite)) {
+        LOGE() << "failed to open the decoded samples cache: " << filePath;
+        return nullptr;
+    }
+
+    indexDecodedSamplesCache(cache);
+
+    return &m_decodedSamplesCaches.emplace(soundFontPath, std::move(cache)).first->second;
+}
+
+const SoundFontSampleStore::DecodedSampleRecord* SoundFontSampleStore::findDecodedSampleRecord(DecodedSamplesCache& cache,
+                                                                                              unsigned int sampleStart,
+                                                                                              unsigned int sampleEnd) const
+{
+    auto search = cache.records.find({ sampleStart, sampleEnd });
+    if (search != cache.records.end()) {
+        return &search->second;
+    }
+
+    //! NOTE Picks up the samples appended by other processes, only on a miss to keep the file access off the hits
+    indexDecodedSamplesCache(cache);
+
+    search = cache.records.find({ sampleStart, sampleEnd });
+    return search != cache.records.end() ? &search->second : nullptr;
+}
+
+void SoundFontSampleStore::indexDecodedSamplesCache(DecodedSamplesCache& cache) const
+{
+    const int64_t fileSize = cache.file->size();
+
+    while (cache.indexedSize + static_cast<int64_t>(sizeof(DecodedSampleHeader)) <= fileSize) {
+        DecodedSampleHeader header;
+
+        if (!cache.file->seek(cache.indexedSize)
+            || cache.file->read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header)) {
+            return;
+        }
+
+        if (std::memcmp(header.magic, DECODED_SAMPLE_MAGIC, sizeof(header.magic)) != 0
+            || header.version != DECODED_SAMPLE_VERSION) {
+            LOGW() << "invalid decoded samples cache: " << cache.file->fileName();
+            return;
+        }
+
+        DecodedSampleRecord record;
+        record.offset = cache.indexedSize;
+        record.size = decodedSampleRecordSize(header.sampleCount);
+
+        //! NOTE The rest of the record is still being written by another process
+        if (record.offset + record.size > fileSize) {
+            return;
+        }
+
+        if (header.sourceSize == cache.sourceSize) {
+            cache.records[{ header.sampleStart, header.sampleEnd }] = record;
+        }
+
+        cache.indexedSize += record.size;
+    }
+}
+
+bool SoundFontSampleStore::appendDecodedSample(DecodedSamplesCache& cache, const CompressedSample& sample, const short* data,
+                                               int sampleCount)
+{
+    //! NOTE Serializes the appending with the other processes sharing the cache
+    QLockFile lockFile(cache.lockFilePath.toQString());
+    if (!lockFile.lock()) {
+        LOGW() << "failed to lock the decoded samples cache: " << cache.file->fileName();
+        return false;
+    }
+
+    indexDecodedSamplesCache(cache);
+
+    if (cache.records.find({ sample.sampleStart, sample.sampleEnd }) != cache.records.end()) {
+        return true;
+    }
+
+    //! NOTE Drops the incomplete record left by an interrupted writer
+    if (cache.file->size() != cache.indexedSize && !cache.file->resize(cache.indexedSize)) {
+        LOGW() << "failed to truncate the decoded samples cache: " << cache.file->fileName();
+        return false;
+    }
+
+    DecodedSampleHeader header;
+    std::memcpy(header.magic, DECODED_SAMPLE_MAGIC, sizeof(header.magic));
+    header.version = DECODED_SAMPLE_VERSION;
+    header.sampleStart = sample.sampleStart;
+    header.sampleEnd = sample.sampleEnd;
+    header.sampleCount = static_cast<uint32_t>(sampleCount);
+    header.sourceSize = cache.sourceSize;
+
+    const qint64 dataSize = static_cast<qint64>(sampleCount * sizeof(short));
+
+    bool ok = cache.file->seek(cache.indexedSize);
+    ok = ok && cache.file->write(reinterpret_cast<const char*>(&header), sizeof(header)) == sizeof(header);
+    ok = ok && cache.file->write(reinterpret_cast<const char*>(data), dataSize) == dataSize;
+    ok = ok && cache.file->flush();
+
+    if (!ok) {
+        LOGW() << "failed to write the decoded samples cache: " << cache.file->fileName();
+        cache.file->resize(cache.indexedSize);
+        return false;
+    }
+
+    DecodedSampleRecord record;
+    record.offset = cache.indexedSize;
+    record.size = decodedSampleRecordSize(header.sampleCount);
+
+    cache.records[{ sample.sampleStart, sample.sampleEnd }] = record;
+    cache.indexedSize += record.size;
+
+    return true;
+}
+
+void SoundFontSampleStore::unmapUnusedDecodedSamples()
+{
+    size_t unusedSize = 0;
+    for (const auto& pair : m_decodedSamples) {
+        if (pair.second.references <= 0) {
+            unusedSize += pair.second.size;
+        }
+    }
+
+    while (unusedSize > m_unusedDecodedSamplesBudget) {
+        auto leastRecentlyUsed = m_decodedSamples.end();
+
+        for (auto it = m_decodedSamples.begin(); it != m_decodedSamples.end(); ++it) {
+            if (it->second.references > 0) {
+                continue;
+            }
+
+            if (leastRecentlyUsed == m_decodedSamples.end() || it->second.lastUsed < leastRecentlyUsed->second.lastUsed) {
+                leastRecentlyUsed = it;
+            }
+        }
+
+        if (leastRecentlyUsed == m_decodedSamples.end()) {
+            break;
+        }
+
+        unusedSize -= leastRecentlyUsed->second.size;
+
+        const DecodedSample& sample = leastRecentlyUsed->second;
+
+        auto cache = m_decodedSamplesCaches.find(sample.soundFontPath);
+        if (cache != m_decodedSamplesCaches.end()) {
+            cache->second.file->unmap(sample.mapping);
+        }
+
+        m_decodedSamplesKeys.erase(sample.data);
+        m_decodedSamples.erase(leastRecentlyUsed);
+    }
+}
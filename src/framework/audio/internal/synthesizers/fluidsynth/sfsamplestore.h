@@ -0,0 +1,171 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_SFSAMPLESTORE_H
+#define MU_AUDIO_SFSAMPLESTORE_H
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "modularity/ioc.h"
+#include "concurrency/itaskscheduler.h"
+#include "io/path.h"
+
+class QFile;
+
+extern "C" {
+typedef struct _SFData SFData;
+typedef struct _fluid_preset_t fluid_preset_t;
+}
+
+namespace mu::audio::synth {
+/**
+ * @brief The SoundFontSampleStore class
+ * @details Memory maps the sound-font files, so that the uncompressed (SF2) sample data is served
+ *          directly from the page cache instead of being copied to the heap by each Fluid instance.
+ *          The decoded Ogg Vorbis (SF3) samples are appended to a single cache file per sound-font on disk
+ *          and each of them is memory mapped from there, so several processes share the physical memory
+ *          and the decoding happens only once.
+ *          The decoded samples which aren't used by any preset anymore stay mapped until they exceed the budget,
+ *          then the least recently used ones get unmapped.
+ *          The budget doesn't bound the samples in use: they stay mapped as long as a preset references them,
+ *          so their address space grows with the selected presets. They are file backed mappings though,
+ *          so the system can reclaim their pages under memory pressure
+ */
+class SoundFontSampleStore
+{
+    INJECT(audio, concurrency::ITaskScheduler, taskScheduler)
+
+public:
+    static SoundFontSampleStore* instance();
+
+    //! NOTE The budget is in bytes and applies only to the decoded samples no preset uses
+    void init(const io::path_t& decodedSamplesCachePath, size_t unusedDecodedSamplesBudget);
+
+    const uint8_t* mapFile(const std::string& filePath, size_t& size);
+
+    using SamplesLoading = std::shared_future<void>;
+
+    //! NOTE Decodes the compressed samples of the given presets on the task scheduler,
+    //!      so that selecting these presets doesn't block the audio thread.
+    //!      The samples which are still being decoded are left without data by the selection (see loadPendingSamples)
+    SamplesLoading prefetch(const std::vector<fluid_preset_t*>& presets);
+
+    //! NOTE Loads the data of the samples of the selected presets which were still being decoded at the selection.
+    //!      Returns the decoding to wait for, if some of them still aren't ready (otherwise an invalid one)
+    SamplesLoading loadPendingSamples(const std::vector<fluid_preset_t*>& presets);
+
+private:
+    SoundFontSampleStore() = default;
+    ~SoundFontSampleStore();
+
+    struct CompressedSample {
+        std::string soundFontPath;
+        unsigned int samplePos = 0;
+        unsigned int sampleSize = 0;
+        unsigned int sampleStart = 0;
+        unsigned int sampleEnd = 0;
+        int sampleType = 0;
+        std::string key;
+    };
+
+    struct MappedFile {
+        std::unique_ptr<QFile> file;
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+    };
+
+    struct DecodedSampleRecord {
+        int64_t offset = 0;
+        int64_t size = 0;
+    };
+
+    //! NOTE The decoded samples of one sound-font, each one preceded by its header
+    struct DecodedSamplesCache {
+        std::unique_ptr<QFile> file;
+        io::path_t lockFilePath;
+        uint64_t sourceSize = 0;
+        std::map<std::pair<unsigned int, unsigned int>, DecodedSampleRecord> records;
+        int64_t indexedSize = 0;
+    };
+
+    struct DecodedSample {
+        std::string soundFontPath;
+        uint8_t* mapping = nullptr;
+        const short* data = nullptr;
+        int sampleCount = 0;
+        size_t size = 0;
+        int references = 0;
+        uint64_t lastUsed = 0;
+    };
+
+    static int provideSampleData(SFData* sf, unsigned int sampleStart, unsigned int sampleEnd, int sampleType,
+                                 short** data, char** data24);
+    static void releaseSampleData(const short* data);
+
+    int mapPcmSampleData(SFData* sf, unsigned int sampleStart, unsigned int sampleEnd, short** data, char** data24);
+    int mapDecodedSampleData(SFData* sf, unsigned int sampleStart, unsigned int sampleEnd, int sampleType, short** data);
+
+    struct DecodingBatch {
+        std::atomic<size_t> remaining { 0 };
+        std::promise<void> promise;
+    };
+
+    bool decodeSampleData(SFData* sf, const CompressedSample& sample);
+    void decodeInBackground(const CompressedSample& sample);
+
+    //! NOTE Expects the samples to be registered in m_pendingDecoding with the future of the batch
+    void scheduleDecoding(std::vector<CompressedSample> samples, std::shared_ptr<DecodingBatch> batch);
+
+    static std::string decodedSampleKey(const std::string& soundFontPath, unsigned int sampleStart, unsigned int sampleEnd);
+
+    //! NOTE The following methods expect m_mutex to be locked
+    DecodedSamplesCache* decodedSamplesCache(const std::string& soundFontPath);
+    const DecodedSampleRecord* findDecodedSampleRecord(DecodedSamplesCache& cache, unsigned int sampleStart,
+                                                       unsigned int sampleEnd) const;
+    void indexDecodedSamplesCache(DecodedSamplesCache& cache) const;
+    bool appendDecodedSample(DecodedSamplesCache& cache, const CompressedSample& sample, const short* data, int sampleCount);
+    void unmapUnusedDecodedSamples();
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, MappedFile> m_files;
+    io::path_t m_decodedSamplesCachePath;
+
+    std::unordered_map<std::string, DecodedSamplesCache> m_decodedSamplesCaches;
+    std::unordered_map<std::string, DecodedSample> m_decodedSamples;
+    std::unordered_map<const short*, std::string> m_decodedSamplesKeys;
+    std::unordered_map<std::string, SamplesLoading> m_pendingDecoding;
+    std::unordered_set<std::string> m_failedDecoding;
+    size_t m_unusedDecodedSamplesBudget = 0;
+    uint64_t m_usageCounter = 0;
+};
+}
+
+#endif // MU_AUDIO_SFSAMPLESTORE_H
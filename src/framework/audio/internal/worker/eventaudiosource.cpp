@@ -36,8 +36,8 @@ EventAudioSource::EventAudioSource(const TrackId trackId, const mpe::PlaybackDat
 {
     ONLY_AUDIO_WORKER_THREAD;
 
-    m_playbackData.mainStream.onReceive(this, [this](const PlaybackEventsMap& events) {
-        m_playbackData.originEvents = events;
+    m_playbackData.mainStream.onReceive(this, [this](const PlaybackEventsChunk& events) {
+        events.applyTo(m_playbackData.originEvents);
     });
 }
 
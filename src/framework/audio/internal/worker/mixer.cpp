@@ -22,6 +22,7 @@
 #include "mixer.h"
 
 #include "async/async.h"
+#include "tracer.h"
 #include "log.h"
 
 #include <limits>
@@ -115,6 +116,7 @@ unsigned int Mixer::audioChannelsCount() const
 samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
 {
     ONLY_AUDIO_WORKER_THREAD;
+    TRACE_SCOPE("audio", "Mixer::process");
 
     for (IClockPtr clock : m_clocks) {
         clock->forward((samplesPerChannel * 1000) / m_sampleRate);
@@ -225,13 +227,7 @@ void Mixer::mixOutputFromChannel(float* outBuffer, float* inBuffer, unsigned int
         return;
     }
 
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-        for (samples_t s = 0; s < samplesCount; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
-
-            outBuffer[idx] += inBuffer[idx];
-        }
-    }
+    dsp::audioKernels().mixAdd(outBuffer, inBuffer, samplesCount * audioChannelsCount());
 }
 
 void Mixer::completeOutput(float* buffer, const samples_t& samplesPerChannel)
@@ -242,23 +238,15 @@ void Mixer::completeOutput(float* buffer, const samples_t& samplesPerChannel)
 
     float totalSquaredSum = 0.f;
 
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-        float singleChannelSquaredSum = 0.f;
-
-        gain_t totalGain = dsp::balanceGain(m_masterParams.balance, audioChNum) * dsp::linearFromDecibels(m_masterParams.volume);
-
-        for (samples_t s = 0; s < samplesPerChannel; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
-
-            float resultSample = buffer[idx] * totalGain;
-            buffer[idx] = resultSample;
+    const std::vector<float>& squaredSums = m_gainsRamp.apply(buffer, audioChannelsCount(), samplesPerChannel,
+                                                              [this](const audioch_t audioChNum) {
+        return dsp::balanceGain(m_masterParams.balance, audioChNum) * dsp::linearFromDecibels(m_masterParams.volume);
+    });
 
-            float squaredSample = resultSample * resultSample;
-            totalSquaredSum += squaredSample;
-            singleChannelSquaredSum += squaredSample;
-        }
+    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
+        totalSquaredSum += squaredSums[audioChNum];
 
-        float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesPerChannel);
+        float rms = dsp::samplesRootMeanSquare(squaredSums[audioChNum], samplesPerChannel);
         notifyAboutAudioSignalChanges(audioChNum, rms);
     }
 
@@ -31,6 +31,7 @@
 #include "abstractaudiosource.h"
 #include "mixerchannel.h"
 #include "internal/dsp/limiter.h"
+#include "internal/dsp/audiokernels.h"
 #include "ifxresolver.h"
 #include "iclock.h"
 
@@ -77,6 +78,7 @@ private:
 
     std::map<TrackId, MixerChannelPtr> m_mixerChannels = {};
     dsp::LimiterPtr m_limiter = nullptr;
+    dsp::ChannelGainsRamp m_gainsRamp;
 
     std::set<IClockPtr> m_clocks;
     audioch_t m_audioChannelsCount = 0;
@@ -0,0 +1,277 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "internal/dsp/audiokernels.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::dsp;
+
+static const std::vector<InstructionSet> VECTOR_INSTRUCTION_SETS = { InstructionSet::SSE2, InstructionSet::AVX2 };
+
+class AudioKernelsTest : public ::testing::Test
+{
+protected:
+    std::vector<float> randomSamples(const size_t count)
+    {
+        std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+
+        std::vector<float> result(count);
+        for (float& sample : result) {
+            sample = distribution(m_randomEngine);
+        }
+
+        return result;
+    }
+
+    static bool isBitIdentical(const std::vector<float>& first, const std::vector<float>& second)
+    {
+        return first.size() == second.size()
+               && std::memcmp(first.data(), second.data(), first.size() * sizeof(float)) == 0;
+    }
+
+    std::mt19937 m_randomEngine { 42 };
+};
+
+/**
+ * @brief AudioKernelsTest_MixAdd_BitAccuracy
+ * @details The vectorized mix-add must produce exactly the same output as the scalar one
+ *          for any buffer size, including the ones which aren't multiple of the vector width
+ */
+TEST_F(AudioKernelsTest, MixAdd_BitAccuracy)
+{
+    for (size_t count : { 0, 1, 3, 8, 17, 1024, 1031 }) {
+        // [GIVEN] Two random buffers
+        std::vector<float> out = randomSamples(count);
+        std::vector<float> in = randomSamples(count);
+
+        // [WHEN] Mixing them by the scalar kernel
+        std::vector<float> expected = out;
+        audioKernels(InstructionSet::Scalar).mixAdd(expected.data(), in.data(), count);
+
+        // [THEN] Every supported instruction set produces the same result
+        for (InstructionSet instructionSet : VECTOR_INSTRUCTION_SETS) {
+            std::vector<float> actual = out;
+            audioKernels(instructionSet).mixAdd(actual.data(), in.data(), count);
+
+            EXPECT_TRUE(isBitIdentical(expected, actual)) << "count: " << count;
+        }
+    }
+}
+
+/**
+ * @brief AudioKernelsTest_ApplyGain_BitAccuracy
+ * @details The limiter/compressor gain application must be the same for all the instruction sets
+ */
+TEST_F(AudioKernelsTest, ApplyGain_BitAccuracy)
+{
+    for (size_t count : { 0, 5, 16, 1023 }) {
+        // [GIVEN] Random buffer
+        std::vector<float> buffer = randomSamples(count);
+
+        // [WHEN] Applying the gain by the scalar kernel
+        std::vector<float> expected = buffer;
+        audioKernels(InstructionSet::Scalar).applyGain(expected.data(), count, 0.3162f);
+
+        // [THEN] Every supported instruction set produces the same result
+        for (InstructionSet instructionSet : VECTOR_INSTRUCTION_SETS) {
+            std::vector<float> actual = buffer;
+            audioKernels(instructionSet).applyGain(actual.data(), count, 0.3162f);
+
+            EXPECT_TRUE(isBitIdentical(expected, actual)) << "count: " << count;
+        }
+    }
+}
+
+/**
+ * @brief AudioKernelsTest_ApplyChannelGains_BitAccuracy
+ * @details The gain ramping and the squared sums (RMS metering) must be the same for all the instruction sets,
+ *          both for the channel layouts which fit the vector lanes and for the ones which don't
+ */
+TEST_F(AudioKernelsTest, ApplyChannelGains_BitAccuracy)
+{
+    for (audioch_t audioChannelsCount : { 1, 2, 3, 4, 6, 8 }) {
+        for (samples_t samplesPerChannel : { 1, 7, 64, 511, 512 }) {
+            // [GIVEN] Random interleaved buffer
+            std::vector<float> buffer = randomSamples(samplesPerChannel * audioChannelsCount);
+
+            // [GIVEN] Some of the channels ramp their gain, the others keep it
+            std::vector<gain_t> gainsFrom = randomSamples(audioChannelsCount);
+            std::vector<gain_t> gainsTo = gainsFrom;
+            for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount; audioChNum += 2) {
+                gainsTo[audioChNum] *= 0.5f;
+            }
+
+            // [WHEN] Applying the gains by the scalar kernel
+            std::vector<float> expected = buffer;
+            std::vector<float> expectedSquaredSums(audioChannelsCount);
+            audioKernels(InstructionSet::Scalar).applyChannelGains(expected.data(), audioChannelsCount, samplesPerChannel,
+                                                                   gainsFrom.data(), gainsTo.data(), expectedSquaredSums.data());
+
+            // [THEN] Every supported instruction set produces the same samples and squared sums
+            for (InstructionSet instructionSet : VECTOR_INSTRUCTION_SETS) {
+                std::vector<float> actual = buffer;
+                std::vector<float> actualSquaredSums(audioChannelsCount);
+                audioKernels(instructionSet).applyChannelGains(actual.data(), audioChannelsCount, samplesPerChannel,
+                                                               gainsFrom.data(), gainsTo.data(), actualSquaredSums.data());
+
+                EXPECT_TRUE(isBitIdentical(expected, actual))
+                    << "channels: " << int(audioChannelsCount) << ", samples: " << samplesPerChannel;
+                EXPECT_TRUE(isBitIdentical(expectedSquaredSums, actualSquaredSums))
+                    << "channels: " << int(audioChannelsCount) << ", samples: " << samplesPerChannel;
+            }
+        }
+    }
+}
+
+/**
+ * @brief AudioKernelsTest_ApplyChannelGains_Ramp
+ * @details The constant gains are applied as they are, the changed ones start from the previous gain
+ *          and get close to the new one by the end of the block
+ */
+TEST_F(AudioKernelsTest, ApplyChannelGains_Ramp)
+{
+    // [GIVEN] Stereo buffer filled with ones
+    const audioch_t audioChannelsCount = 2;
+    const samples_t samplesPerChannel = 100;
+    std::vector<float> buffer(samplesPerChannel * audioChannelsCount, 1.f);
+
+    // [GIVEN] The left channel keeps its gain, the right one gets silenced
+    gain_t gainsFrom[] = { 0.5f, 1.f };
+    gain_t gainsTo[] = { 0.5f, 0.f };
+    float squaredSums[audioChannelsCount] = {};
+
+    // [WHEN] Applying the gains
+    audioKernels().applyChannelGains(buffer.data(), audioChannelsCount, samplesPerChannel, gainsFrom, gainsTo, squaredSums);
+
+    // [THEN] The left channel is just multiplied by the gain
+    for (samples_t s = 0; s < samplesPerChannel; ++s) {
+        EXPECT_FLOAT_EQ(buffer[s * audioChannelsCount], 0.5f);
+    }
+
+    // [THEN] The right channel fades out linearly
+    EXPECT_FLOAT_EQ(buffer[1], 1.f);
+    EXPECT_FLOAT_EQ(buffer[(samplesPerChannel / 2) * audioChannelsCount + 1], 0.5f);
+    EXPECT_NEAR(buffer[(samplesPerChannel - 1) * audioChannelsCount + 1], 0.01f, 1e-6f);
+
+    // [THEN] The squared sums match the output
+    EXPECT_FLOAT_EQ(squaredSums[0], 0.25f * samplesPerChannel);
+    EXPECT_NEAR(squaredSums[1], 33.835f, 1e-3f);
+}
+
+/**
+ * @brief AudioKernelsTest_ChannelGainsRamp_VolumeChange
+ * @details The first block is played at the current gain right away, a volume change is ramped
+ *          over the next block only, the blocks after it are played at the new gain
+ */
+TEST_F(AudioKernelsTest, ChannelGainsRamp_VolumeChange)
+{
+    const audioch_t audioChannelsCount = 2;
+    const samples_t samplesPerChannel = 100;
+
+    ChannelGainsRamp ramp;
+    gain_t volume = 0.5f;
+    auto channelGain = [&volume](audioch_t) { return volume; };
+
+    // [WHEN] Processing the first block
+    std::vector<float> buffer(samplesPerChannel * audioChannelsCount, 1.f);
+    ramp.apply(buffer.data(), audioChannelsCount, samplesPerChannel, channelGain);
+
+    // [THEN] There is no fade in, the gain is applied from the first sample
+    for (float sample : buffer) {
+        EXPECT_FLOAT_EQ(sample, 0.5f);
+    }
+
+    // [WHEN] Changing the volume and processing the next block
+    volume = 1.f;
+    buffer.assign(samplesPerChannel * audioChannelsCount, 1.f);
+    ramp.apply(buffer.data(), audioChannelsCount, samplesPerChannel, channelGain);
+
+    // [THEN] Both channels ramp from the previous volume towards the new one
+    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
+        EXPECT_FLOAT_EQ(buffer[audioChNum], 0.5f);
+        EXPECT_FLOAT_EQ(buffer[(samplesPerChannel / 2) * audioChannelsCount + audioChNum], 0.75f);
+        EXPECT_NEAR(buffer[(samplesPerChannel - 1) * audioChannelsCount + audioChNum], 0.995f, 1e-6f);
+    }
+
+    // [WHEN] Processing one more block without changes
+    buffer.assign(samplesPerChannel * audioChannelsCount, 1.f);
+    const std::vector<float>& squaredSums = ramp.apply(buffer.data(), audioChannelsCount, samplesPerChannel, channelGain);
+
+    // [THEN] The new volume is applied as it is
+    for (float sample : buffer) {
+        EXPECT_FLOAT_EQ(sample, 1.f);
+    }
+
+    EXPECT_FLOAT_EQ(squaredSums[0], float(samplesPerChannel));
+    EXPECT_FLOAT_EQ(squaredSums[1], float(samplesPerChannel));
+}
+
+/**
+ * @brief AudioKernelsTest_ChannelGainsRamp_BalanceChange
+ * @details A balance change moves the gain of each channel separately: the ramps go in the opposite directions
+ */
+TEST_F(AudioKernelsTest, ChannelGainsRamp_BalanceChange)
+{
+    const audioch_t audioChannelsCount = 2;
+    const samples_t samplesPerChannel = 100;
+
+    ChannelGainsRamp ramp;
+    balance_t balance = 0.f;
+    auto channelGain = [&balance](audioch_t audioChNum) {
+        return audioChNum == 0 ? 1.f - std::max(balance, 0.f) : 1.f + std::min(balance, 0.f);
+    };
+
+    // [GIVEN] The centered balance was already applied
+    std::vector<float> buffer(samplesPerChannel * audioChannelsCount, 1.f);
+    ramp.apply(buffer.data(), audioChannelsCount, samplesPerChannel, channelGain);
+
+    // [WHEN] Panning fully to the left
+    balance = -1.f;
+    buffer.assign(samplesPerChannel * audioChannelsCount, 1.f);
+    ramp.apply(buffer.data(), audioChannelsCount, samplesPerChannel, channelGain);
+
+    // [THEN] The left channel keeps its gain, the right one fades out over the block
+    for (samples_t s = 0; s < samplesPerChannel; ++s) {
+        EXPECT_FLOAT_EQ(buffer[s * audioChannelsCount], 1.f);
+    }
+
+    EXPECT_FLOAT_EQ(buffer[1], 1.f);
+    EXPECT_FLOAT_EQ(buffer[(samplesPerChannel / 2) * audioChannelsCount + 1], 0.5f);
+    EXPECT_NEAR(buffer[(samplesPerChannel - 1) * audioChannelsCount + 1], 0.01f, 1e-6f);
+
+    // [WHEN] Switching to mono
+    buffer.assign(samplesPerChannel, 1.f);
+    ramp.apply(buffer.data(), 1, samplesPerChannel, [](audioch_t) { return 0.25f; });
+
+    // [THEN] The new layout doesn't ramp from the gains of the old one
+    for (float sample : buffer) {
+        EXPECT_FLOAT_EQ(sample, 0.25f);
+    }
+}
@@ -0,0 +1,104 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+#include "internal/dsp/audiokernels.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::dsp;
+
+//! NOTE The benchmarks are disabled by default, run them by:
+//!      audio_benchmarks --gtest_also_run_disabled_tests --gtest_filter=AudioKernelsBenchmark.*
+class AudioKernelsBenchmark : public ::testing::Test
+{
+protected:
+    static constexpr audioch_t AUDIO_CHANNELS_COUNT = 2;
+    static constexpr samples_t SAMPLES_PER_CHANNEL = 1024;
+    static constexpr int ITERATIONS_COUNT = 100000;
+
+    template<typename Kernel>
+    void measure(const std::string& kernelName, Kernel kernel)
+    {
+        for (InstructionSet instructionSet : { InstructionSet::Scalar, InstructionSet::SSE2, InstructionSet::AVX2 }) {
+            if (instructionSet > bestSupportedInstructionSet()) {
+                continue;
+            }
+
+            std::vector<float> out(AUDIO_CHANNELS_COUNT * SAMPLES_PER_CHANNEL, 0.f);
+            std::vector<float> in(AUDIO_CHANNELS_COUNT * SAMPLES_PER_CHANNEL, 0.5f);
+
+            auto start = std::chrono::steady_clock::now();
+
+            for (int i = 0; i < ITERATIONS_COUNT; ++i) {
+                kernel(audioKernels(instructionSet), out.data(), in.data());
+            }
+
+            auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+            LOGI() << kernelName << " [" << instructionSetName(instructionSet) << "]: "
+                   << duration.count() / ITERATIONS_COUNT << " ns per block of " << SAMPLES_PER_CHANNEL << " samples";
+        }
+    }
+
+    static std::string instructionSetName(const InstructionSet instructionSet)
+    {
+        switch (instructionSet) {
+        case InstructionSet::Scalar: return "Scalar";
+        case InstructionSet::SSE2: return "SSE2";
+        case InstructionSet::AVX2: return "AVX2";
+        }
+
+        return std::string();
+    }
+};
+
+TEST_F(AudioKernelsBenchmark, DISABLED_MixAdd)
+{
+    measure("mixAdd", [](const AudioKernels& kernels, float* out, const float* in) {
+        kernels.mixAdd(out, in, AUDIO_CHANNELS_COUNT * SAMPLES_PER_CHANNEL);
+    });
+}
+
+TEST_F(AudioKernelsBenchmark, DISABLED_ApplyGain)
+{
+    measure("applyGain", [](const AudioKernels& kernels, float* out, const float*) {
+        kernels.applyGain(out, AUDIO_CHANNELS_COUNT * SAMPLES_PER_CHANNEL, 0.999f);
+    });
+}
+
+TEST_F(AudioKernelsBenchmark, DISABLED_ApplyChannelGains)
+{
+    const gain_t gainsFrom[AUDIO_CHANNELS_COUNT] = { 0.8f, 0.9f };
+    const gain_t gainsTo[AUDIO_CHANNELS_COUNT] = { 0.9f, 0.8f };
+
+    measure("applyChannelGains", [&gainsFrom, &gainsTo](const AudioKernels& kernels, float* out, const float*) {
+        float squaredSums[AUDIO_CHANNELS_COUNT];
+        kernels.applyChannelGains(out, AUDIO_CHANNELS_COUNT, SAMPLES_PER_CHANNEL, gainsFrom, gainsTo, squaredSums);
+    });
+}
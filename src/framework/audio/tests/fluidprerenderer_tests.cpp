@@ -0,0 +1,130 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "internal/synthesizers/fluidsynth/fluidprerenderer.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+
+static constexpr audioch_t CHANNELS_COUNT = 2;
+static constexpr samples_t LOOK_AHEAD_SAMPLES = 2048;
+
+class FluidPreRendererTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        //! NOTE Renders the current value, one sample is one millisecond of the rendered position
+        m_preRenderer = std::make_unique<FluidPreRenderer>(CHANNELS_COUNT, [this](float* buffer, samples_t samplesPerChannel) {
+            std::fill(buffer, buffer + samplesPerChannel * CHANNELS_COUNT, m_value);
+            m_renderedSamples += samplesPerChannel;
+            return samplesPerChannel;
+        }, [this]() {
+            return static_cast<msecs_t>(m_renderedSamples.load());
+        });
+    }
+
+    void TearDown() override
+    {
+        m_preRenderer->stop();
+    }
+
+    void waitRenderedSamples(samples_t samples)
+    {
+        for (int i = 0; i < 5000 && m_renderedSamples < samples; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ASSERT_GE(m_renderedSamples.load(), samples);
+    }
+
+    std::vector<float> read(samples_t samplesPerChannel)
+    {
+        std::vector<float> buffer(samplesPerChannel * CHANNELS_COUNT, -1.f);
+        m_preRenderer->read(buffer.data(), samplesPerChannel);
+        return buffer;
+    }
+
+    std::unique_ptr<FluidPreRenderer> m_preRenderer;
+    std::atomic<float> m_value = 1.f;
+    std::atomic<samples_t> m_renderedSamples = 0;
+};
+
+/**
+ * @brief FluidPreRendererTests_ChangeAfterRenderedPositionKeepsAudio
+ * @details A change after the rendered position doesn't affect the rendered audio, so it's kept
+ */
+TEST_F(FluidPreRendererTests, ChangeAfterRenderedPositionKeepsAudio)
+{
+    // [GIVEN] The look-ahead buffer is full
+    m_preRenderer->start(LOOK_AHEAD_SAMPLES);
+    waitRenderedSamples(LOOK_AHEAD_SAMPLES);
+
+    // [WHEN] A change comes after the rendered position
+    bool affected = true;
+    m_preRenderer->invalidate([this, &affected](bool renderedAudioAffected) {
+        affected = renderedAudioAffected;
+        m_value = 2.f;
+    }, static_cast<msecs_t>(m_renderedSamples.load()) + 1000);
+
+    // [THEN] The rendered audio is kept
+    EXPECT_FALSE(affected);
+    for (float sample : read(LOOK_AHEAD_SAMPLES / 2)) {
+        EXPECT_EQ(sample, 1.f);
+    }
+}
+
+/**
+ * @brief FluidPreRendererTests_ChangeBeforeRenderedPositionDropsAudio
+ * @details A change between the played and the rendered positions drops the rendered audio,
+ *          even if the change rewinds the rendered position
+ */
+TEST_F(FluidPreRendererTests, ChangeBeforeRenderedPositionDropsAudio)
+{
+    // [GIVEN] The look-ahead buffer is full and a part of it is played
+    m_preRenderer->start(LOOK_AHEAD_SAMPLES);
+    waitRenderedSamples(LOOK_AHEAD_SAMPLES);
+    read(LOOK_AHEAD_SAMPLES / 4);
+
+    // [WHEN] A change comes before the rendered position and rewinds it
+    const samples_t renderedBefore = m_renderedSamples;
+    bool affected = false;
+    m_preRenderer->invalidate([this, &affected](bool renderedAudioAffected) {
+        affected = renderedAudioAffected;
+        m_value = 2.f;
+        m_renderedSamples = LOOK_AHEAD_SAMPLES / 4;
+    }, static_cast<msecs_t>(LOOK_AHEAD_SAMPLES / 2));
+
+    // [THEN] The rendered audio is dropped and rendered again with the change
+    EXPECT_TRUE(affected);
+    waitRenderedSamples(renderedBefore);
+    for (float sample : read(LOOK_AHEAD_SAMPLES / 2)) {
+        EXPECT_EQ(sample, 2.f);
+    }
+}
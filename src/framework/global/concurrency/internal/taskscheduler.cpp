@@ -0,0 +1,285 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "taskscheduler.h"
+
+#include <string>
+
+#include "async/processevents.h"
+#include "runtime.h"
+
+using namespace mu::concurrency;
+
+//! NOTE The scheduler and the worker index of the current thread, if it is a worker
+static thread_local const TaskScheduler* s_currentScheduler = nullptr;
+static thread_local size_t s_currentWorkerIndex = 0;
+
+static size_t defaultThreadCount()
+{
+    //! NOTE One thread less than the cores, as the calling thread runs the tasks too while it waits for them
+    const unsigned int cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 1;
+}
+
+TaskScheduler::TaskScheduler()
+    : m_maxThreadCount(defaultThreadCount())
+{
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    stop();
+}
+
+size_t TaskScheduler::threadCount() const
+{
+    return m_maxThreadCount;
+}
+
+void TaskScheduler::setMaxThreadCount(size_t count)
+{
+    if (m_maxThreadCount == count) {
+        return;
+    }
+
+    stop();
+    m_maxThreadCount = count;
+}
+
+//! NOTE Called with m_workersMutex locked
+void TaskScheduler::startWorkers()
+{
+    if (m_workersCount > 0) {
+        return;
+    }
+
+    const size_t count = m_maxThreadCount;
+    for (size_t i = 0; i < count; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        Worker* worker = m_workers[i].get();
+        worker->thread = std::thread([this, i]() { workerLoop(i); });
+        worker->id = worker->thread.get_id();
+    }
+
+    m_workersCount = count;
+}
+
+void TaskScheduler::stop()
+{
+    std::vector<std::unique_ptr<Worker> > workers;
+
+    {
+        std::lock_guard<std::mutex> lock(m_workersMutex);
+        if (m_workers.empty()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> sleepLock(m_sleepMutex);
+            m_stopped = true;
+        }
+        m_wakeUp.notify_all();
+
+        //! NOTE The workers may still schedule tasks while they finish the current ones,
+        //! they don't take m_workersMutex for it (see schedule), so they can't block the join
+        for (std::unique_ptr<Worker>& worker : m_workers) {
+            if (worker->thread.joinable()) {
+                worker->thread.join();
+            }
+        }
+
+        workers = std::move(m_workers);
+        m_workers.clear();
+        m_workersCount = 0;
+        m_queuedTasks = 0;
+
+        std::lock_guard<std::mutex> sleepLock(m_sleepMutex);
+        m_stopped = false;
+        m_asyncEventsPending = false;
+    }
+
+    //! NOTE The tasks left are run here, so that nobody waits for them forever.
+    //! Not under the lock, as they may schedule other tasks
+    for (std::unique_ptr<Worker>& worker : workers) {
+        while (!worker->tasks.empty()) {
+            Task task = std::move(worker->tasks.front());
+            worker->tasks.pop_front();
+            task();
+        }
+    }
+}
+
+void TaskScheduler::schedule(const Task& task)
+{
+    if (m_maxThreadCount == 0) {
+        task();
+        return;
+    }
+
+    //! NOTE A task scheduled by a worker goes to its own queue, it is likely to use the same data.
+    //! The workers can't be stopped under a running worker (stop joins them first), so it doesn't need the lock
+    if (s_currentScheduler == this) {
+        pushTask(s_currentWorkerIndex, task);
+    } else {
+        std::lock_guard<std::mutex> lock(m_workersMutex);
+        startWorkers();
+        pushTask(m_nextWorker++ % m_workersCount, task);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wakeUp.notify_one();
+}
+
+void TaskScheduler::pushTask(size_t index, const Task& task)
+{
+    Worker* worker = m_workers[index].get();
+
+    m_queuedTasks++;
+
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    worker->tasks.push_back(task);
+}
+
+bool TaskScheduler::runPendingTask()
+{
+    Task task;
+    bool found = false;
+    if (s_currentScheduler == this) {
+        found = popTask(s_currentWorkerIndex, task);
+    } else {
+        //! NOTE The task is taken under the lock, so that the workers aren't stopped meanwhile, but run without it
+        std::lock_guard<std::mutex> lock(m_workersMutex);
+        if (m_workersCount == 0) {
+            return false;
+        }
+
+        found = stealTask(m_nextWorker % m_workersCount, task);
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    task();
+    return true;
+}
+
+bool TaskScheduler::popTask(size_t index, Task& task)
+{
+    Worker* worker = m_workers[index].get();
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        if (!worker->tasks.empty()) {
+            task = std::move(worker->tasks.back());
+            worker->tasks.pop_back();
+            m_queuedTasks--;
+            return true;
+        }
+    }
+
+    return stealTask(index + 1, task);
+}
+
+bool TaskScheduler::stealTask(size_t startIndex, Task& task)
+{
+    const size_t count = m_workersCount;
+    for (size_t i = 0; i < count; ++i) {
+        Worker* victim = m_workers[(startIndex + i) % count].get();
+        std::lock_guard<std::mutex> lock(victim->mutex);
+        if (!victim->tasks.empty()) {
+            task = std::move(victim->tasks.front());
+            victim->tasks.pop_front();
+            m_queuedTasks--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::thread::id TaskScheduler::asyncThreadId()
+{
+    if (m_maxThreadCount == 0) {
+        return std::this_thread::get_id();
+    }
+
+    if (s_currentScheduler == this) {
+        return m_workers.front()->id;
+    }
+
+    std::lock_guard<std::mutex> lock(m_workersMutex);
+    startWorkers();
+    return m_workers.front()->id;
+}
+
+void TaskScheduler::processAsyncEvents()
+{
+    //! NOTE Without workers, the async calls are processed by the calling thread
+    if (m_workersCount == 0) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_asyncEventsPending = true;
+    }
+    m_wakeUp.notify_all();
+}
+
+void TaskScheduler::workerLoop(size_t index)
+{
+    s_currentScheduler = this;
+    s_currentWorkerIndex = index;
+    mu::runtime::setThreadName("task_worker_" + std::to_string(index));
+
+    //! NOTE The first worker also processes the async calls queued for it (see asyncThreadId)
+    const bool isAsyncThread = index == 0;
+
+    while (true) {
+        if (isAsyncThread) {
+            mu::async::processEvents();
+        }
+
+        Task task;
+        if (popTask(index, task)) {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wakeUp.wait(lock, [this, isAsyncThread]() {
+            return m_stopped || m_queuedTasks > 0 || (isAsyncThread && m_asyncEventsPending);
+        });
+
+        if (m_stopped) {
+            return;
+        }
+
+        if (isAsyncThread) {
+            m_asyncEventsPending = false;
+        }
+    }
+}
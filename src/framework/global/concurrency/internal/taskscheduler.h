@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_CONCURRENCY_TASKSCHEDULER_H
+#define MU_CONCURRENCY_TASKSCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../itaskscheduler.h"
+
+namespace mu::concurrency {
+class TaskScheduler : public ITaskScheduler
+{
+public:
+    TaskScheduler();
+    ~TaskScheduler() override;
+
+    size_t threadCount() const override;
+    void setMaxThreadCount(size_t count) override;
+
+    void schedule(const Task& task) override;
+    bool runPendingTask() override;
+
+    std::thread::id asyncThreadId() override;
+    void processAsyncEvents() override;
+
+    void stop();
+
+private:
+    struct Worker {
+        std::thread thread;
+        std::thread::id id;
+
+        //! NOTE The owner takes the tasks from the back, the other threads steal them from the front
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void startWorkers();
+    void workerLoop(size_t index);
+
+    void pushTask(size_t index, const Task& task);
+    bool popTask(size_t index, Task& task);
+    bool stealTask(size_t thiefIndex, Task& task);
+
+    std::atomic<size_t> m_maxThreadCount = 0;
+
+    std::mutex m_workersMutex;
+    std::vector<std::unique_ptr<Worker> > m_workers;
+    std::atomic<size_t> m_workersCount = 0;
+    std::atomic<size_t> m_nextWorker = 0;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeUp;
+    std::atomic<size_t> m_queuedTasks = 0;
+    bool m_asyncEventsPending = false;
+    bool m_stopped = false;
+};
+}
+
+#endif // MU_CONCURRENCY_TASKSCHEDULER_H
@@ -0,0 +1,68 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_CONCURRENCY_ITASKSCHEDULER_H
+#define MU_CONCURRENCY_ITASKSCHEDULER_H
+
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include "modularity/imoduleexport.h"
+
+namespace mu::concurrency {
+//! NOTE A shared pool of worker threads for parallel work (layout, import/export, converter).
+//! Each worker has its own queue and steals from the others when it runs out of tasks.
+//! The tasks are usually run through TaskGroup, parallelFor or runAsync (see taskgroup.h and parallel.h)
+class ITaskScheduler : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(ITaskScheduler)
+
+public:
+    virtual ~ITaskScheduler() = default;
+
+    using Task = std::function<void ()>;
+
+    //! NOTE The number of worker threads, 0 if the tasks are run on the calling thread
+    virtual size_t threadCount() const = 0;
+
+    //! NOTE 0 disables the parallelism: the tasks are run immediately on the calling thread,
+    //! in the order of scheduling (useful for deterministic tests).
+    //! Should be called when no tasks are running
+    virtual void setMaxThreadCount(size_t count) = 0;
+
+    virtual void schedule(const Task& task) = 0;
+
+    //! NOTE Runs one of the queued tasks on the calling thread, if there is any.
+    //! Used by the threads waiting for their tasks to help instead of blocking
+    virtual bool runPendingTask() = 0;
+
+    //! NOTE The thread that processes the async calls (e.g. the bodies of async::Promise) queued for it.
+    //! processAsyncEvents() must be called after queuing them to wake the thread up.
+    //! Starts the workers, if they aren't running yet
+    virtual std::thread::id asyncThreadId() = 0;
+    virtual void processAsyncEvents() = 0;
+};
+
+using ITaskSchedulerPtr = std::shared_ptr<ITaskScheduler>;
+}
+
+#endif // MU_CONCURRENCY_ITASKSCHEDULER_H
@@ -0,0 +1,98 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_CONCURRENCY_PARALLEL_H
+#define MU_CONCURRENCY_PARALLEL_H
+
+#include <algorithm>
+#include <functional>
+
+#include "async/promise.h"
+#include "itaskscheduler.h"
+#include "taskgroup.h"
+
+namespace mu::concurrency {
+//! NOTE How many chunks per thread a range is split into, so that the threads that finish earlier can steal the rest
+static constexpr size_t CHUNKS_PER_THREAD = 4;
+
+/*!
+ * Calls func for the subranges of [begin, end) in parallel and waits for all of them.
+ * A subrange has at least grainSize indexes (except the last one).
+ * usage:
+ *      parallelFor(scheduler, 0, systems.size(), [&](size_t from, size_t to) {
+ *          for (size_t i = from; i < to; ++i) {
+ *              layoutSystem(systems[i]);
+ *          }
+ *      });
+ */
+inline void parallelFor(const ITaskSchedulerPtr& scheduler, size_t begin, size_t end,
+                        const std::function<void(size_t from, size_t to)>& func, size_t grainSize = 1)
+{
+    if (begin >= end) {
+        return;
+    }
+
+    const size_t count = end - begin;
+    const size_t threads = scheduler ? scheduler->threadCount() : 0;
+    const size_t maxChunks = std::max<size_t>(count / std::max<size_t>(grainSize, 1), 1);
+    const size_t chunks = std::min(maxChunks, (threads + 1) * CHUNKS_PER_THREAD);
+
+    if (threads == 0 || chunks == 1) {
+        func(begin, end);
+        return;
+    }
+
+    const size_t chunkSize = (count + chunks - 1) / chunks;
+
+    TaskGroup group(scheduler);
+    size_t from = begin;
+    for (; end - from > chunkSize; from += chunkSize) {
+        const size_t to = from + chunkSize;
+        group.run([&func, from, to]() { func(from, to); });
+    }
+
+    //! NOTE The last chunk is run on the calling thread
+    func(from, end);
+
+    group.wait();
+}
+
+/*!
+ * Runs func on a worker thread and resolves the promise with its result.
+ * As for the other promises, the callbacks are called on the threads that subscribed to them.
+ * usage:
+ *      runAsync<Ret>(scheduler, [path]() { return exportScore(path); })
+ *      .onResolve(this, [](const Ret& ret) { ... });
+ */
+template<typename T>
+async::Promise<T> runAsync(const ITaskSchedulerPtr& scheduler, const std::function<T()>& func)
+{
+    async::Promise<T> promise([func](auto resolve, auto /*reject*/) {
+        return resolve(func());
+    }, scheduler->asyncThreadId());
+
+    scheduler->processAsyncEvents();
+
+    return promise;
+}
+}
+
+#endif // MU_CONCURRENCY_PARALLEL_H
@@ -0,0 +1,72 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "taskgroup.h"
+
+#include <chrono>
+
+using namespace mu::concurrency;
+
+//! NOTE How long a waiting thread sleeps before looking for the queued tasks again
+static constexpr std::chrono::milliseconds HELP_INTERVAL(1);
+
+TaskGroup::TaskGroup(ITaskSchedulerPtr scheduler)
+    : m_scheduler(scheduler), m_state(std::make_shared<State>())
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    wait();
+}
+
+void TaskGroup::run(const ITaskScheduler::Task& task)
+{
+    //! NOTE Without a scheduler (e.g. not registered in the tests) the tasks are run immediately
+    if (!m_scheduler) {
+        task();
+        return;
+    }
+
+    m_state->pendingTasks++;
+
+    std::shared_ptr<State> state = m_state;
+    m_scheduler->schedule([state, task]() {
+        task();
+
+        if (--state->pendingTasks == 0) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->finished.notify_all();
+        }
+    });
+}
+
+void TaskGroup::wait()
+{
+    while (m_state->pendingTasks > 0) {
+        if (m_scheduler->runPendingTask()) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_state->mutex);
+        m_state->finished.wait_for(lock, HELP_INTERVAL, [this]() { return m_state->pendingTasks == 0; });
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_CONCURRENCY_TASKGROUP_H
+#define MU_CONCURRENCY_TASKGROUP_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include "itaskscheduler.h"
+
+namespace mu::concurrency {
+/*!
+ * mu::concurrency::TaskGroup
+ * usage:
+ *      TaskGroup group(scheduler);
+ *      for (Item* item : items) {
+ *          group.run([item]() { item->layout(); });
+ *      }
+ *      group.wait();
+ *
+ * The waiting thread runs the queued tasks itself while the tasks of the group are not finished,
+ * so groups can be waited from inside of other tasks.
+ */
+class TaskGroup
+{
+public:
+    explicit TaskGroup(ITaskSchedulerPtr scheduler);
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(const ITaskScheduler::Task& task);
+    void wait();
+
+private:
+    struct State {
+        std::atomic<size_t> pendingTasks = 0;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    ITaskSchedulerPtr m_scheduler;
+    std::shared_ptr<State> m_state;
+};
+}
+
+#endif // MU_CONCURRENCY_TASKGROUP_H
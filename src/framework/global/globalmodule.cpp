@@ -35,12 +35,15 @@
 #include "internal/invoker.h"
 
 #include "runtime.h"
+#include "tracer.h"
 #include "async/processevents.h"
 
 #include "settings.h"
 
 #include "io/internal/filesystem.h"
 
+#include "concurrency/internal/taskscheduler.h"
+
 #include "diagnostics/idiagnosticspathsregister.h"
 
 #include "config.h"
@@ -48,11 +51,14 @@
 using namespace mu::framework;
 using namespace mu::modularity;
 using namespace mu::io;
+using namespace mu::concurrency;
 
 static std::shared_ptr<GlobalConfiguration> s_globalConf = std::make_shared<GlobalConfiguration>();
 
 static Invoker s_asyncInvoker;
 
+static std::shared_ptr<TaskScheduler> s_taskScheduler = std::make_shared<TaskScheduler>();
+
 std::string GlobalModule::moduleName() const
 {
     return "global";
@@ -64,6 +70,7 @@ void GlobalModule::registerExports()
     ioc()->registerExport<IGlobalConfiguration>(moduleName(), s_globalConf);
     ioc()->registerExport<IInteractive>(moduleName(), new Interactive());
     ioc()->registerExport<IFileSystem>(moduleName(), new FileSystem());
+    ioc()->registerExport<ITaskScheduler>(moduleName(), s_taskScheduler);
 }
 
 void GlobalModule::onInit(const IApplication::RunMode& mode)
@@ -149,3 +156,11 @@ void GlobalModule::onInit(const IApplication::RunMode& mode)
         pr->reg("settings file", settings()->filePath());
     }
 }
+
+void GlobalModule::onDeinit()
+{
+    s_taskScheduler->stop();
+
+    //! NOTE Saves the trace, if it was started with a save path (e.g. by the --trace command line option)
+    Tracer::instance()->stop();
+}
@@ -35,6 +35,7 @@ public:
     std::string moduleName() const override;
     void registerExports() override;
     void onInit(const IApplication::RunMode& mode) override;
+    void onDeinit() override;
 };
 }
 
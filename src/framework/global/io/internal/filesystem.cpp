@@ -30,6 +30,7 @@
 #endif
 
 #include "io/ioretcodes.h"
+#include "tracer.h"
 #include "log.h"
 
 using namespace mu;
@@ -118,6 +119,8 @@ Ret FileSystem::move(const io::path_t& src, const io::path_t& dst, bool replace)
 
 RetVal<ByteArray> FileSystem::readFile(const io::path_t& filePath) const
 {
+    TRACE_SCOPE("io", "FileSystem::readFile");
+
     RetVal<ByteArray> result;
     Ret ret = exists(filePath);
     if (!ret) {
@@ -143,6 +146,8 @@ RetVal<ByteArray> FileSystem::readFile(const io::path_t& filePath) const
 
 bool FileSystem::readFile(const io::path_t& filePath, ByteArray& data) const
 {
+    TRACE_SCOPE("io", "FileSystem::readFile");
+
     QFile file(filePath.toQString());
     if (!file.open(QIODevice::ReadOnly)) {
         return false;
@@ -159,6 +164,8 @@ bool FileSystem::readFile(const io::path_t& filePath, ByteArray& data) const
 
 Ret FileSystem::writeFile(const io::path_t& filePath, const ByteArray& data) const
 {
+    TRACE_SCOPE("io", "FileSystem::writeFile");
+
     QFile file(filePath.toQString());
     if (!file.open(QIODevice::WriteOnly)) {
         return make_ret(Err::FSWriteError);
@@ -0,0 +1,193 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "async/asyncable.h"
+#include "async/processevents.h"
+#include "concurrency/internal/taskscheduler.h"
+#include "concurrency/parallel.h"
+#include "concurrency/taskgroup.h"
+
+using namespace mu;
+using namespace mu::concurrency;
+
+class Global_TaskSchedulerTests : public ::testing::Test, public async::Asyncable
+{
+public:
+    void SetUp() override
+    {
+        m_scheduler = std::make_shared<TaskScheduler>();
+        m_scheduler->setMaxThreadCount(4);
+    }
+
+    void TearDown() override
+    {
+        m_scheduler->stop();
+    }
+
+protected:
+    std::shared_ptr<TaskScheduler> m_scheduler;
+};
+
+TEST_F(Global_TaskSchedulerTests, TaskGroupWait)
+{
+    std::atomic<int> done = 0;
+
+    TaskGroup group(m_scheduler);
+    for (int i = 0; i < 1000; ++i) {
+        group.run([&done]() { done++; });
+    }
+    group.wait();
+
+    EXPECT_EQ(done, 1000);
+}
+
+TEST_F(Global_TaskSchedulerTests, NestedTaskGroups)
+{
+    //! NOTE The groups are waited inside of the tasks, the waiting workers must run the inner tasks
+    std::atomic<int> done = 0;
+
+    TaskGroup group(m_scheduler);
+    for (int i = 0; i < 16; ++i) {
+        group.run([this, &done]() {
+            TaskGroup inner(m_scheduler);
+            for (int j = 0; j < 16; ++j) {
+                inner.run([&done]() { done++; });
+            }
+            inner.wait();
+        });
+    }
+    group.wait();
+
+    EXPECT_EQ(done, 16 * 16);
+}
+
+TEST_F(Global_TaskSchedulerTests, ParallelFor)
+{
+    std::vector<int> values(10007, 0);
+
+    parallelFor(m_scheduler, 0, values.size(), [&values](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) {
+            values[i] = static_cast<int>(i);
+        }
+    }, 100);
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], static_cast<int>(i));
+    }
+
+    parallelFor(m_scheduler, 5, 5, [](size_t, size_t) {
+        FAIL() << "empty range";
+    });
+}
+
+TEST_F(Global_TaskSchedulerTests, ScheduleWhileStopping)
+{
+    //! [GIVEN] Threads that schedule tasks
+    std::atomic<int> done = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([this, &done]() {
+            for (int i = 0; i < 1000; ++i) {
+                m_scheduler->schedule([&done]() { done++; });
+            }
+        });
+    }
+
+    //! [WHEN] The workers are stopped meanwhile
+    for (int i = 0; i < 10; ++i) {
+        m_scheduler->stop();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    m_scheduler->stop();
+
+    //! [THEN] Every task is run once, by the restarted workers or by stop
+    EXPECT_EQ(done, 4 * 1000);
+}
+
+TEST_F(Global_TaskSchedulerTests, DisabledParallelism)
+{
+    //! [GIVEN] The parallelism is disabled
+    m_scheduler->setMaxThreadCount(0);
+    EXPECT_EQ(m_scheduler->threadCount(), 0);
+
+    //! [WHEN] Tasks are scheduled
+    std::vector<int> order;
+    std::set<std::thread::id> threads;
+    TaskGroup group(m_scheduler);
+    for (int i = 0; i < 10; ++i) {
+        group.run([i, &order, &threads]() {
+            order.push_back(i);
+            threads.insert(std::this_thread::get_id());
+        });
+    }
+    group.wait();
+
+    //! [THEN] They are run on the calling thread in the order of scheduling
+    std::vector<int> expected(10);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(order, expected);
+    EXPECT_EQ(threads, std::set<std::thread::id> { std::this_thread::get_id() });
+}
+
+TEST_F(Global_TaskSchedulerTests, RunAsync)
+{
+    std::thread::id workerThread;
+    std::atomic<bool> subscribed = false;
+    int result = 0;
+
+    //! NOTE The function waits for the subscription, a promise resolved before it would not call the callback
+    async::Promise<int> promise = runAsync<int>(m_scheduler, [&workerThread, &subscribed]() {
+        workerThread = std::this_thread::get_id();
+        while (!subscribed) {
+            std::this_thread::yield();
+        }
+        return 42;
+    });
+
+    promise.onResolve(this, [&result](int value) {
+        result = value;
+    });
+    subscribed = true;
+
+    //! NOTE The callback is called on this thread, when it processes its events
+    auto start = std::chrono::steady_clock::now();
+    while (result == 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+        async::processEvents();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_EQ(result, 42);
+    EXPECT_EQ(workerThread, m_scheduler->asyncThreadId());
+}
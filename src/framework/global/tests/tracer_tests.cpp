@@ -0,0 +1,124 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+#include "tracer.h"
+
+using namespace mu;
+
+class Global_TracerTests : public ::testing::Test
+{
+public:
+    void TearDown() override
+    {
+        Tracer::instance()->stop();
+    }
+
+    static size_t count(const std::string& str, const std::string& sub)
+    {
+        size_t n = 0;
+        for (size_t pos = str.find(sub); pos != std::string::npos; pos = str.find(sub, pos + sub.size())) {
+            ++n;
+        }
+        return n;
+    }
+};
+
+TEST_F(Global_TracerTests, NotStarted)
+{
+    //! [GIVEN] The tracer is not started
+    EXPECT_FALSE(Tracer::isStarted());
+
+    //! [WHEN] A scope is traced
+    {
+        TRACE_SCOPE("test", "NotStarted");
+    }
+
+    //! [THEN] Nothing is recorded
+    Tracer::instance()->start();
+    EXPECT_EQ(count(Tracer::instance()->chromeTrace(), "\"NotStarted\""), 0);
+}
+
+TEST_F(Global_TracerTests, ScopesOfThreads)
+{
+    //! [GIVEN] The tracer is started
+    Tracer::instance()->start();
+    EXPECT_TRUE(Tracer::isStarted());
+
+    //! [WHEN] Scopes are traced on this and on another thread
+    {
+        TRACE_SCOPE("test", "MainScope");
+    }
+
+    std::thread thread([]() {
+        TRACE_SCOPE("test", "ThreadScope");
+        TRACE_SCOPE("test", "Nested\"Scope");
+    });
+    thread.join();
+
+    //! [THEN] All the scopes are in the trace, with names escaped
+    std::string trace = Tracer::instance()->chromeTrace();
+    EXPECT_EQ(count(trace, "\"name\":\"MainScope\""), 1);
+    EXPECT_EQ(count(trace, "\"name\":\"ThreadScope\""), 1);
+    EXPECT_EQ(count(trace, "\"name\":\"Nested\\\"Scope\""), 1);
+    EXPECT_EQ(count(trace, "\"ph\":\"X\""), 3);
+    EXPECT_EQ(count(trace, "\"thread_name\""), 2);
+}
+
+TEST_F(Global_TracerTests, RingBufferOverwritesOldest)
+{
+    //! [GIVEN] The tracer is started with a small buffer
+    Tracer::instance()->start(io::path_t(), 4);
+
+    //! [WHEN] More events than the buffer holds are added
+    for (uint64_t i = 1; i <= 10; ++i) {
+        Tracer::instance()->addEvent("test", i <= 6 ? "Old" : "New", i * 1000, i * 1000 + 500);
+    }
+
+    //! [THEN] Only the last ones are in the trace, without the oldest slot, that is the next to be written
+    std::string trace = Tracer::instance()->chromeTrace();
+    EXPECT_EQ(count(trace, "\"name\":\"Old\""), 0);
+    EXPECT_EQ(count(trace, "\"name\":\"New\""), 3);
+    EXPECT_EQ(count(trace, "\"ts\":0.000,\"dur\":0.500"), 1);
+}
+
+TEST_F(Global_TracerTests, RestartClearsEvents)
+{
+    //! [GIVEN] A trace with an event
+    Tracer::instance()->start();
+    Tracer::instance()->addEvent("test", "First", 1000, 2000);
+    Tracer::instance()->stop();
+
+    //! [WHEN] The tracer is started again
+    Tracer::instance()->start();
+    Tracer::instance()->addEvent("test", "Second", 1000, 2000);
+
+    //! [THEN] Only the events of the new session are in the trace
+    std::string trace = Tracer::instance()->chromeTrace();
+    EXPECT_EQ(count(trace, "\"name\":\"First\""), 0);
+    EXPECT_EQ(count(trace, "\"name\":\"Second\""), 1);
+}
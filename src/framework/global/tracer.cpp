@@ -0,0 +1,280 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "tracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+
+#include "io/file.h"
+#include "runtime.h"
+
+#include "log.h"
+
+using namespace mu;
+
+std::atomic<bool> Tracer::s_started = false;
+thread_local Tracer::ThreadBufferOwner Tracer::s_threadBuffer;
+
+static size_t ceilPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+static void appendEscaped(std::string& out, const std::string& str)
+{
+    for (char c : str) {
+        switch (c) {
+        case '"': out += "\\\"";
+            break;
+        case '\\': out += "\\\\";
+            break;
+        case '\n': out += "\\n";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) >= 0x20) {
+                out += c;
+            }
+        }
+    }
+}
+
+Tracer* Tracer::instance()
+{
+    static Tracer t;
+    return &t;
+}
+
+uint64_t Tracer::nowNs()
+{
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+void Tracer::start(const io::path_t& savePath, size_t eventsPerThread)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_savePath = savePath;
+    m_eventsPerThread = ceilPowerOfTwo(std::max<size_t>(eventsPerThread, 1));
+
+    //! NOTE The buffers of the exited threads were only kept for the trace of the previous session
+    m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(), [](const std::unique_ptr<ThreadBuffer>& buffer) {
+        return buffer->exited;
+    }), m_buffers.end());
+
+    //! NOTE The buffers of the threads are reset by the threads themselves, on their first event of the new session
+    m_session++;
+    s_started = true;
+
+    LOGI() << "tracing started" << (savePath.empty() ? "" : ", the trace will be saved to: " + savePath.toStdString());
+}
+
+void Tracer::stop()
+{
+    if (!isStarted()) {
+        return;
+    }
+
+    io::path_t savePath;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        s_started = false;
+        savePath = m_savePath;
+    }
+
+    if (!savePath.empty()) {
+        saveChromeTrace(savePath);
+    }
+}
+
+Tracer::ThreadBuffer* Tracer::threadBuffer()
+{
+    ThreadBuffer* buffer = s_threadBuffer.buffer;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = m_buffers.back().get();
+        buffer->threadIndex = ++m_threadsCount;
+        buffer->threadName = mu::runtime::threadName();
+        s_threadBuffer.buffer = buffer;
+    }
+
+    const uint64_t session = m_session.load(std::memory_order_acquire);
+    if (buffer->session != session) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        buffer->events.assign(m_eventsPerThread, Event());
+        buffer->written.store(0, std::memory_order_release);
+        buffer->session = session;
+    }
+
+    return buffer;
+}
+
+void Tracer::releaseThreadBuffer(ThreadBuffer* buffer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    //! NOTE The events of the running session are kept for its trace, the buffer is removed by the next start
+    if (isStarted() && buffer->session == m_session && buffer->written > 0) {
+        buffer->exited = true;
+        return;
+    }
+
+    m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(), [buffer](const std::unique_ptr<ThreadBuffer>& b) {
+        return b.get() == buffer;
+    }), m_buffers.end());
+}
+
+Tracer::ThreadBufferOwner::~ThreadBufferOwner()
+{
+    if (buffer) {
+        Tracer::instance()->releaseThreadBuffer(buffer);
+    }
+}
+
+void Tracer::addEvent(const char* category, const char* name, uint64_t beginNs, uint64_t endNs)
+{
+    if (!isStarted()) {
+        return;
+    }
+
+    ThreadBuffer* buffer = threadBuffer();
+
+    const uint64_t index = buffer->written.load(std::memory_order_relaxed);
+    Event& event = buffer->events[index & (buffer->events.size() - 1)];
+    event.category = category;
+    event.name = name;
+    event.beginNs = beginNs;
+    event.durationNs = endNs > beginNs ? endNs - beginNs : 0;
+    buffer->written.store(index + 1, std::memory_order_release);
+}
+
+std::string Tracer::chromeTrace() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const uint64_t session = m_session.load(std::memory_order_acquire);
+
+    struct ThreadEvents {
+        const ThreadBuffer* buffer = nullptr;
+        std::vector<Event> events;
+    };
+
+    std::vector<ThreadEvents> threads;
+    uint64_t originNs = std::numeric_limits<uint64_t>::max();
+    for (const std::unique_ptr<ThreadBuffer>& buffer : m_buffers) {
+        if (buffer->session != session) {
+            continue;
+        }
+
+        //! NOTE The threads keep writing while the trace is exported: the events are copied first,
+        //! then the ones that may have been overwritten meanwhile are dropped. The slot after the last
+        //! written one is the one being written, so once the buffer has wrapped the oldest slot is never taken
+        const uint64_t capacity = buffer->events.size();
+        const uint64_t last = buffer->written.load(std::memory_order_acquire);
+        const uint64_t first = last >= capacity ? last - capacity + 1 : 0;
+
+        ThreadEvents thread;
+        thread.buffer = buffer.get();
+        thread.events.reserve(last - first);
+        for (uint64_t i = first; i < last; ++i) {
+            thread.events.push_back(buffer->events[i & (capacity - 1)]);
+        }
+
+        const uint64_t writtenAfter = buffer->written.load(std::memory_order_acquire);
+        const uint64_t firstIntact = writtenAfter >= capacity ? writtenAfter - capacity + 1 : 0;
+        if (firstIntact > first) {
+            const uint64_t overwritten = std::min<uint64_t>(firstIntact - first, thread.events.size());
+            thread.events.erase(thread.events.begin(), thread.events.begin() + overwritten);
+        }
+
+        for (const Event& event : thread.events) {
+            originNs = std::min(originNs, event.beginNs);
+        }
+
+        threads.push_back(std::move(thread));
+    }
+
+    std::string out = "{\"traceEvents\":[\n";
+    bool first = true;
+    char number[64];
+
+    auto appendSeparator = [&out, &first]() {
+        if (!first) {
+            out += ",\n";
+        }
+        first = false;
+    };
+
+    for (const ThreadEvents& thread : threads) {
+        const ThreadBuffer* buffer = thread.buffer;
+
+        appendSeparator();
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+        out += std::to_string(buffer->threadIndex);
+        out += ",\"args\":{\"name\":\"";
+        appendEscaped(out, buffer->threadName);
+        out += "\"}}";
+
+        for (const Event& event : thread.events) {
+            appendSeparator();
+            out += "{\"name\":\"";
+            appendEscaped(out, event.name ? event.name : "");
+            out += "\",\"cat\":\"";
+            appendEscaped(out, event.category ? event.category : "");
+            out += "\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+            out += std::to_string(buffer->threadIndex);
+
+            //! NOTE The timestamps are in microseconds
+            std::snprintf(number, sizeof(number), ",\"ts\":%.3f,\"dur\":%.3f}",
+                          static_cast<double>(event.beginNs - originNs) / 1000.0,
+                          static_cast<double>(event.durationNs) / 1000.0);
+            out += number;
+        }
+    }
+
+    out += "\n]}\n";
+    return out;
+}
+
+bool Tracer::saveChromeTrace(const io::path_t& path) const
+{
+    const std::string trace = chromeTrace();
+
+    io::File file(path);
+    if (!file.open(io::IODevice::WriteOnly)) {
+        LOGE() << "failed to open the trace file: " << path;
+        return false;
+    }
+
+    file.write(ByteArray(trace.c_str(), trace.size()));
+    file.close();
+
+    LOGI() << "trace saved to: " << path;
+    return true;
+}
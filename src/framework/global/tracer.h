@@ -0,0 +1,132 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_FRAMEWORK_TRACER_H
+#define MU_FRAMEWORK_TRACER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "io/path.h"
+
+//! NOTE Records the time of the scope in the trace, if the tracer is started.
+//! The category and the name must be string literals, they are stored as pointers
+#define TRACE_CONCAT_IMPL(x, y) x##y
+#define TRACE_CONCAT(x, y) TRACE_CONCAT_IMPL(x, y)
+#define TRACE_SCOPE(category, name) \
+    mu::TraceScope TRACE_CONCAT(__traceScope_, __LINE__)(category, name);
+
+namespace mu {
+/*!
+ * mu::Tracer
+ * Records the begin and the duration of the scopes marked with TRACE_SCOPE,
+ * for diagnosing the stalls of layout, playback and audio in the timeline of every thread.
+ * Each thread writes into its own ring buffer without locks, the oldest events are overwritten.
+ * The trace is saved in the Chrome trace format (chrome://tracing, https://ui.perfetto.dev).
+ * Started with the --trace command line option or from the Diagnostics menu.
+ */
+class Tracer
+{
+public:
+    static Tracer* instance();
+
+    static constexpr size_t DEFAULT_EVENTS_PER_THREAD = 1 << 15;
+
+    static bool isStarted() { return s_started.load(std::memory_order_relaxed); }
+    static uint64_t nowNs();
+
+    //! NOTE If the save path is not empty, the trace is saved there by stop()
+    void start(const io::path_t& savePath = io::path_t(), size_t eventsPerThread = DEFAULT_EVENTS_PER_THREAD);
+    void stop();
+
+    void addEvent(const char* category, const char* name, uint64_t beginNs, uint64_t endNs);
+
+    std::string chromeTrace() const;
+    bool saveChromeTrace(const io::path_t& path) const;
+
+private:
+    Tracer() = default;
+
+    struct Event {
+        const char* category = nullptr;
+        const char* name = nullptr;
+        uint64_t beginNs = 0;
+        uint64_t durationNs = 0;
+    };
+
+    struct ThreadBuffer {
+        size_t threadIndex = 0;
+        std::string threadName;
+        std::vector<Event> events;
+        std::atomic<uint64_t> written = 0;
+        uint64_t session = 0;
+        bool exited = false;
+    };
+
+    //! NOTE Gives the buffer back when its thread exits
+    struct ThreadBufferOwner {
+        ~ThreadBufferOwner();
+        ThreadBuffer* buffer = nullptr;
+    };
+
+    ThreadBuffer* threadBuffer();
+    void releaseThreadBuffer(ThreadBuffer* buffer);
+
+    static std::atomic<bool> s_started;
+    static thread_local ThreadBufferOwner s_threadBuffer;
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<ThreadBuffer> > m_buffers;
+    size_t m_threadsCount = 0;
+    std::atomic<uint64_t> m_session = 0;
+    size_t m_eventsPerThread = DEFAULT_EVENTS_PER_THREAD;
+    io::path_t m_savePath;
+};
+
+struct TraceScope
+{
+    TraceScope(const char* category, const char* name)
+        : m_category(category), m_name(name), m_beginNs(Tracer::isStarted() ? Tracer::nowNs() : 0)
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (m_beginNs) {
+            Tracer::instance()->addEvent(m_category, m_name, m_beginNs, Tracer::nowNs());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_category = nullptr;
+    const char* m_name = nullptr;
+    uint64_t m_beginNs = 0;
+};
+}
+
+#endif // MU_FRAMEWORK_TRACER_H
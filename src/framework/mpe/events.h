@@ -26,6 +26,8 @@
 #include <variant>
 #include <vector>
 #include <optional>
+#include <memory>
+#include <limits>
 
 #include "async/channel.h"
 #include "realfn.h"
@@ -39,7 +41,7 @@ struct RestEvent;
 using PlaybackEvent = std::variant<NoteEvent, RestEvent>;
 using PlaybackEventList = std::vector<PlaybackEvent>;
 using PlaybackEventsMap = std::map<msecs_t, PlaybackEventList>;
-using PlaybackEventsChanges = async::Channel<PlaybackEventsMap>;
+using PlaybackEventsMapPtr = std::shared_ptr<const PlaybackEventsMap>;
 using DynamicLevelChanges = async::Channel<DynamicLevelMap>;
 
 struct ArrangementContext
@@ -264,6 +266,54 @@ private:
     ArrangementContext m_arrangementCtx;
 };
 
+/**
+ * @brief The PlaybackEventsChunk struct
+ * @details Immutable, shared slice of the track events. The receiver has to replace everything
+ *          it has within [from, to] by the content of the chunk, so that only the changed range
+ *          is passed between threads and untouched events are kept as they are
+ */
+struct PlaybackEventsChunk
+{
+    static constexpr timestamp_t MIN_TIMESTAMP = std::numeric_limits<timestamp_t>::min();
+    static constexpr timestamp_t MAX_TIMESTAMP = std::numeric_limits<timestamp_t>::max();
+
+    timestamp_t from = MIN_TIMESTAMP;
+    timestamp_t to = MAX_TIMESTAMP;
+    PlaybackEventsMapPtr events;
+
+    PlaybackEventsChunk() = default;
+
+    explicit PlaybackEventsChunk(PlaybackEventsMap&& events)
+        : events(std::make_shared<const PlaybackEventsMap>(std::move(events))) {}
+
+    explicit PlaybackEventsChunk(const PlaybackEventsMap& source, const timestamp_t from, const timestamp_t to)
+        : from(from), to(to)
+    {
+        events = std::make_shared<const PlaybackEventsMap>(source.lower_bound(from), source.upper_bound(to));
+    }
+
+    bool replacesAll() const
+    {
+        return from == MIN_TIMESTAMP && to == MAX_TIMESTAMP;
+    }
+
+    bool empty() const
+    {
+        return !events || events->empty();
+    }
+
+    void applyTo(PlaybackEventsMap& destination) const
+    {
+        destination.erase(destination.lower_bound(from), destination.upper_bound(to));
+
+        if (events) {
+            destination.insert(events->cbegin(), events->cend());
+        }
+    }
+};
+
+using PlaybackEventsChanges = async::Channel<PlaybackEventsChunk>;
+
 struct PlaybackSetupData
 {
     SoundId id = SoundId::Undefined;
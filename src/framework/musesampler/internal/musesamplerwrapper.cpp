@@ -209,15 +209,18 @@ void MuseSamplerWrapper::setupSound(const mpe::PlaybackSetupData& setupData)
     m_track = m_samplerLib->addTrack(m_sampler, internalId);
 }
 
-void MuseSamplerWrapper::loadMainStreamEvents(const mpe::PlaybackEventsMap& events)
+void MuseSamplerWrapper::loadMainStreamEvents(const mpe::PlaybackEventsChunk& events)
 {
     IF_ASSERT_FAILED(m_samplerLib && m_sampler && m_track) {
         return;
     }
 
+    //!Note The sampler track can't be partially updated, so that it is being rebuilt from the spliced events
+    AbstractSynthesizer::loadMainStreamEvents(events);
+
     m_samplerLib->clearTrack(m_sampler, m_track);
 
-    for (const auto& pair : events) {
+    for (const auto& pair : m_mainStreamEvents.events()) {
         for (const auto& event : pair.second) {
             if (!std::holds_alternative<mpe::NoteEvent>(event)) {
                 continue;
@@ -234,7 +237,7 @@ void MuseSamplerWrapper::loadMainStreamEvents(const mpe::PlaybackEventsMap& even
     }
 }
 
-void MuseSamplerWrapper::loadOffStreamEvents(const mpe::PlaybackEventsMap& events)
+void MuseSamplerWrapper::loadOffStreamEvents(const mpe::PlaybackEventsChunk& events)
 {
     UNUSED(events);
     NOT_IMPLEMENTED;
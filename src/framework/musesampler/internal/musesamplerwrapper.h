@@ -50,8 +50,8 @@ public:
 protected:
     void setupSound(const mpe::PlaybackSetupData& setupData) override;
 
-    void loadMainStreamEvents(const mpe::PlaybackEventsMap& events) override;
-    void loadOffStreamEvents(const mpe::PlaybackEventsMap& events) override;
+    void loadMainStreamEvents(const mpe::PlaybackEventsChunk& events) override;
+    void loadOffStreamEvents(const mpe::PlaybackEventsChunk& events) override;
     void loadDynamicLevelChanges(const mpe::DynamicLevelMap& dynamicLevels) override;
 
     void extractOutputSamples(audio::samples_t samples, float* output);
@@ -39,6 +39,13 @@ public:
     virtual bool musicxmlImportLayout() const = 0;
     virtual void setMusicxmlImportLayout(bool value) = 0;
 
+    enum class MusicxmlValidationMode {
+        BeforeImport, ConcurrentWithImport, Skip
+    };
+
+    virtual MusicxmlValidationMode musicxmlValidationMode() const = 0;
+    virtual void setMusicxmlValidationMode(MusicxmlValidationMode mode) = 0;
+
     virtual bool musicxmlExportLayout() const = 0;
     virtual void setMusicxmlExportLayout(bool value) = 0;
 
@@ -52,7 +52,8 @@ static int musicXMLImportErrorDialog(QString text, QString detailedText)
 //   importMusicXMLfromBuffer
 //---------------------------------------------------------
 
-Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/, QIODevice* dev)
+Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/, QIODevice* dev,
+                                          const std::function<Score::FileError()>& afterPass1)
 {
     //LOGD("importMusicXMLfromBuffer(score %p, name '%s', dev %p)",
     //       score, qPrintable(name), dev);
@@ -68,6 +69,10 @@ Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/,
     Score::FileError res = pass1.parse(dev);
     const auto pass1_errors = pass1.errors();
 
+    if (res == Score::FileError::FILE_NO_ERROR && afterPass1) {
+        res = afterPass1();
+    }
+
     // pass 2
     MusicXMLParserPass2 pass2(score, pass1, &logger);
     if (res == Score::FileError::FILE_NO_ERROR) {
@@ -77,7 +82,7 @@ Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/,
 
     // report result
     const auto pass2_errors = pass2.errors();
-    if (!(pass1_errors.isEmpty() && pass2_errors.isEmpty())) {
+    if (res != Score::FileError::FILE_USER_ABORT && !(pass1_errors.isEmpty() && pass2_errors.isEmpty())) {
         if (!MScore::noGui) {
             const QString text { QObject::tr("Error(s) found, import may be incomplete.") };
             if (musicXMLImportErrorDialog(text, pass1.errors() + pass2.errors()) != QMessageBox::Yes) {
@@ -24,6 +24,10 @@
  MusicXML import.
  */
 
+#include <future>
+#include <memory>
+#include <mutex>
+
 #include <QMessageBox>
 #include <QXmlSchema>
 #include <QXmlSchemaValidator>
@@ -32,8 +36,13 @@
 #include "serialization/internal/qzipreader_p.h"
 #include "importmxml.h"
 
+#include "modularity/ioc.h"
+#include "importexport/musicxml/imusicxmlconfiguration.h"
+
 #include "log.h"
 
+using MusicxmlValidationMode = mu::iex::musicxml::IMusicXmlConfiguration::MusicxmlValidationMode;
+
 namespace mu::engraving {
 //---------------------------------------------------------
 //   tupletAssert -- check assertions for tuplet handling
@@ -104,6 +113,72 @@ static bool initMusicXmlSchema(QXmlSchema& schema)
     return true;
 }
 
+//---------------------------------------------------------
+//   CompiledSchemas
+//---------------------------------------------------------
+
+/**
+ Compiled MusicXML schemas shared by all the imports of the process.
+ Compiling the schema takes longer than validating most files, so it is done once
+ per concurrent validation instead of once per import. QXmlSchema is reentrant but not
+ thread safe, so each schema is used by one validation at a time.
+ */
+
+class CompiledSchemas
+{
+public:
+    static std::unique_ptr<QXmlSchema> acquire()
+    {
+        //! NOTE Shared by all the schemas, QAbstractMessageHandler serializes the messages
+        static SchemaMessageHandler messageHandler;
+
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            if (!s_schemas.empty()) {
+                std::unique_ptr<QXmlSchema> schema = std::move(s_schemas.back());
+                s_schemas.pop_back();
+                return schema;
+            }
+        }
+
+        std::unique_ptr<QXmlSchema> schema = std::make_unique<QXmlSchema>();
+        schema->setMessageHandler(&messageHandler);
+        if (!initMusicXmlSchema(*schema)) {
+            return nullptr;
+        }
+
+        return schema;
+    }
+
+    static void release(std::unique_ptr<QXmlSchema> schema)
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_schemas.push_back(std::move(schema));
+    }
+
+private:
+    static std::mutex s_mutex;
+    static std::vector<std::unique_ptr<QXmlSchema> > s_schemas;
+};
+
+std::mutex CompiledSchemas::s_mutex;
+std::vector<std::unique_ptr<QXmlSchema> > CompiledSchemas::s_schemas;
+
+//---------------------------------------------------------
+//   ValidationSettings
+//---------------------------------------------------------
+
+class ValidationSettings
+{
+    INJECT_STATIC(iex_musicxml, mu::iex::musicxml::IMusicXmlConfiguration, configuration)
+
+public:
+    static MusicxmlValidationMode mode()
+    {
+        return configuration() ? configuration()->musicxmlValidationMode() : MusicxmlValidationMode::BeforeImport;
+    }
+};
+
 //---------------------------------------------------------
 //   musicXMLValidationErrorDialog
 //---------------------------------------------------------
@@ -183,37 +258,72 @@ static bool extractRootfile(QFile* qf, QByteArray& data)
 }
 
 //---------------------------------------------------------
-//   doValidate
+//   ValidationResult
+//---------------------------------------------------------
+
+struct ValidationResult {
+    Score::FileError error = Score::FileError::FILE_NO_ERROR;
+    bool valid = true;
+    QString errors;
+};
+
+//---------------------------------------------------------
+//   validate
 //---------------------------------------------------------
 
 /**
  Validate MusicXML data from file \a name contained in QIODevice \a dev.
+ Doesn't interact with the user, so it can be run on any thread.
  */
 
-static Score::FileError doValidate(const QString& name, QIODevice* dev)
+static ValidationResult validate(const QString& name, QIODevice* dev)
 {
     //QElapsedTimer t;
     //t.start();
 
-    // initialize the schema
-    ValidatorMessageHandler messageHandler;
-    QXmlSchema schema;
-    schema.setMessageHandler(&messageHandler);
-    if (!initMusicXmlSchema(schema)) {
-        return Score::FileError::FILE_BAD_FORMAT;      // appropriate error message has been printed by initMusicXmlSchema
+    ValidationResult result;
+
+    // get a compiled schema
+    std::unique_ptr<QXmlSchema> schema = CompiledSchemas::acquire();
+    if (!schema) {
+        result.error = Score::FileError::FILE_BAD_FORMAT;      // appropriate error message has been printed by initMusicXmlSchema
+        return result;
     }
+
     // validate the data
-    QXmlSchemaValidator validator(schema);
-    bool valid = validator.validate(dev, QUrl::fromLocalFile(name));
+    ValidatorMessageHandler messageHandler;
+    QXmlSchemaValidator validator(*schema);
+    validator.setMessageHandler(&messageHandler);
+    result.valid = validator.validate(dev, QUrl::fromLocalFile(name));
+    result.errors = messageHandler.getErrors();
     //LOGD("Validation time elapsed: %d ms", t.elapsed());
 
-    if (!valid) {
+    CompiledSchemas::release(std::move(schema));
+
+    return result;
+}
+
+//---------------------------------------------------------
+//   handleValidationResult
+//---------------------------------------------------------
+
+/**
+ Report the validation result of file \a name and ask the user whether to continue if it is invalid.
+ */
+
+static Score::FileError handleValidationResult(const QString& name, const ValidationResult& result)
+{
+    if (result.error != Score::FileError::FILE_NO_ERROR) {
+        return result.error;
+    }
+
+    if (!result.valid) {
         LOGD("importMusicXml() file '%s' is not a valid MusicXML file", qPrintable(name));
         MScore::lastError = QObject::tr("File '%1' is not a valid MusicXML file").arg(name);
         if (MScore::noGui) {
             return Score::FileError::FILE_NO_ERROR;         // might as well try anyhow in converter mode
         }
-        if (musicXMLValidationErrorDialog(MScore::lastError, messageHandler.getErrors()) != QMessageBox::Yes) {
+        if (musicXMLValidationErrorDialog(MScore::lastError, result.errors) != QMessageBox::Yes) {
             return Score::FileError::FILE_USER_ABORT;
         }
     }
@@ -235,16 +345,73 @@ static Score::FileError doValidateAndImport(Score* score, const QString& name, Q
     // verify tuplet DurationType dependencies
     tupletAssert();
 
-    // validate the file
-    Score::FileError res;
-    res = doValidate(name, dev);
-    if (res != Score::FileError::FILE_NO_ERROR) {
-        return res;
+    MusicxmlValidationMode mode = ValidationSettings::mode();
+
+    //! NOTE In converter mode an invalid file is imported anyway,
+    //! so there is no need to wait for the validation before the import
+    if (mode == MusicxmlValidationMode::BeforeImport && MScore::noGui) {
+        mode = MusicxmlValidationMode::ConcurrentWithImport;
+    }
+
+    switch (mode) {
+    case MusicxmlValidationMode::Skip:
+        return importMusicXMLfromBuffer(score, name, dev);
+
+    case MusicxmlValidationMode::BeforeImport: {
+        Score::FileError res = handleValidationResult(name, validate(name, dev));
+        if (res != Score::FileError::FILE_NO_ERROR) {
+            return res;
+        }
+
+        return importMusicXMLfromBuffer(score, name, dev);
+    }
+
+    case MusicxmlValidationMode::ConcurrentWithImport:
+        break;
+    }
+
+    // validate the data on a worker thread while pass 1 runs, the result is needed only before pass 2.
+    // The worker reads the file through its own device, the data of a buffer (e.g. an unzipped
+    // compressed file) is shared with it, only the data of the other devices is copied
+    const QFile* file = qobject_cast<QFile*>(dev);
+    const QString fileName = file ? file->fileName() : QString();
+    QByteArray data;
+    if (fileName.isEmpty()) {
+        if (const QBuffer* buffer = qobject_cast<QBuffer*>(dev)) {
+            data = buffer->data();
+        } else {
+            dev->seek(0);
+            data = dev->readAll();
+        }
+    }
+
+    std::future<ValidationResult> validation = std::async(std::launch::async, [fileName, data, name]() {
+        std::unique_ptr<QIODevice> device;
+        if (!fileName.isEmpty()) {
+            device = std::make_unique<QFile>(fileName);
+        } else {
+            auto buffer = std::make_unique<QBuffer>();
+            buffer->setData(data);
+            device = std::move(buffer);
+        }
+
+        if (!device->open(QIODevice::ReadOnly)) {
+            ValidationResult result;
+            result.error = Score::FileError::FILE_OPEN_ERROR;
+            return result;
+        }
+
+        return validate(name, device.get());
+    });
+
+    Score::FileError res = importMusicXMLfromBuffer(score, name, dev, [&validation, &name]() {
+        return handleValidationResult(name, validation.get());
+    });
+
+    if (validation.valid()) {
+        validation.wait();
     }
 
-    // actually do the import
-    res = importMusicXMLfromBuffer(score, name, dev);
-    //LOGD("res %d", static_cast<int>(res));
     return res;
 }
 
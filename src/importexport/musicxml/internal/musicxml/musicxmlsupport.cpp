@@ -213,6 +213,20 @@ void ValidatorMessageHandler::handleMessage(QtMsgType type, const QString& descr
     errors += errorStr;
 }
 
+void SchemaMessageHandler::handleMessage(QtMsgType type, const QString& description,
+                                         const QUrl& /* identifier */, const QSourceLocation& sourceLocation)
+{
+    // the description is html, log its text
+    QDomDocument desc;
+    const QString descText = desc.setContent(description, false) ? desc.documentElement().text() : description;
+
+    if (type == QtDebugMsg) {
+        LOGD() << "MusicXML schema, line " << sourceLocation.line() << " column " << sourceLocation.column() << ": " << descText;
+    } else {
+        LOGW() << "MusicXML schema, line " << sourceLocation.line() << " column " << sourceLocation.column() << ": " << descText;
+    }
+}
+
 //---------------------------------------------------------
 //   printDomElementPath
 //---------------------------------------------------------
@@ -232,6 +232,25 @@ private:
     QString errors;
 };
 
+//---------------------------------------------------------
+//   SchemaMessageHandler
+//---------------------------------------------------------
+
+/**
+ Message handler for loading the MusicXML schema QXmlSchema, logs the messages.
+ */
+
+class SchemaMessageHandler : public QAbstractMessageHandler
+{
+    Q_OBJECT
+
+public:
+    SchemaMessageHandler()
+        : QAbstractMessageHandler(0) {}
+protected:
+    virtual void handleMessage(QtMsgType type, const QString& description, const QUrl& identifier, const QSourceLocation& sourceLocation);
+};
+
 extern void domError(const QDomElement&);
 extern void domNotImplemented(const QDomElement&);
 
@@ -36,6 +36,9 @@ public:
     bool musicxmlImportLayout() const override;
     void setMusicxmlImportLayout(bool value) override;
 
+    MusicxmlValidationMode musicxmlValidationMode() const override;
+    void setMusicxmlValidationMode(MusicxmlValidationMode mode) override;
+
     bool musicxmlExportLayout() const override;
     void setMusicxmlExportLayout(bool value) override;
 
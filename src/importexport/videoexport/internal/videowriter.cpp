@@ -21,6 +21,11 @@
  */
 #include "videowriter.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "videoencoder.h"
 
 #include "engraving/libmscore/page.h"
@@ -153,18 +158,6 @@ mu::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, con
     score->setLayoutAll();
     score->update();
 
-    // Setup painting
-    QImage frame(config.width, config.height, QImage::Format_RGB32);
-    frame.setDotsPerMeterX(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
-    frame.setDotsPerMeterY(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
-
-    QPainter qp(&frame);
-    qp.setRenderHint(QPainter::Antialiasing, true);
-    qp.setRenderHint(QPainter::TextAntialiasing, true);
-    RectF frameRect = RectF::fromQRectF(QRectF(frame.rect()));
-
-    draw::Painter painter(&qp, "video_writer");
-
     auto painting = masterNotation->notation()->painting();
 
     // Setup duration
@@ -186,9 +179,82 @@ mu::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, con
         return nullptr;
     };
 
+    auto newImage = [&config, CANVAS_DPI]() {
+        QImage image(config.width, config.height, QImage::Format_RGB32);
+        image.setDotsPerMeterX(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
+        image.setDotsPerMeterY(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
+        return image;
+    };
+
+    //! NOTE A page is painted once, when the cursor comes to it,
+    //! every frame is a copy of it with the cursor on top
+    const Page* cachedPage = nullptr;
+    QImage pageImage = newImage();
+
+    auto renderPage = [&](const Page* page) {
+        pageImage.fill(Qt::white);
+
+        QPainter qp(&pageImage);
+        qp.setRenderHint(QPainter::Antialiasing, true);
+        qp.setRenderHint(QPainter::TextAntialiasing, true);
+
+        draw::Painter painter(&qp, "video_writer");
+
+        INotationPainting::Options opt;
+        opt.fromPage = page->no();
+        opt.toPage = opt.fromPage;
+        opt.deviceDpi = CANVAS_DPI;
+
+        painting->paintPrint(&painter, opt);
+    };
+
+    //! NOTE Frames are composed on this thread (the cursor needs the score) and encoded on another one,
+    //! the queue is bounded so that memory doesn't grow when the encoder is slower
+    const size_t MAX_QUEUED_FRAMES = 8;
+
+    std::deque<QImage> frames;
+    bool framesFinished = false;
+    std::mutex framesMutex;
+    std::condition_variable framesChanged;
+
+    std::thread encoderThread([&]() {
+        while (true) {
+            QImage frame;
+            {
+                std::unique_lock<std::mutex> lock(framesMutex);
+                framesChanged.wait(lock, [&]() { return !frames.empty() || framesFinished; });
+                if (frames.empty()) {
+                    break;
+                }
+
+                frame = std::move(frames.front());
+                frames.pop_front();
+            }
+
+            framesChanged.notify_all();
+
+            encoder.encodeImage(frame);
+        }
+    });
+
+    auto pushFrame = [&](const QImage& frame) {
+        std::unique_lock<std::mutex> lock(framesMutex);
+        framesChanged.wait(lock, [&]() { return frames.size() < MAX_QUEUED_FRAMES; });
+        frames.push_back(frame);
+        lock.unlock();
+        framesChanged.notify_all();
+    };
+
     PlaybackCursor cursor;
     cursor.setNotation(masterNotation->notation());
 
+    //! NOTE The cursor often stays at the same place for several frames (leading and trailing time, long notes),
+    //! then the previous frame is encoded again, it's shared, not copied
+    QImage lastFrame;
+    RectF lastCursorRect;
+
+    const double SCALE = CANVAS_DPI / Ms::DPI;
+
     for (int f = 0; f < frameCount; f++) {
         float currentTimeSec = (qreal)f / config.fps;
         currentTimeSec -= config.leadingSec;
@@ -206,26 +272,44 @@ mu::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, con
             break;
         }
 
-        INotationPainting::Options opt;
-        opt.fromPage = page->no();
-        opt.toPage = opt.fromPage;
-        opt.deviceDpi = CANVAS_DPI;
-
-        painter.fillRect(frameRect, draw::Color::white);
-
-        painting->paintPrint(&painter, opt);
-
         cursor.move(tick);
 
         RectF cursorRect = cursor.rect();
         PointF pagePos = page->pos();
         RectF cursorAbsRect = cursorRect.translated(-pagePos);
 
-        painter.fillRect(cursorAbsRect, CURSOR_COLOR);
+        if (page == cachedPage && cursorAbsRect == lastCursorRect && !lastFrame.isNull()) {
+            pushFrame(lastFrame);
+            continue;
+        }
+
+        if (page != cachedPage) {
+            renderPage(page);
+            cachedPage = page;
+        }
+
+        QImage frame = pageImage.copy();
+        {
+            QPainter qp(&frame);
+            draw::Painter painter(&qp, "video_writer_cursor");
+            painter.scale(SCALE, SCALE);
+            painter.fillRect(cursorAbsRect, CURSOR_COLOR);
+        }
+
+        lastFrame = frame;
+        lastCursorRect = cursorAbsRect;
 
-        encoder.encodeImage(frame);
+        pushFrame(frame);
     }
 
+    {
+        std::lock_guard<std::mutex> lock(framesMutex);
+        framesFinished = true;
+    }
+
+    framesChanged.notify_all();
+    encoderThread.join();
+
     encoder.close();
 
     return make_ok();
@@ -83,6 +83,11 @@ void NotationAccessibility::setEnabled(bool enabled)
     };
 
     EngravingItem* selectedElement = selection()->element();
+    if (enabled && selectedElement) {
+        //! NOTE The element could have been selected before the screen reader was connected
+        selectedElement->initAccessibleIfNeed();
+    }
+
     AccessibleItemPtr selectedElementAccItem = selectedElement ? selectedElement->accessible() : nullptr;
 
     for (AccessibleRoot* root : roots) {
@@ -54,6 +54,12 @@ void NotationPainting::setViewMode(const ViewMode& viewMode)
     }
 
     if (score()->layoutMode() == viewMode) {
+        //! NOTE The notation is about to be shown, so apply the layout deferred while it was in background
+        if (score()->isLayoutPending()) {
+            score()->doPendingLayout();
+            m_notation->notifyAboutNotationChanged();
+        }
+
         return;
     }
 
@@ -119,6 +125,8 @@ void NotationPainting::doPaint(draw::Painter* painter, const Options& opt)
         return;
     }
 
+    score()->doPendingLayout();
+
     const std::vector<mu::engraving::Page*>& pages = score()->pages();
     if (pages.empty()) {
         return;
@@ -144,9 +152,20 @@ void NotationPainting::doPaint(draw::Painter* painter, const Options& opt)
     }
 
     // Setup score draw system
-    mu::engraving::MScore::pixelRatio = mu::engraving::DPI / DEVICE_DPI;
-    score()->setPrinting(opt.isPrinting);
-    mu::engraving::MScore::pdfPrinting = opt.isPrinting;
+    //! NOTE The pages may be painted concurrently (e.g. PNG export), once the first one has set the same paint state,
+    //! so the shared state is only written if it changes
+    const double pixelRatio = mu::engraving::DPI / DEVICE_DPI;
+    if (mu::engraving::MScore::pixelRatio != pixelRatio) {
+        mu::engraving::MScore::pixelRatio = pixelRatio;
+    }
+
+    if (score()->printing() != opt.isPrinting) {
+        score()->setPrinting(opt.isPrinting);
+    }
+
+    if (mu::engraving::MScore::pdfPrinting != opt.isPrinting) {
+        mu::engraving::MScore::pdfPrinting = opt.isPrinting;
+    }
 
     // Setup page counts
     int fromPage = opt.fromPage >= 0 ? opt.fromPage : 0;
@@ -21,6 +21,16 @@
  */
 #include "palettecelliconengine.h"
 
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+
+#include <QCache>
+#include <QCoreApplication>
+#include <QPainter>
+#include <QTimer>
+
 #include "engraving/infrastructure/draw/geometry.h"
 #include "engraving/infrastructure/draw/painter.h"
 #include "engraving/infrastructure/draw/pen.h"
@@ -35,6 +45,28 @@ using namespace mu::palette;
 using namespace mu::draw;
 using namespace mu::engraving;
 
+static constexpr int CACHE_LIMIT_KB = 64 * 1024;
+static constexpr size_t PRERENDER_BATCH_SIZE = 8;
+
+//! NOTE The cells can be painted from the render thread (while the GUI thread is blocked),
+//! so the images are stored as QImage and the cache is guarded
+static std::mutex s_cacheMutex;
+static QCache<QString, QImage> s_cache(CACHE_LIMIT_KB);
+
+//! NOTE The size that the cells of a palette were last painted with, to prerender the
+//! cells that are not on the screen yet with the same size
+static std::map<qreal, QSize> s_lastPaintedSizes;
+static qreal s_lastPixelRatio = 1.0;
+
+struct PrerenderJob {
+    PaletteCellConstPtr cell;
+    qreal extraMag = 1.0;
+    QSize size;
+    qreal pixelRatio = 1.0;
+};
+
+static std::deque<PrerenderJob> s_prerenderQueue;
+
 PaletteCellIconEngine::PaletteCellIconEngine(PaletteCellConstPtr cell, qreal extraMag)
     : QIconEngine(), m_cell(cell), m_extraMag(extraMag)
 {
@@ -47,11 +79,144 @@ QIconEngine* PaletteCellIconEngine::clone() const
 
 void PaletteCellIconEngine::paint(QPainter* qp, const QRect& rect, QIcon::Mode mode, QIcon::State state)
 {
-    Painter p(qp, "palettecell");
-    p.save();
-    p.setAntialiasing(true);
-    paintCell(p, RectF::fromQRectF(rect), mode == QIcon::Selected, state == QIcon::On);
-    p.restore();
+    const bool selected = mode == QIcon::Selected;
+    const bool current = state == QIcon::On;
+
+    qreal pixelRatio = qp->deviceTransform().m11();
+    if (rect.isEmpty() || pixelRatio <= 0.0) {
+        return;
+    }
+
+    QString key = cacheKey(rect.size(), pixelRatio, selected, current);
+
+    {
+        std::lock_guard<std::mutex> lock(s_cacheMutex);
+        s_lastPaintedSizes[m_extraMag] = rect.size();
+        s_lastPixelRatio = pixelRatio;
+
+        if (const QImage* image = s_cache.object(key)) {
+            qp->drawImage(rect.topLeft(), *image);
+            return;
+        }
+    }
+
+    QImage image = renderCell(rect.size(), pixelRatio, selected, current);
+    qp->drawImage(rect.topLeft(), image);
+
+    std::lock_guard<std::mutex> lock(s_cacheMutex);
+    s_cache.insert(key, new QImage(image), std::max(1, static_cast<int>(image.sizeInBytes() / 1024)));
+}
+
+QString PaletteCellIconEngine::cacheKey(const QSize& size, qreal pixelRatio, bool selected, bool current) const
+{
+    if (!m_cell) {
+        return QString("empty:%1x%2:%3:%4:%5:%6")
+               .arg(size.width()).arg(size.height()).arg(pixelRatio)
+               .arg(selected).arg(current).arg(configuration()->accentColor().name(QColor::HexArgb));
+    }
+
+    return QString("%1:%2:%3:%4:%5:%6:%7:%8x%9:%10:%11:%12:%13:%14:%15:%16")
+           .arg(m_cell->id)
+           .arg(reinterpret_cast<quintptr>(m_cell->element.get()))
+           .arg(m_cell->mag)
+           .arg(m_cell->xoffset)
+           .arg(m_cell->yoffset)
+           .arg(m_cell->drawStaff)
+           .arg(m_extraMag)
+           .arg(size.width()).arg(size.height())
+           .arg(pixelRatio)
+           .arg(uiConfiguration()->guiScaling())
+           .arg(uiConfiguration()->logicalDpi())
+           .arg(selected)
+           .arg(current)
+           .arg(configuration()->elementsColor().name(QColor::HexArgb))
+           .arg(configuration()->accentColor().name(QColor::HexArgb));
+}
+
+QImage PaletteCellIconEngine::renderCell(const QSize& size, qreal pixelRatio, bool selected, bool current) const
+{
+    QImage image(size * pixelRatio, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(pixelRatio);
+    image.fill(Qt::transparent);
+
+    {
+        QPainter qp(&image);
+        Painter p(&qp, "palettecell");
+        p.save();
+        p.setAntialiasing(true);
+        paintCell(p, RectF(0.0, 0.0, size.width(), size.height()), selected, current);
+        p.restore();
+    }
+
+    return image;
+}
+
+void PaletteCellIconEngine::prerenderCells(const std::vector<PaletteCellConstPtr>& cells, qreal extraMag, const QSize& defaultSize)
+{
+    QSize size = defaultSize;
+    qreal pixelRatio = 1.0;
+
+    {
+        std::lock_guard<std::mutex> lock(s_cacheMutex);
+        auto it = s_lastPaintedSizes.find(extraMag);
+        if (it != s_lastPaintedSizes.end()) {
+            size = it->second;
+        }
+        pixelRatio = s_lastPixelRatio;
+    }
+
+    if (size.isEmpty()) {
+        return;
+    }
+
+    const bool wasEmpty = s_prerenderQueue.empty();
+    for (const PaletteCellConstPtr& cell : cells) {
+        if (cell && cell->visible) {
+            s_prerenderQueue.push_back({ cell, extraMag, size, pixelRatio });
+        }
+    }
+
+    if (!wasEmpty || s_prerenderQueue.empty()) {
+        return;
+    }
+
+    //! NOTE The elements can only be laid out and drawn on the main thread, so the cells
+    //! are rendered in small batches while the event loop is idle
+    static std::function<void()> prerenderBatch = []() {
+        for (size_t i = 0; i < PRERENDER_BATCH_SIZE && !s_prerenderQueue.empty(); ++i) {
+            PrerenderJob job = s_prerenderQueue.front();
+            s_prerenderQueue.pop_front();
+
+            PaletteCellIconEngine engine(job.cell, job.extraMag);
+            QString key = engine.cacheKey(job.size, job.pixelRatio, false, false);
+
+            {
+                std::lock_guard<std::mutex> lock(s_cacheMutex);
+                if (s_cache.contains(key)) {
+                    continue;
+                }
+            }
+
+            QImage image = engine.renderCell(job.size, job.pixelRatio, false, false);
+
+            std::lock_guard<std::mutex> lock(s_cacheMutex);
+            s_cache.insert(key, new QImage(image), std::max(1, static_cast<int>(image.sizeInBytes() / 1024)));
+        }
+
+        if (!s_prerenderQueue.empty()) {
+            QTimer::singleShot(0, qApp, prerenderBatch);
+        }
+    };
+
+    QTimer::singleShot(0, qApp, prerenderBatch);
+}
+
+void PaletteCellIconEngine::clearCache()
+{
+    s_prerenderQueue.clear();
+
+    std::lock_guard<std::mutex> lock(s_cacheMutex);
+    s_cache.clear();
 }
 
 void PaletteCellIconEngine::paintCell(Painter& painter, const RectF& rect, bool selected, bool current) const
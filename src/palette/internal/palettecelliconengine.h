@@ -23,6 +23,7 @@
 #define MU_PALETTE_PALETTECELLICONENGINE_H
 
 #include <QIconEngine>
+#include <QImage>
 
 #include "palettecell.h"
 
@@ -56,7 +57,15 @@ public:
 
     static void paintPaletteElement(void* context, mu::engraving::EngravingItem* element);
 
+    //! NOTE The cells are rasterized once for a given size, pixel ratio, state and colors,
+    //! and then drawn from the cache until it is cleared
+    static void prerenderCells(const std::vector<PaletteCellConstPtr>& cells, qreal extraMag, const QSize& defaultSize);
+    static void clearCache();
+
 private:
+    QString cacheKey(const QSize& size, qreal pixelRatio, bool selected, bool current) const;
+    QImage renderCell(const QSize& size, qreal pixelRatio, bool selected, bool current) const;
+
     void paintCell(draw::Painter& painter, const RectF& rect, bool selected, bool current) const;
     void paintBackground(draw::Painter& painter, const RectF& rect, bool selected, bool current) const;
     void paintActionIcon(draw::Painter& painter, const RectF& rect, mu::engraving::EngravingItem* element) const;
@@ -55,6 +55,7 @@ PaletteTreeModel::PaletteTreeModel(PaletteTreePtr tree, QObject* parent)
     connect(this, &QAbstractItemModel::rowsRemoved, this, &PaletteTreeModel::setTreeChanged);
 
     configuration()->colorsChanged().onNotify(this, [this]() {
+        PaletteCellIconEngine::clearCache();
         notifyAboutCellsChanged(Qt::DecorationRole);
     });
 }
@@ -79,6 +80,7 @@ void PaletteTreeModel::onDataChanged(const QModelIndex& topLeft, const QModelInd
     }
 
     if (treeChanged) {
+        PaletteCellIconEngine::clearCache();
         setTreeChanged();
     }
 }
@@ -433,6 +435,12 @@ bool PaletteTreeModel::setData(const QModelIndex& index, const QVariant& value,
                         pp->setExpanded(val);
                         emit dataChanged(index, index, { PaletteExpandedRole });
                     }
+
+                    if (val) {
+                        std::vector<PaletteCellConstPtr> cells(pp->cells().cbegin(), pp->cells().cend());
+                        PaletteCellIconEngine::prerenderCells(cells, pp->mag() * configuration()->paletteScaling(),
+                                                              pp->scaledGridSize());
+                    }
                 }
                 return true;
             }
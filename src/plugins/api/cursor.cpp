@@ -36,6 +36,7 @@
 #include "libmscore/segment.h"
 #include "libmscore/timesig.h"
 #include "libmscore/tuplet.h"
+#include "libmscore/undo.h"
 
 namespace mu::engraving {
 namespace PluginAPI {
@@ -522,6 +523,184 @@ void Cursor::addTuplet(FractionWrapper* ratio, FractionWrapper* duration)
     inputState().setDuration(baseLen);
 }
 
+//---------------------------------------------------------
+//   addBatch
+///   \brief Adds a sequence of notes, chords, rests and
+///   elements starting from the current cursor position.
+///   \details All the entries are added within a single
+///   undoable command, and the score is laid out only once,
+///   over the range of the changes, when all of them have
+///   been added. If a command was already started with
+///   Score.startCmd(), the entries become part of it and the
+///   layout happens at the corresponding Score.endCmd().
+///   This is much faster than calling addNote() or addRest()
+///   for each of thousands of notes.
+///
+///   Each entry of \p items is one of:
+///   - a number: adds a note with this MIDI pitch, as
+///     addNote() does;
+///   - an array of numbers: adds a chord with these pitches;
+///   - an element: adds it at the cursor position, as add()
+///     does;
+///   - an object with the following optional properties:
+///     - \p pitch or \p pitches: the pitch of a note or
+///       the pitches of a chord;
+///     - \p rest: if true, adds a rest;
+///     - \p duration: the duration of this and of the
+///       following entries, as an array [numerator,
+///       denominator] or a \ref FractionWrapper "fraction";
+///     - \p element: an element to add, as add() does.
+///
+///   Examples:
+///   \code
+///   cursor.setDuration(1, 8);
+///   cursor.addBatch([60, 62, [64, 67], { rest: true }, { pitch: 65, duration: [1, 2] }]);
+///   \endcode
+///   \param items the entries to add.
+///   \returns the number of entries that were added.
+///   \since MuseScore 4.0
+//---------------------------------------------------------
+
+int Cursor::addBatch(const QVariantList& items)
+{
+    if (!segment()) {
+        LOGW("Cursor::addBatch: cursor location is undefined, use rewind() to define its location");
+        return 0;
+    }
+
+    //! NOTE Nothing is laid out while the command is open, the edits only extend
+    //! the range that is laid out (once) when the command ends.
+    //! The command is opened on the undo stack of the cursor's score, which isn't necessarily the current notation
+    const bool ownCmd = !_score->undoStack()->active();
+    if (ownCmd) {
+        _score->startCmd();
+    }
+
+    int added = 0;
+    for (const QVariant& item : items) {
+        if (addBatchItem(item)) {
+            ++added;
+        }
+    }
+
+    if (ownCmd) {
+        _score->endCmd();
+    }
+
+    return added;
+}
+
+//---------------------------------------------------------
+//   addBatchItem
+//---------------------------------------------------------
+
+bool Cursor::addBatchItem(const QVariant& item)
+{
+    if (!segment()) {
+        LOGW("Cursor::addBatch: reached the end of the score");
+        return false;
+    }
+
+    if (EngravingItem* element = qobject_cast<EngravingItem*>(item.value<QObject*>())) {
+        add(element);
+        return true;
+    }
+
+    QVariantMap entry;
+    if (item.type() == QVariant::Map) {
+        entry = item.toMap();
+    } else if (item.type() == QVariant::List) {
+        entry["pitches"] = item;
+    } else {
+        entry["pitch"] = item;
+    }
+
+    if (entry.contains("duration") && !setBatchDuration(entry.value("duration"))) {
+        LOGW("Cursor::addBatch: invalid duration");
+        return false;
+    }
+
+    if (!inputState().duration().isValid()) {
+        setDuration(1, 4);
+    }
+
+    if (entry.value("rest").toBool()) {
+        _score->enterRest(inputState().duration(), is.get());
+        return true;
+    }
+
+    if (entry.contains("element")) {
+        EngravingItem* element = qobject_cast<EngravingItem*>(entry.value("element").value<QObject*>());
+        if (!element) {
+            LOGW("Cursor::addBatch: invalid element");
+            return false;
+        }
+
+        add(element);
+        return true;
+    }
+
+    QVariantList pitches;
+    if (entry.contains("pitches")) {
+        pitches = entry.value("pitches").toList();
+    } else if (entry.contains("pitch")) {
+        pitches.append(entry.value("pitch"));
+    }
+
+    if (pitches.empty()) {
+        LOGW("Cursor::addBatch: nothing to add");
+        return false;
+    }
+
+    for (const QVariant& pitchValue : pitches) {
+        bool ok = false;
+        int pitch = pitchValue.toInt(&ok);
+        if (!ok || !pitchIsValid(pitch)) {
+            LOGW("Cursor::addBatch: invalid pitch: %s", qPrintable(pitchValue.toString()));
+            return false;
+        }
+    }
+
+    bool addToChord = false;
+    for (const QVariant& pitchValue : pitches) {
+        NoteVal nval(pitchValue.toInt());
+        _score->addPitch(nval, addToChord, is.get());
+        addToChord = true;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------
+//   setBatchDuration
+//---------------------------------------------------------
+
+bool Cursor::setBatchDuration(const QVariant& duration)
+{
+    Fraction f;
+    if (FractionWrapper* wrapper = qobject_cast<FractionWrapper*>(duration.value<QObject*>())) {
+        f = wrapper->fraction();
+    } else {
+        QVariantList parts = duration.toList();
+        if (parts.size() != 2) {
+            return false;
+        }
+        f = Fraction(parts.at(0).toInt(), parts.at(1).toInt());
+    }
+
+    if (!f.isValid() || f.isZero() || f.negative()) {
+        return false;
+    }
+
+    TDuration d(f);
+    if (!d.isValid()) {
+        return false;
+    }
+
+    inputState().setDuration(d);
+    return true;
+}
+
 //---------------------------------------------------------
 //   setDuration
 ///   Set duration of the notes added by the cursor.
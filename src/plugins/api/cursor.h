@@ -149,6 +149,9 @@ private:
     int inputStateString() const;
     void setInputStateString(int);
 
+    bool addBatchItem(const QVariant& item);
+    bool setBatchDuration(const QVariant& duration);
+
 public:
     /// \cond MS_INTERNAL
     Cursor(mu::engraving::Score* s = nullptr);
@@ -194,6 +197,7 @@ public:
     Q_INVOKABLE void addNote(int pitch, bool addToChord = false);
     Q_INVOKABLE void addRest();
     Q_INVOKABLE void addTuplet(mu::engraving::PluginAPI::FractionWrapper* ratio, mu::engraving::PluginAPI::FractionWrapper* duration);
+    Q_INVOKABLE int addBatch(const QVariantList& items);
 
     //@ set duration
     //@   z: numerator
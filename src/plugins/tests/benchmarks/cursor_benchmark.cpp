@@ -0,0 +1,123 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "plugins/api/cursor.h"
+
+#include "engraving/compat/scoreaccess.h"
+#include "engraving/compat/mscxcompat.h"
+#include "engraving/infrastructure/io/localfileinfoprovider.h"
+
+#include "libmscore/masterscore.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String TEST_SCORE(u"src/engraving/utests/test.mscx");
+
+static constexpr int MEASURES_COUNT = 500;
+static constexpr int NOTES_COUNT = 4 * MEASURES_COUNT;
+
+using Clock = std::chrono::steady_clock;
+
+//! NOTE The benchmarks are disabled by default, run them with --gtest_also_run_disabled_tests
+class CursorBenchmark : public ::testing::Test
+{
+public:
+    MasterScore* readScore(const String& name) const
+    {
+        io::path_t path = String(plugins_benchmarks_DATA_ROOT) + u"/" + name;
+        MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle();
+        score->setFileInfoProvider(std::make_shared<LocalFileInfoProvider>(path));
+
+        ScoreLoad sl;
+        if (compat::loadMsczOrMscx(score, path.toString(), false) != Score::FileError::FILE_NO_ERROR) {
+            delete score;
+            return nullptr;
+        }
+
+        score->doLayout();
+        return score;
+    }
+
+    int pitch(int i) const
+    {
+        static const int scale[] = { 60, 62, 64, 65, 67, 69, 71, 72 };
+        return scale[i % 8];
+    }
+};
+
+/**
+ * @brief CursorBenchmark_AddBatchVsAddNote
+ * @details Compares adding thousands of notes with Cursor.addBatch() and with Cursor.addNote() in a loop
+ *          within Score.startCmd() and Score.endCmd(), as the plugins did so far
+ */
+TEST_F(CursorBenchmark, DISABLED_AddBatchVsAddNote)
+{
+    MasterScore* score = readScore(TEST_SCORE);
+    ASSERT_TRUE(score);
+
+    score->startCmd();
+    score->appendMeasures(MEASURES_COUNT);
+    score->endCmd();
+
+    PluginAPI::Cursor cursor(score);
+
+    // addNote() in a loop within one command
+    cursor.rewind(PluginAPI::Cursor::SCORE_START);
+    cursor.setDuration(1, 4);
+
+    Clock::time_point start = Clock::now();
+    score->startCmd();
+    for (int i = 0; i < NOTES_COUNT; ++i) {
+        cursor.addNote(pitch(i));
+    }
+    score->endCmd();
+    std::chrono::duration<double, std::milli> addNoteElapsed = Clock::now() - start;
+
+    score->undoRedo(true, nullptr);
+
+    // the same notes with addBatch()
+    cursor.rewind(PluginAPI::Cursor::SCORE_START);
+    cursor.setDuration(1, 4);
+
+    QVariantList items;
+    for (int i = 0; i < NOTES_COUNT; ++i) {
+        items.append(pitch(i));
+    }
+
+    start = Clock::now();
+    int added = cursor.addBatch(items);
+    std::chrono::duration<double, std::milli> addBatchElapsed = Clock::now() - start;
+
+    EXPECT_EQ(added, NOTES_COUNT);
+
+    LOGI() << NOTES_COUNT << " notes in " << MEASURES_COUNT << " measures";
+    LOGI() << "    addNote() in a loop: " << addNoteElapsed.count() << " ms";
+    LOGI() << "    addBatch(): " << addBatchElapsed.count() << " ms";
+
+    delete score;
+}
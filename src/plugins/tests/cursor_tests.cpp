@@ -0,0 +1,141 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "plugins/api/cursor.h"
+
+#include "engraving/compat/scoreaccess.h"
+#include "engraving/compat/mscxcompat.h"
+#include "engraving/infrastructure/io/localfileinfoprovider.h"
+
+#include "libmscore/chord.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/note.h"
+#include "libmscore/segment.h"
+#include "libmscore/undo.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String TEST_SCORE(u"src/engraving/utests/test.mscx");
+
+class CursorTests : public ::testing::Test
+{
+public:
+    MasterScore* readScore(const String& name) const
+    {
+        io::path_t path = String(plugins_tests_DATA_ROOT) + u"/" + name;
+        MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle();
+        score->setFileInfoProvider(std::make_shared<LocalFileInfoProvider>(path));
+
+        ScoreLoad sl;
+        if (compat::loadMsczOrMscx(score, path.toString(), false) != Score::FileError::FILE_NO_ERROR) {
+            delete score;
+            return nullptr;
+        }
+
+        score->doLayout();
+        return score;
+    }
+
+    int firstPitch(Score* score) const
+    {
+        Segment* segment = score->firstMeasure()->first(SegmentType::ChordRest);
+        EngravingItem* item = segment ? segment->element(0) : nullptr;
+        return item && item->isChord() ? toChord(item)->upNote()->pitch() : -1;
+    }
+};
+
+/**
+ * @brief CursorTests_AddBatchIsOneUndoableCommand
+ * @details Cursor.addBatch() adds all the entries within one command on the undo stack of the cursor's score,
+ *          so they are undone at once
+ */
+TEST_F(CursorTests, AddBatchIsOneUndoableCommand)
+{
+    // [GIVEN] A score without an open command
+    MasterScore* score = readScore(TEST_SCORE);
+    ASSERT_TRUE(score);
+
+    UndoStack* undoStack = score->undoStack();
+    ASSERT_FALSE(undoStack->active());
+
+    const size_t undoIdx = undoStack->getCurIdx();
+    const int originalPitch = firstPitch(score);
+
+    PluginAPI::Cursor cursor(score);
+    cursor.rewind(PluginAPI::Cursor::SCORE_START);
+    cursor.setDuration(1, 4);
+
+    // [WHEN] A batch of notes, a chord and a rest is added
+    int added = cursor.addBatch({ 70, 72, QVariantList { 74, 77 }, QVariantMap { { "rest", true } } });
+
+    // [THEN] All the entries are added within one closed command
+    EXPECT_EQ(added, 4);
+    EXPECT_FALSE(undoStack->active());
+    EXPECT_EQ(undoStack->getCurIdx(), undoIdx + 1);
+    EXPECT_EQ(firstPitch(score), 70);
+
+    // [THEN] One undo reverts all of them
+    score->undoRedo(true, nullptr);
+    EXPECT_EQ(undoStack->getCurIdx(), undoIdx);
+    EXPECT_EQ(firstPitch(score), originalPitch);
+
+    delete score;
+}
+
+/**
+ * @brief CursorTests_AddBatchJoinsOpenCommand
+ * @details If a command is already open on the cursor's score, Cursor.addBatch() adds the entries to it
+ *          and leaves it open
+ */
+TEST_F(CursorTests, AddBatchJoinsOpenCommand)
+{
+    // [GIVEN] A score with an open command
+    MasterScore* score = readScore(TEST_SCORE);
+    ASSERT_TRUE(score);
+
+    UndoStack* undoStack = score->undoStack();
+    const size_t undoIdx = undoStack->getCurIdx();
+
+    score->startCmd();
+
+    PluginAPI::Cursor cursor(score);
+    cursor.rewind(PluginAPI::Cursor::SCORE_START);
+    cursor.setDuration(1, 4);
+
+    // [WHEN] A batch is added
+    int added = cursor.addBatch({ 70, 72 });
+
+    // [THEN] The command stays open
+    EXPECT_EQ(added, 2);
+    EXPECT_TRUE(undoStack->active());
+
+    // [THEN] The entries are a part of the command that is closed by its owner
+    score->endCmd();
+    EXPECT_EQ(undoStack->getCurIdx(), undoIdx + 1);
+    EXPECT_EQ(firstPitch(score), 70);
+
+    delete score;
+}
@@ -63,6 +63,11 @@ bool ExportProjectScenario::exportScores(const INotationPtrList& notations, cons
         return false;
     }
 
+    //! NOTE The layout of the parts which are not open may have been deferred
+    for (INotationPtr notation : notations) {
+        notation->elements()->msScore()->masterScore()->doPendingLayouts();
+    }
+
     bool isCreatingOnlyOneFile = this->isCreatingOnlyOneFile(notations, unitType);
 
     // If isCreatingOnlyOneFile, the save dialog has already asked whether to replace
@@ -324,6 +324,11 @@ int fluid_defsfont_load_sampledata(fluid_defsfont_t *defsfont, SFData *sfdata, f
                       sfdata, sample->source_start, source_end, sample->sampletype,
                       defsfont->mlock, &sample->data, &sample->data24);
 
+    if(num_samples == FLUID_SAMPLECACHE_PENDING)
+    {
+        return FLUID_SAMPLECACHE_PENDING;
+    }
+
     if(num_samples < 0)
     {
         return FLUID_FAILED;
@@ -387,7 +392,7 @@ int fluid_defsfont_load_all_sampledata(fluid_defsfont_t *defsfont, SFData *sfdat
         {
             /* SF3 samples get loaded individually, as most (or all) of them are in Ogg Vorbis format
              * anyway */
-            if(fluid_defsfont_load_sampledata(defsfont, sfdata, sample) == FLUID_FAILED)
+            if(fluid_defsfont_load_sampledata(defsfont, sfdata, sample) != FLUID_OK)
             {
                 FLUID_LOG(FLUID_ERR, "Failed to load sample '%s'", sample->name);
                 return FLUID_FAILED;
@@ -2026,6 +2031,7 @@ static int load_preset_samples(fluid_defsfont_t *defsfont, fluid_preset_t *prese
     fluid_inst_zone_t *inst_zone;
     fluid_sample_t *sample;
     SFData *sffile = NULL;
+    int ret;
 
     defpreset = fluid_preset_get_data(preset);
     preset_zone = fluid_defpreset_get_zone(defpreset);
@@ -2061,11 +2067,18 @@ static int load_preset_samples(fluid_defsfont_t *defsfont, fluid_preset_t *prese
                         }
                     }
 
-                    if(fluid_defsfont_load_sampledata(defsfont, sffile, sample) == FLUID_OK)
+                    ret = fluid_defsfont_load_sampledata(defsfont, sffile, sample);
+
+                    if(ret == FLUID_OK)
                     {
                         fluid_sample_sanitize_loop(sample, (sample->end + 1) * sizeof(short));
                         fluid_voice_optimize_sample(sample);
                     }
+                    else if(ret == FLUID_SAMPLECACHE_PENDING)
+                    {
+                        /* MuseScore patch: the application loads the sample data later on */
+                        FLUID_LOG(FLUID_DBG, "Sample '%s' is pending", sample->name);
+                    }
                     else
                     {
                         FLUID_LOG(FLUID_ERR, "Unable to load sample '%s', disabling", sample->name);
@@ -54,13 +54,16 @@ struct _fluid_samplecache_entry_t
 
     int num_references;
     int mlocked;
+    int provided; /* MuseScore patch: the sample data isn't owned by the cache */
 };
 
 static fluid_list_t *samplecache_list = NULL;
 static fluid_mutex_t samplecache_mutex = FLUID_MUTEX_INIT;
+static fluid_samplecache_provider_t samplecache_provider = NULL;
+static fluid_samplecache_release_t samplecache_release = NULL;
 
 static fluid_samplecache_entry_t *new_samplecache_entry(SFData *sf, unsigned int sample_start,
-        unsigned int sample_end, int sample_type, time_t mtime);
+        unsigned int sample_end, int sample_type, time_t mtime, int *pending);
 static fluid_samplecache_entry_t *get_samplecache_entry(SFData *sf, unsigned int sample_start,
         unsigned int sample_end, int sample_type, time_t mtime);
 static void delete_samplecache_entry(fluid_samplecache_entry_t *entry);
@@ -76,6 +79,7 @@ int fluid_samplecache_load(SFData *sf,
 {
     fluid_samplecache_entry_t *entry;
     int ret;
+    int pending = FALSE;
     time_t mtime;
 
     fluid_mutex_lock(samplecache_mutex);
@@ -89,11 +93,11 @@ int fluid_samplecache_load(SFData *sf,
 
     if(entry == NULL)
     {
-        entry = new_samplecache_entry(sf, sample_start, sample_end, sample_type, mtime);
+        entry = new_samplecache_entry(sf, sample_start, sample_end, sample_type, mtime, &pending);
 
         if(entry == NULL)
         {
-            ret = -1;
+            ret = pending ? FLUID_SAMPLECACHE_PENDING : -1;
             goto unlock_exit;
         }
 
@@ -133,6 +137,14 @@ unlock_exit:
     return ret;
 }
 
+void fluid_samplecache_set_provider(fluid_samplecache_provider_t provider, fluid_samplecache_release_t release)
+{
+    fluid_mutex_lock(samplecache_mutex);
+    samplecache_provider = provider;
+    samplecache_release = release;
+    fluid_mutex_unlock(samplecache_mutex);
+}
+
 int fluid_samplecache_unload(const short *sample_data)
 {
     fluid_list_t *entry_list;
@@ -188,7 +200,8 @@ static fluid_samplecache_entry_t *new_samplecache_entry(SFData *sf,
         unsigned int sample_start,
         unsigned int sample_end,
         int sample_type,
-        time_t mtime)
+        time_t mtime,
+        int *pending)
 {
     fluid_samplecache_entry_t *entry;
 
@@ -219,8 +232,26 @@ static fluid_samplecache_entry_t *new_samplecache_entry(SFData *sf,
     entry->sample_type = sample_type;
     entry->modification_time = mtime;
 
-    entry->sample_count = fluid_sffile_read_sample_data(sf, sample_start, sample_end, sample_type,
-                          &entry->sample_data, &entry->sample_data24);
+    entry->sample_count = -1;
+
+    if(samplecache_provider != NULL)
+    {
+        entry->sample_count = samplecache_provider(sf, sample_start, sample_end, sample_type,
+                              &entry->sample_data, &entry->sample_data24);
+        entry->provided = (entry->sample_count >= 0);
+
+        if(entry->sample_count == FLUID_SAMPLECACHE_PENDING)
+        {
+            *pending = TRUE;
+            goto error_exit;
+        }
+    }
+
+    if(!entry->provided)
+    {
+        entry->sample_count = fluid_sffile_read_sample_data(sf, sample_start, sample_end, sample_type,
+                              &entry->sample_data, &entry->sample_data24);
+    }
 
     if(entry->sample_count < 0)
     {
@@ -239,8 +270,17 @@ static void delete_samplecache_entry(fluid_samplecache_entry_t *entry)
     fluid_return_if_fail(entry != NULL);
 
     FLUID_FREE(entry->filename);
-    FLUID_FREE(entry->sample_data);
-    FLUID_FREE(entry->sample_data24);
+
+    if(!entry->provided)
+    {
+        FLUID_FREE(entry->sample_data);
+        FLUID_FREE(entry->sample_data24);
+    }
+    else if(samplecache_release != NULL)
+    {
+        samplecache_release(entry->sample_data);
+    }
+
     FLUID_FREE(entry);
 }
 
@@ -31,4 +31,18 @@ int fluid_samplecache_load(SFData *sf,
 
 int fluid_samplecache_unload(const short *sample_data);
 
+/* MuseScore patch: lets the application provide the sample data itself (e.g. from a memory mapped file).
+ * The provider returns the number of sample words or -1, if the sample data has to be read the usual way,
+ * or FLUID_SAMPLECACHE_PENDING, if the sample data isn't available yet (e.g. it's still being decoded
+ * in the background). A pending sample stays without data (so it's silent) until it's loaded again.
+ * The provided sample data is owned by the application and never freed by the sample cache,
+ * instead the release callback (if any) is called once the sample cache doesn't use it anymore. */
+typedef int (*fluid_samplecache_provider_t)(SFData *sf, unsigned int sample_start, unsigned int sample_end,
+                                            int sample_type, short **data, char **data24);
+typedef void (*fluid_samplecache_release_t)(const short *data);
+
+#define FLUID_SAMPLECACHE_PENDING (-2)
+
+void fluid_samplecache_set_provider(fluid_samplecache_provider_t provider, fluid_samplecache_release_t release);
+
 #endif /* _FLUID_SAMPLECACHE_H */